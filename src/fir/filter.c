@@ -41,6 +41,34 @@
                   samples are inserted in the begining of the file,
                   d<0 causes samples to be dropped. Default is d=0.
   -q ............ quiet processing (no progress flag)
+  -fast ......... FIR filters use the fast kernels (reordered float
+                  summation, FFT convolution for long filters without
+                  rate change and large blocks), cascade-form IIR filters
+                  the transposed form II kernel; default is the strict,
+                  bit-exact, kernel
+  -isa n ........ highest instruction set for the FIR kernels: 0=C,
+                  1=SSE2, 2=AVX2, 3=AVX-512; default: best available
+  -rate L/M ..... output rate is L/M times the input rate (RSMP filter
+                  only)
+  -pass f ....... end of the passband of the RSMP filter, as a fraction
+                  of the Nyquist frequency of the lower rate (default 0.9)
+  -stop f ....... start of the stopband of the RSMP filter, as a fraction
+                  of the Nyquist frequency of the lower rate (default 1.0)
+  -nchan n ...... number of interleaved channels in the files (FIR
+                  and IFLAT filters only); block size and delay are
+                  counted in samples per channel; an incomplete last
+                  frame is padded with zeros. Default is 1.
+  -q15 .......... FIR filters use the fixed-point kernel (Q15 coefficients,
+                  Q31 accumulation, see fir-fx.c) on the 16-bit samples
+  -wmops ........ same as -q15 with the STL basic operators, and print
+                  the complexity in WMOPS (bit-exact with -q15)
+  -fs f ......... input sampling rate for the WMOPS figures (default 8000)
+  -threads n .... parallel-form (PCM, PCM1) and direct-form (DC) IIR
+                  filters split each block in up to n chunks filtered
+                  in parallel (0: one per processor). This is useful
+                  only with long blocks, e.g. a BlockSize of several
+                  thousand samples; the output differs from the serial
+                  filtering by rounding only.
 
   Valid filter specifications:
   Flt_type Description
@@ -77,6 +105,7 @@
    LP20		low-pass filter with cut-off frequency 20kHz for fs=48kHz, 1:1
    RXIRS8   Receive-side Modified IRS weighting with factor 1:1 at 8kHz
    RXIRS16  Receive-side Modified IRS weighting with factor 1:1 at 16kHz
+   RSMP     Rational L/M polyphase resampler (factor given by -rate)
 
 
   Testing:
@@ -152,6 +181,14 @@
 
    02.Feb.2010 v3.5 - Modified maximum string length for filenames to avoid
                       buffer overruns (y.hiwasaki)
+   16.Oct.2026 v3.6 - Added options -fast and -isa to select the FIR kernel.
+                    - Added rational L/M resampler (RSMP, -rate L/M, -pass
+                      and -stop).
+                    - Added option -nchan for interleaved multichannel files.
+                    - Added options -q15 and -wmops (fixed-point FIR kernel).
+                    - Options -fast and -nchan also for the IFLAT filter.
+                    - Added option -threads (multi-threaded PCM and DC
+                      filters).
   ===========================================================================
 */
 
@@ -171,6 +208,7 @@
 #include "iirflt.h"
 #include "firflt.h"
 #include "ugst-utl.h"
+#include "stl.h"                /* WMOPS counters (basop module) */
 
 /* LOCAL DEFINITIONS */
 #ifndef max
@@ -204,7 +242,8 @@ int valid_filter (char *F_type, char modified_IRS) {
 // FILTER_12k48k_HW
       || strncmp (F_type, "LP12", 4) == 0 || strncmp (F_type, "lp12", 4) == 0
 // FILTER_12k48k_HW
-      || strncmp (F_type, "LP14", 4) == 0 || strncmp (F_type, "lp14", 4) == 0 || strncmp (F_type, "LP20", 4) == 0 || strncmp (F_type, "lp20", 4) == 0)
+      || strncmp (F_type, "LP14", 4) == 0 || strncmp (F_type, "lp14", 4) == 0 || strncmp (F_type, "LP20", 4) == 0 || strncmp (F_type, "lp20", 4) == 0
+      || strncmp (F_type, "rsmp", 4) == 0 || strncmp (F_type, "RSMP", 4) == 0)
     valid = 1;
 
   /* No MOD-IRS filter at 8 kHz */
@@ -221,7 +260,7 @@ int valid_filter (char *F_type, char modified_IRS) {
  * Last update: 15.May.2007 <>
  */
 void display_usage () {
-  printf ("FILTER.C - Version 3.5 of 02.Feb.2010 \n\n");
+  printf ("FILTER.C - Version 3.6 of 16.Oct.2026 \n\n");
 
   printf (" Test program to process a given file by one of the possible filter\n");
   printf (" characteristics of the STL. Multiple filterings (as available\n");
@@ -255,6 +294,33 @@ void display_usage () {
   printf ("               samples are inserted in the begining of the file,\n");
   printf ("               d<0 causes samples to be dropped. Default is d=0.\n");
   printf ("  -q ......... quiet processing (no progress flag)\n");
+  printf ("  -fast ...... FIR filters use the fast kernels (reordered float\n");
+  printf ("               summation, FFT convolution for long filters without\n");
+  printf ("               rate change and large blocks), cascade-form IIR filters\n");
+  printf ("               the transposed form II kernel; default is the strict,\n");
+  printf ("               bit-exact, kernel\n");
+  printf ("  -isa n ..... highest instruction set for the FIR kernels: 0=C,\n");
+  printf ("               1=SSE2, 2=AVX2, 3=AVX-512; default: best available\n");
+  printf ("  -rate L/M .. output rate is L/M times the input rate (RSMP filter\n");
+  printf ("               only)\n");
+  printf ("  -pass f .... end of the passband of the RSMP filter, as a fraction\n");
+  printf ("               of the Nyquist frequency of the lower rate (default 0.9)\n");
+  printf ("  -stop f .... start of the stopband of the RSMP filter, as a fraction\n");
+  printf ("               of the Nyquist frequency of the lower rate (default 1.0)\n");
+  printf ("  -nchan n ... number of interleaved channels in the files (FIR\n");
+  printf ("               and IFLAT filters only); block size and delay are\n");
+  printf ("               counted in samples per channel; an incomplete last\n");
+  printf ("               frame is padded with zeros. Default is 1.\n");
+  printf ("  -q15 ....... FIR filters use the fixed-point kernel (Q15 coefficients,\n");
+  printf ("               Q31 accumulation) on the 16-bit samples\n");
+  printf ("  -wmops ..... same as -q15 with the STL basic operators, and print\n");
+  printf ("               the complexity in WMOPS (bit-exact with -q15)\n");
+  printf ("  -fs f ...... input sampling rate for the WMOPS figures (default 8000)\n");
+  printf ("  -threads n . PCM, PCM1 and DC filters split each block in up to n\n");
+  printf ("               chunks filtered in parallel (0: one per processor).\n");
+  printf ("               This is useful only with long blocks, e.g. a BlockSize\n");
+  printf ("               of several thousand samples; the output differs from\n");
+  printf ("               the serial filtering by rounding only.\n");
   printf ("\n");
   printf (" Valid filter specifications:\n");
   printf ("  Flt_type Description\n");
@@ -288,7 +354,8 @@ void display_usage () {
   printf ("   LP10    10kHz low-pass filter for fs=48kHz, w/ factor 1:1\n");
   printf ("   LP12    12kHz low-pass filter for fs=48kHz, w/ factor 1:1\n");
   printf ("   LP14    14kHz low-pass filter for fs=48kHz, w/ factor 1:1\n");
-  printf ("   LP20    20kHz low-pass filter for fs=48kHz, w/ factor 1:1\n\n");
+  printf ("   LP20    20kHz low-pass filter for fs=48kHz, w/ factor 1:1\n");
+  printf ("   RSMP    Rational L/M polyphase resampler (factor given by -rate)\n\n");
 
   /* Quit program */
   exit (-128);
@@ -300,6 +367,7 @@ enum filter_kernel_type { FIR, IIR_PARALLEL, IIR_CASCADE, IIR_DIRECT };
 char *filter_type_str[] = { "FIR", "Parallel-form IIR",
   "Cascade-form IIR", "Direct-form IIR"
 };
+char *fir_isa_str[] = { "C", "SSE2", "AVX2", "AVX-512" };
 
 /*============================== */
 int main (int argc, char *argv[]) {
@@ -307,18 +375,25 @@ int main (int argc, char *argv[]) {
 
   /* Algorithm variables */
   SCD_FIR *fir_state;
+  SCD_FIR_FX *fx_state = NULL;
   SCD_IIR *parallel_iir_state;
   CASCADE_IIR *cascade_iir_state;
   DIRECT_IIR *direct_iir_state;
 
   float *InpBuff, *OutBuff;
-  short *TmpBuff;
+  short *TmpBuff, *FxBuff = NULL, *OutSh;
   char F_type[MAX_STRLEN], async = 0, upsample = 0;
   long cur_blk, satur = 0, total = 0, k, N, N1, N2;
   char modified_IRS = 0, quiet = 0;
   long inp_size, out_size, factor, smpno;
   double fs = 8000;
   char kernel_type = 0;
+  int fir_mode = HQ_STRICT, fir_isa = HQ_ISA_AUTO;
+  long rate_L = 0, rate_M = 0;
+  double rsmp_pass = 0, rsmp_stop = 0; /* band edges of the resampler; 0: default */
+  long nchan = 1;
+  int fir_fx = 0;               /* fixed-point FIR: 0=no, 1=native, 2=basic operators */
+  int nthreads = 1;             /* threads of the parallel- and direct-form IIR kernels */
   static char funny[9] = "|/-\\|/-\\";
 
   /* For asynchronous tandem simulation */
@@ -389,6 +464,76 @@ int main (int argc, char *argv[]) {
         if (delay < 0)
           skip = -delay;
 
+        /* Move arg{c,v} over the option to the next argument */
+        argc -= 2;
+        argv += 2;
+      } else if (strcmp (argv[1], "-fast") == 0) {
+        /* Use the fast FIR kernels */
+        fir_mode = HQ_FAST;
+
+        /* Move arg{c,v} over the option to the next argument */
+        argc--;
+        argv++;
+      } else if (strcmp (argv[1], "-isa") == 0) {
+        /* Limit the instruction set of the FIR kernels */
+        fir_isa = atoi (argv[2]);
+
+        /* Move arg{c,v} over the option to the next argument */
+        argc -= 2;
+        argv += 2;
+      } else if (strcmp (argv[1], "-rate") == 0) {
+        /* Rational rate change factor */
+        if (sscanf (argv[2], "%ld/%ld", &rate_L, &rate_M) != 2 || rate_L < 1 || rate_M < 1)
+          error_terminate ("\nInvalid rate factor; use -rate L/M. Aborted.\n", 5);
+
+        /* Move arg{c,v} over the option to the next argument */
+        argc -= 2;
+        argv += 2;
+      } else if (strcmp (argv[1], "-pass") == 0) {
+        /* End of the passband of the resampler */
+        if ((rsmp_pass = atof (argv[2])) <= 0)
+          error_terminate ("\nInvalid passband edge. Aborted.\n", 5);
+
+        /* Move arg{c,v} over the option to the next argument */
+        argc -= 2;
+        argv += 2;
+      } else if (strcmp (argv[1], "-stop") == 0) {
+        /* Start of the stopband of the resampler */
+        if ((rsmp_stop = atof (argv[2])) <= 0)
+          error_terminate ("\nInvalid stopband edge. Aborted.\n", 5);
+
+        /* Move arg{c,v} over the option to the next argument */
+        argc -= 2;
+        argv += 2;
+      } else if (strcmp (argv[1], "-nchan") == 0) {
+        /* Number of interleaved channels */
+        nchan = atol (argv[2]);
+        if (nchan < 1)
+          error_terminate ("\nInvalid number of channels. Aborted.\n", 5);
+
+        /* Move arg{c,v} over the option to the next argument */
+        argc -= 2;
+        argv += 2;
+      } else if (strcmp (argv[1], "-q15") == 0) {
+        /* Fixed-point FIR kernel, native integer code */
+        fir_fx = 1;
+
+        /* Move arg{c,v} over the option to the next argument */
+        argc--;
+        argv++;
+      } else if (strcmp (argv[1], "-wmops") == 0) {
+        /* Fixed-point FIR kernel with basic operators */
+        fir_fx = 2;
+
+        /* Move arg{c,v} over the option to the next argument */
+        argc--;
+        argv++;
+      } else if (strcmp (argv[1], "-threads") == 0) {
+        /* Multi-threaded IIR kernels */
+        nthreads = atoi (argv[2]);
+        if (nthreads < 0)
+          error_terminate ("\nInvalid number of threads. Aborted.\n", 5);
+
         /* Move arg{c,v} over the option to the next argument */
         argc -= 2;
         argv += 2;
@@ -421,6 +566,19 @@ int main (int argc, char *argv[]) {
     exit (2);
   }
 
+  /* The rational resampler needs the rate factor, the other filters take none */
+  if (strncmp (F_type, "rsmp", 4) == 0 || strncmp (F_type, "RSMP", 4) == 0) {
+    if (rate_L == 0)
+      error_terminate ("\nRSMP filter requires option -rate L/M! Aborted.\n", 5);
+    if (rsmp_pass == 0)
+      rsmp_pass = 0.9;
+    if (rsmp_stop == 0)
+      rsmp_stop = 1.0;
+    if (rsmp_pass >= rsmp_stop || rsmp_stop > 1)
+      error_terminate ("\nRSMP band edges must satisfy 0 < pass < stop <= 1! Aborted.\n", 5);
+  } else if (rate_L != 0 || rsmp_pass != 0 || rsmp_stop != 0)
+    error_terminate ("\nOptions -rate, -pass and -stop are only available for RSMP! Aborted.\n", 5);
+
   /* The delay option is only available with asynchronous filtering */
   if (delay != 0 && !async)
     error_terminate ("\nDelay option only available for ASYNC filtering! Aborted.\n", 5);
@@ -429,7 +587,7 @@ int main (int argc, char *argv[]) {
   /* ......... STARTING ......... */
 
   /* Find starting byte in file */
-  start_byte = sizeof (short) * (long) (--N1) * (long) N;
+  start_byte = sizeof (short) * (long) (--N1) * (long) N * nchan;
 
 #ifdef SKIP_APPROACH_1
   /* If samples are to be skipped in output file, does it here */
@@ -443,9 +601,13 @@ int main (int argc, char *argv[]) {
 
     /* ... find the input file size ... */
     stat (FileIn, &st);
-    N2 = ceil ((st.st_size - start_byte) / (double) (N * sizeof (short)));
+    N2 = ceil ((st.st_size - start_byte) / (double) (N * nchan * sizeof (short)));
   }
-  inp_size = N;                 /* samples */
+  inp_size = N;                 /* samples per channel */
+
+  /* Delay and skipped samples count all channels */
+  delay *= nchan;
+  skip *= nchan;
 
 
   /* Allocate memory for delay buffer & initialize it */
@@ -652,6 +814,14 @@ int main (int argc, char *argv[]) {
     fir_state = LP20_48kHz_init ();
   }
 
+/*
+  * Filter type: RSMP - rational L/M resampler, factor given by -rate
+  */
+  else if (strncmp (F_type, "rsmp", 4) == 0 || strncmp (F_type, "RSMP", 4) == 0) {
+    if ((fir_state = hq_resample_init (rate_L, rate_M, rsmp_pass, rsmp_stop)) == NULL)
+      error_terminate ("Can't initialize the L/M resampler\n", 10);
+  }
+
 /*
   * Filter type: PCM  - Standard PCM quality 2:1 or 1:2 factor:
   *                    . fs ==  8000 -> upsample: 1:2
@@ -692,9 +862,13 @@ int main (int argc, char *argv[]) {
   /* Calculate Output buffer size and rate change factor */
   switch (kernel_type) {
   case FIR:
+    fir_isa = hq_mode (fir_state, fir_mode, fir_isa);
     factor = fir_state->dwn_up;
-    out_size = (fir_state->hswitch == 'U')
-      ? inp_size * factor : ceil (inp_size / (double) factor);
+    if (fir_state->hswitch == 'R')
+      out_size = ceil (inp_size * fir_state->nphase / (double) factor);
+    else
+      out_size = (fir_state->hswitch == 'U')
+        ? inp_size * factor : ceil (inp_size / (double) factor);
     break;
   case IIR_PARALLEL:
     factor = parallel_iir_state->idown;
@@ -702,6 +876,8 @@ int main (int argc, char *argv[]) {
       ? inp_size * factor : ceil (inp_size / (double) factor);
     break;
   case IIR_CASCADE:
+    if (fir_mode == HQ_FAST && cascade_iir_mode (cascade_iir_state, IIR_FAST) < 0)
+      error_terminate ("Can't select the fast IIR kernel\n", 10);
     factor = cascade_iir_state->idown;
     out_size = (cascade_iir_state->hswitch == 'U')
       ? inp_size * factor : ceil (inp_size / (double) factor);
@@ -715,6 +891,18 @@ int main (int argc, char *argv[]) {
   /* Check consistency once more */
   if (async && factor == 1)
     error_terminate ("INCONSISTENCY: async operation requires non-unity upsampling factor; aborting\n", 10);
+  if (nchan > 1 && kernel_type != FIR && kernel_type != IIR_CASCADE)
+    error_terminate ("\nOption -nchan only available for FIR and IFLAT filters! Aborted.\n", 5);
+  if (fir_fx && (kernel_type != FIR || nchan > 1))
+    error_terminate ("\nOptions -q15/-wmops only available for single-channel FIR filters! Aborted.\n", 5);
+
+  /* Fixed-point version of the FIR filter */
+  if (fir_fx && (fx_state = hq_fx_init (fir_state, fir_fx == 2)) == NULL)
+    error_terminate ("Can't initialize the fixed-point FIR filter\n", 10);
+
+  /* Buffers hold all the channels */
+  inp_size *= nchan;
+  out_size *= nchan;
 
   /* Allocate memory for float input buffer */
   if ((InpBuff = (float *) calloc (inp_size, sizeof (float))) == NULL)
@@ -728,11 +916,18 @@ int main (int argc, char *argv[]) {
   if ((TmpBuff = (short *) calloc (max (inp_size, out_size), sizeof (short))) == NULL)
     error_terminate ("Can't allocate memory for short data buffer\n", 10);
 
+  /* Allocate memory for short output buffer of the fixed-point filter */
+  OutSh = TmpBuff;
+  if (fx_state != NULL && (OutSh = FxBuff = (short *) calloc (out_size, sizeof (short))) == NULL)
+    error_terminate ("Can't allocate memory for short output buffer\n", 10);
+
 
 /*
  * ......... PRINT INFO ..........
  */
-  if (factor == 1)
+  if (kernel_type == FIR && fir_state->hswitch == 'R')
+    fprintf (stderr, "Resampling operation, factor %ld/%ld\n", fir_state->nphase, factor);
+  else if (factor == 1)
     fprintf (stderr, "No-rate change operation\n");
   else {
     fprintf (stderr, "%s operation, ", async ? "Asynchronization" : (upsample ? "Upsampling" : "Downsampling"));
@@ -740,6 +935,8 @@ int main (int argc, char *argv[]) {
   }
   if (modified_IRS)
     fprintf (stderr, "Using modified IRS\n");
+  if (nchan > 1)
+    fprintf (stderr, "Interleaved channels: %ld\n", nchan);
 
   if (delay > 0)
     fprintf (stderr, "Delaying output file by %ld samples\n", delay);
@@ -747,6 +944,19 @@ int main (int argc, char *argv[]) {
     fprintf (stderr, "Skipping %ld samples in output file\n", skip);
 
   fprintf (stderr, "Filter structure: %s\n", filter_type_str[(int) kernel_type]);
+  if (fx_state != NULL)
+    fprintf (stderr, "FIR kernel: fixed-point Q15/Q31 (headroom %d bits), %s\n", fx_state->shift, fir_fx == 2 ? "basic operators" : "native");
+  else if (kernel_type == FIR)
+    fprintf (stderr, "FIR kernel: %s, %s\n", fir_mode == HQ_FAST ? "fast" : "strict", fir_isa_str[fir_isa]);
+
+#ifdef WMOPS
+  /* One frame per block, at the input sampling rate */
+  if (fir_fx == 2) {
+    setFrameRate ((int) fs, (int) N);
+    setCounter (getCounterId ("FIR Q15"));
+    Init_WMOPS_counter ();
+  }
+#endif
 
 
 /*
@@ -784,58 +994,95 @@ int main (int argc, char *argv[]) {
     if (!quiet)
       fprintf (stderr, "%c\r", funny[cur_blk % 8]);
 
-    /* Reset output buffer */
-    memset (OutBuff, '\0', out_size * sizeof (float));
-
     /* Read a block of samples */
-    if ((smpno = fread (TmpBuff, sizeof (short), N, Fi)) == 0)
+    if ((smpno = fread (TmpBuff, sizeof (short), N * nchan, Fi)) == 0)
       KILL (FileIn, 5);
 
-    /* ... and convert short to float, normalizing */
-    sh2fl_16bit (smpno, TmpBuff, InpBuff, 1);
-
-    /* Call the filtering routine */
-    switch (kernel_type) {
-    case FIR:
-      smpno = hq_kernel (smpno, InpBuff, fir_state, OutBuff);
-      break;
-    case IIR_PARALLEL:
-      smpno = stdpcm_kernel (smpno, InpBuff, parallel_iir_state, OutBuff);
-      break;
-    case IIR_CASCADE:
-      smpno = cascade_iir_kernel (smpno, InpBuff, cascade_iir_state, OutBuff);
-      break;
-    case IIR_DIRECT:
-      smpno = direct_iir_kernel (smpno, InpBuff, direct_iir_state, OutBuff);
-      break;
+    /* Incomplete frame of the channels at the end of the file: pad with zeros */
+    if (smpno % nchan != 0) {
+      fprintf (stderr, "Warning: file size is not a multiple of %ld channels; %ld zero sample(s) appended\n",
+               nchan, nchan - smpno % nchan);
+      for (k = smpno % nchan; k < nchan; k++)
+        TmpBuff[smpno++] = 0;
     }
 
-    /* Decimates to implement asynchronization process */
-    if (async) {
-      long k;
+    /* Fixed-point FIR: filter the 16-bit samples directly */
+    if (fx_state != NULL) {
+#ifdef WMOPS
+      if (fir_fx == 2)
+        Reset_WMOPS_counter ();
+#endif
+      smpno = hq_fx_kernel (smpno, TmpBuff, fx_state, FxBuff);
+#ifdef WMOPS
+      if (fir_fx == 2)
+        fwc ();
+#endif
 
-      /* Decrease output vector by `factor' */
-      smpno /= factor;
+      /* Decimates to implement asynchronization process */
+      if (async) {
+        smpno /= factor;
+        for (k = 0; k < smpno; k++)
+          FxBuff[k] = FxBuff[k * factor];
+      }
+    } else {
+      /* Reset output buffer */
+      memset (OutBuff, '\0', out_size * sizeof (float));
+
+      /* ... and convert short to float, normalizing */
+      sh2fl_16bit (smpno, TmpBuff, InpBuff, 1);
+
+      /* Call the filtering routine */
+      switch (kernel_type) {
+      case FIR:
+        if ((smpno = hq_kernel_multi ((int) nchan, smpno / nchan, InpBuff, fir_state, OutBuff)) < 0)
+          error_terminate ("Can't allocate memory for the channels of the FIR filter\n", 10);
+        smpno *= nchan;
+        break;
+      case IIR_PARALLEL:
+        smpno = (nthreads == 1) ? stdpcm_kernel (smpno, InpBuff, parallel_iir_state, OutBuff)
+          : stdpcm_kernel_parallel (smpno, InpBuff, parallel_iir_state, OutBuff, nthreads);
+        break;
+      case IIR_CASCADE:
+        if (nchan > 1) {
+          if ((smpno = cascade_iir_kernel_multi ((int) nchan, smpno / nchan, InpBuff, cascade_iir_state, OutBuff)) < 0)
+            error_terminate ("Can't allocate memory for the channels of the IIR filter\n", 10);
+          smpno *= nchan;
+        } else
+          smpno = cascade_iir_kernel (smpno, InpBuff, cascade_iir_state, OutBuff);
+        break;
+      case IIR_DIRECT:
+        smpno = (nthreads == 1) ? direct_iir_kernel (smpno, InpBuff, direct_iir_state, OutBuff)
+          : direct_iir_kernel_parallel (smpno, InpBuff, direct_iir_state, OutBuff, nthreads);
+        break;
+      }
 
-      /* Shift samples implementing decimation process */
-      for (k = 0; k < smpno; k++)
-        OutBuff[k] = OutBuff[k * factor];
-    }
+      /* Decimates to implement asynchronization process */
+      if (async) {
+        long k;
+
+        /* Decrease output vector by `factor' */
+        smpno /= factor;
+
+        /* Shift samples implementing decimation process (whole frames) */
+        for (k = 0; k < smpno; k++)
+          OutBuff[k] = OutBuff[(k / nchan * factor) * nchan + k % nchan];
+      }
 
-    /* Convert the filtered data back to short */
-    satur += fl2sh_16bit (smpno, OutBuff, TmpBuff, (int) 1);
+      /* Convert the filtered data back to short */
+      satur += fl2sh_16bit (smpno, OutBuff, TmpBuff, (int) 1);
+    }
 
     /* Save to file, skipping any samples if necessary */
     if (skip >= smpno) {
       skip -= smpno;
       continue;
     } else if (skip > 0) {
-      if ((smpno = fwrite (&TmpBuff[skip], sizeof (short), (smpno - skip), Fo)) == 0 && ferror (Fo))
+      if ((smpno = fwrite (&OutSh[skip], sizeof (short), (smpno - skip), Fo)) == 0 && ferror (Fo))
         KILL (FileOut, 6);
       total += smpno;
       skip = 0;
     } else {
-      if ((smpno = fwrite (TmpBuff, sizeof (short), smpno, Fo)) == 0 && ferror (Fo))
+      if ((smpno = fwrite (OutSh, sizeof (short), smpno, Fo)) == 0 && ferror (Fo))
         KILL (FileOut, 6);
       total += smpno;
     }
@@ -845,6 +1092,12 @@ int main (int argc, char *argv[]) {
   /* FINALIZATIONS */
   fprintf (stderr, "\n");
 
+#ifdef WMOPS
+  /* Complexity of the fixed-point filter */
+  if (fir_fx == 2)
+    WMOPS_output (0);
+#endif
+
   /* Close open files */
   fclose (Fi);
   fclose (Fo);
@@ -858,6 +1111,10 @@ int main (int argc, char *argv[]) {
   switch (kernel_type) {
   case FIR:
     hq_free (fir_state);
+    if (fx_state != NULL) {
+      hq_fx_free (fx_state);
+      free (FxBuff);
+    }
     break;
   case IIR_PARALLEL:
     stdpcm_free (parallel_iir_state);
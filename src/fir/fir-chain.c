@@ -0,0 +1,469 @@
+/*                                                            16.Oct.2026 v1.0
+  =============================================================================
+
+                          U    U   GGG    SSSS  TTTTT
+                          U    U  G       S       T
+                          U    U  G  GG   SSSS    T
+                          U    U  G   G       S   T
+                           UUU     GG     SSS     T
+
+                   ========================================
+                    ITU-T - USER'S GROUP ON SOFTWARE TOOLS
+                   ========================================
+
+       =============================================================
+       COPYRIGHT NOTE: This source code, and all of its derivations,
+       is subject to the "ITU-T General Public License". Please have
+       it  read  in    the  distribution  disk,   or  in  the  ITU-T
+       Recommendation G.191 on "SOFTWARE TOOLS FOR SPEECH AND  AUDIO
+       CODING STANDARDS".
+       =============================================================
+
+MODULE:         FIRFLT, HIGH QUALITY FIR UP/DOWN-SAMPLING FILTER
+                Sub-unit: Chains of FIR filters
+
+DESCRIPTION:
+        This file contains a cascade ("chain") of FIR filters, e.g.
+        up-sampling 1:2, IRS weighting at 16 kHz and down-sampling 2:1,
+        as built by the *_init() functions of the other sub-units.
+
+        Instead of filtering a whole segment with each filter in turn,
+        with one full-length buffer per stage, the input segment is cut
+        into tiles of a few hundred samples that run through all the
+        stages while they are still in the processor cache. The two
+        work buffers of the chain are allocated once, for the longest
+        intermediate signal of a tile. As the filters are independent
+        of the segmentation, the output is the same (bit-exact in
+        HQ_STRICT mode) as running the stages one after the other.
+
+        Optionally, adjacent stages are fused at initialization: a stage
+        without down-sampling (up-sampling by L, or no rate change)
+        followed by a stage without up-sampling (down-sampling by M, or
+        no rate change) is replaced by one rational L/M filter whose
+        impulse response is the convolution of the two. This saves the
+        computation of the intermediate samples that the second stage
+        discards, and one pass over the data. The fused response is
+        computed in double precision and rounded to float once, hence
+        the output is no longer bit-exact with the separate stages: the
+        difference is the float rounding of the sums, well below one
+        LSB of a 16-bit output sample.
+
+FUNCTIONS:
+  Global (have prototype in firflt.h)
+         = hq_chain_init(...)    : build a chain from initialized filters
+         = hq_chain_kernel(...)  : filter a segment through the chain
+         = hq_chain_reset(...)   : clear the state of all stages
+         = hq_chain_free(...)    : deallocate the chain and its filters
+
+  Local (should be used only here -- prototypes only in this file)
+         = fir_chain_fuse(...)   : fuse two adjacent stages
+         = fir_chain_clip(...)   : count samples out of 16-bit range
+
+HISTORY:
+    16.Oct.2026 v1.0 Created.
+
+  =============================================================================
+*/
+
+
+/*
+ * ......... INCLUDES .........
+ */
+#include <stdio.h>
+#include <stdlib.h>             /* General utility definitions */
+#include <string.h>             /* memcpy(), memset() */
+
+#include "firflt.h"             /* Global definitions for FIR-FIR filter */
+
+
+/*
+ * ......... Local definitions .........
+ */
+
+/* Default tile: the longest intermediate signal of a tile fits in FIR_CHAIN_BUF floats (both work buffers then fit in a 32 kbyte L1 cache) */
+#define FIR_CHAIN_BUF 4096
+
+
+/*
+ * ......... Local function prototypes .........
+ */
+
+static SCD_FIR *fir_chain_fuse ARGS ((SCD_FIR * a, SCD_FIR * b));
+static long fir_chain_clip ARGS ((long n, float *y));
+
+
+/*
+ * ..... Private function prototypes defined in other sub-unit .....
+ */
+extern SCD_FIR *fir_initialization ARGS ((long lenh0, float h0[], double gain, long idwnup, int hswitch));
+extern void *fir_malloc_aligned ARGS ((long size));
+extern void fir_free_aligned ARGS ((void *ptr));
+
+
+/*
+ * ...................... BEGIN OF FUNCTIONS .........................
+ */
+
+/*
+  ============================================================================
+
+        FIR_CHAIN *hq_chain_init (int nstage, SCD_FIR **fir, long tile,
+        ~~~~~~~~~~~~~~~~~~~~~~~~  int fuse);
+
+        Description:
+        ~~~~~~~~~~~~
+
+        Build a chain of the nstage filters fir[0], ..., fir[nstage-1]
+        (first to last), as returned by the *_init() functions, with
+        cleared state. On success, the chain owns the filters: they are
+        deallocated by hq_chain_free(), and must not be used or freed by
+        the caller any more. The kernel mode of each filter (hq_mode())
+        is kept; fused filters get the mode of the first of the pair.
+
+        Parameters:
+        ~~~~~~~~~~~
+        nstage: ... (In) number of filters (0: the chain copies its input)
+        fir: ...... (In) array of pointers to the filters
+        tile: ..... (In) input samples per tile (<=0: default, such that
+                         the intermediate signals of a tile have at most
+                         FIR_CHAIN_BUF samples)
+        fuse: ..... (In) 1 to fuse adjacent stages where possible (see
+                         above), 0 to keep all the stages
+
+        Return value:
+        ~~~~~~~~~~~~~
+        Pointer to the chain, or NULL if out of memory; in the latter
+        case the filters still belong to the caller.
+
+        History:
+        ~~~~~~~~
+        16.Oct.2026 v1.0 Created.
+
+ ============================================================================
+*/
+FIR_CHAIN *hq_chain_init (int nstage, SCD_FIR ** fir, long tile, int fuse) {
+  FIR_CHAIN *chain;
+  SCD_FIR *f;
+  double rate, rmax;
+  long step, n, lbuf;
+  int s, k;
+
+  /* Largest ratio of an intermediate signal to the input */
+  for (s = 0, rate = rmax = 1.0; s < nstage - 1; s++) {
+    step = (fir[s]->hswitch == 'U') ? 1 : fir[s]->dwn_up;
+    rate *= (double) fir[s]->nphase / step;
+    if (rate > rmax)
+      rmax = rate;
+  }
+  if (tile <= 0) {
+    tile = (long) (FIR_CHAIN_BUF / rmax) - nstage;
+    if (tile < 1)
+      tile = 1;
+  }
+
+  /* Work buffers: longest intermediate signal of a tile (bound for any state of the filters); fusing only removes intermediate signals */
+  for (s = 0, n = tile, lbuf = 1; s < nstage - 1; s++) {
+    step = (fir[s]->hswitch == 'U') ? 1 : fir[s]->dwn_up;
+    n = n * fir[s]->nphase / step + 1;
+    if (n > lbuf)
+      lbuf = n;
+  }
+
+
+/*
+ * ......... ALLOCATION OF MEMORY .........
+ */
+
+  if ((chain = (FIR_CHAIN *) calloc (1, sizeof (FIR_CHAIN))) == (FIR_CHAIN *) NULL)
+    return NULL;
+  chain->fir = (SCD_FIR **) malloc ((nstage + 1) * sizeof (SCD_FIR *));
+  chain->ostage = (int *) malloc ((nstage + 1) * sizeof (int));
+  chain->nclip = (long *) calloc (nstage + 1, sizeof (long));
+  chain->buf[0] = (float *) fir_malloc_aligned (lbuf * sizeof (float));
+  chain->buf[1] = (float *) fir_malloc_aligned (lbuf * sizeof (float));
+  if (!(chain->fir && chain->ostage && chain->nclip && chain->buf[0] && chain->buf[1])) {
+    chain->nstage = 0;
+    hq_chain_free (chain);
+    return NULL;
+  }
+  chain->tile = tile;
+  chain->lbuf = lbuf;
+
+  /* Stages, fused from first to last while possible; a fused stage computes the output of the last stage it replaces */
+  chain->nstage = 0;
+  for (s = 0; s < nstage; s++) {
+    k = chain->nstage;
+    if (fuse && k > 0 && (f = fir_chain_fuse (chain->fir[k - 1], fir[s])) != NULL) {
+      hq_free (chain->fir[k - 1]);
+      hq_free (fir[s]);
+      chain->fir[k - 1] = f;
+      chain->ostage[k - 1] = s;
+    } else {
+      chain->fir[k] = fir[s];
+      chain->ostage[k] = s;
+      chain->nstage++;
+    }
+  }
+
+  return chain;
+}
+
+/* ....................... End of hq_chain_init() ....................... */
+
+
+/*
+  ============================================================================
+
+        long hq_chain_kernel (long lseg, float *x_ptr, FIR_CHAIN *chain,
+        ~~~~~~~~~~~~~~~~~~~~  float *y_ptr);
+
+        Description:
+        ~~~~~~~~~~~~
+
+        Filter a segment of lseg samples through all the stages of the
+        chain, tile by tile. The output array must have room for the
+        output of the cascaded filters, as when calling hq_kernel() for
+        each stage.
+
+        The output samples of each stage out of the 16-bit range (as
+        counted by fl2sh_16bit() with rounding) are accumulated in
+        chain->nclip[s], with s the index of the stage given to
+        hq_chain_init(); the counts of stages removed by fusing stay 0.
+
+        Parameters:
+        ~~~~~~~~~~~
+        lseg: .... (In)    number of input samples
+        x_ptr: ... (In)    array with input samples
+        chain: ... (InOut) pointer to the chain
+        y_ptr: ... (Out)   array with output samples
+
+        Return value:
+        ~~~~~~~~~~~~~
+        Returns the number of output samples.
+
+        History:
+        ~~~~~~~~
+        16.Oct.2026 v1.0 Created.
+
+ ============================================================================
+*/
+long hq_chain_kernel (long lseg, float *x_ptr, FIR_CHAIN * chain, float *y_ptr) {
+  long kx, ky, n, m;
+  float *in, *out;
+  int s;
+
+  /* Empty chain: copy input to output */
+  if (chain->nstage == 0) {
+    memmove (y_ptr, x_ptr, lseg * sizeof (float));
+    return lseg;
+  }
+
+  ky = 0;
+  for (kx = 0; kx < lseg; kx += n) {
+    n = (lseg - kx > chain->tile) ? chain->tile : lseg - kx;
+
+    /* Run the tile through all stages; the last one writes to the output */
+    in = x_ptr + kx;
+    m = n;
+    for (s = 0; s < chain->nstage; s++) {
+      out = (s == chain->nstage - 1) ? y_ptr + ky : chain->buf[s & 1];
+      m = hq_kernel (m, in, chain->fir[s], out);
+      chain->nclip[chain->ostage[s]] += fir_chain_clip (m, out);
+      in = out;
+    }
+    ky += m;
+  }
+
+  return ky;
+}
+
+/* ...................... End of hq_chain_kernel() ...................... */
+
+
+/*
+  ============================================================================
+
+        void hq_chain_reset (FIR_CHAIN *chain);
+        ~~~~~~~~~~~~~~~~~~~
+
+        Description:
+        ~~~~~~~~~~~~
+
+        Clear the state of all the stages (as hq_reset()) and the
+        out-of-range counters.
+
+        History:
+        ~~~~~~~~
+        16.Oct.2026 v1.0 Created.
+
+ ============================================================================
+*/
+void hq_chain_reset (FIR_CHAIN * chain) {
+  int s;
+
+  for (s = 0; s < chain->nstage; s++) {
+    hq_reset (chain->fir[s]);
+    chain->nclip[chain->ostage[s]] = 0;
+  }
+}
+
+/* ...................... End of hq_chain_reset() ...................... */
+
+
+/*
+  ============================================================================
+
+        void hq_chain_free (FIR_CHAIN *chain);
+        ~~~~~~~~~~~~~~~~~~
+
+        Description:
+        ~~~~~~~~~~~~
+
+        Deallocate the chain, including its filters.
+
+        History:
+        ~~~~~~~~
+        16.Oct.2026 v1.0 Created.
+
+ ============================================================================
+*/
+void hq_chain_free (FIR_CHAIN * chain) {
+  int s;
+
+  for (s = 0; s < chain->nstage; s++)
+    hq_free (chain->fir[s]);
+  fir_free_aligned (chain->buf[0]);
+  fir_free_aligned (chain->buf[1]);
+  free (chain->nclip);
+  free (chain->ostage);
+  free (chain->fir);
+  free (chain);
+}
+
+/* ...................... End of hq_chain_free() ...................... */
+
+
+/*
+  ============================================================================
+
+        static SCD_FIR *fir_chain_fuse (SCD_FIR *a, SCD_FIR *b);
+        ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+        Description:
+        ~~~~~~~~~~~~
+
+        Fuse filter a (up-sampling by L, or L=1) followed by filter b
+        (down-sampling by M, or M=1) into one filter. Both run at the
+        rate L*fs, hence the fused impulse response at that rate is the
+        convolution h=ha*hb of the (scaled) responses, and the output
+        sample m is the sample m*M of the up-sampled signal filtered by
+        h. With g=gcd(L,M), only the samples of h at multiples of g are
+        ever used: the fused filter is the rational (L/g)/(M/g) filter
+        with the response h[k*g], which reduces to an up-sampling filter
+        when M/g=1 and to a down-sampling filter when L/g=1.
+
+        The rational filter computes the same output samples as the two
+        stages, starting from cleared states.
+
+        Parameters:
+        ~~~~~~~~~~~
+        a: ........ (In) first filter
+        b: ........ (In) second filter
+
+        Return value:
+        ~~~~~~~~~~~~~
+        Pointer to the fused filter, or NULL if the filters can't be
+        fused (or out of memory); a and b are not changed.
+
+        History:
+        ~~~~~~~~
+        16.Oct.2026 v1.0 Created.
+
+ ============================================================================
+*/
+static SCD_FIR *fir_chain_fuse (SCD_FIR * a, SCD_FIR * b) {
+  SCD_FIR *f;
+  double *h;
+  float *hg;
+  long L, M, g, r, lenh, lenhg, k, j;
+
+  /* a must not down-sample, b must not up-sample */
+  if (!(a->hswitch == 'U' || (a->hswitch == 'D' && a->dwn_up == 1)) || b->hswitch != 'D')
+    return NULL;
+  L = a->nphase;
+  M = b->dwn_up;
+  for (g = L, r = M; r != 0; k = g % r, g = r, r = k);
+
+  /* Fused response at the rate L*fs, in double precision */
+  lenh = a->lenh0 + b->lenh0 - 1;
+  if ((h = (double *) calloc (lenh, sizeof (double))) == (double *) NULL)
+    return NULL;
+  for (k = 0; k < a->lenh0; k++)
+    for (j = 0; j < b->lenh0; j++)
+      h[k + j] += (double) a->h0[k] * b->h0[j];
+
+  /* Keep the samples used at the rate (L/g)*fs, zero-padded to a multiple of L/g taps */
+  L /= g;
+  M /= g;
+  lenhg = ((lenh + g - 1) / g + L - 1) / L * L;
+  if ((hg = (float *) calloc (lenhg, sizeof (float))) == (float *) NULL) {
+    free (h);
+    return NULL;
+  }
+  for (k = 0; k * g < lenh; k++)
+    hg[k] = (float) h[k * g];
+  free (h);
+
+  if (L == 1)
+    f = fir_initialization (lenhg, hg, 1.0, M, 'D');
+  else {
+    f = fir_initialization (lenhg, hg, 1.0, L, 'U');
+    if (f != NULL && M > 1) {
+      f->hswitch = 'R';
+      f->dwn_up = M;
+    }
+  }
+  free (hg);
+
+  if (f != NULL)
+    hq_mode (f, a->mode, a->isa);
+  return f;
+}
+
+/* ...................... End of fir_chain_fuse() ...................... */
+
+
+/*
+  ============================================================================
+
+        static long fir_chain_clip (long n, float *y);
+        ~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+        Description:
+        ~~~~~~~~~~~~
+
+        Count the samples of y[] that fl2sh_16bit() (with rounding)
+        would clip: normalized samples whose rounded value is above
+        32767 or below -32768.
+
+        History:
+        ~~~~~~~~
+        16.Oct.2026 v1.0 Created.
+
+ ============================================================================
+*/
+static long fir_chain_clip (long n, float *y) {
+  long k, nclip = 0;
+  double v;
+
+  for (k = 0; k < n; k++) {
+    v = y[k] * 32768;
+    nclip += (v >= 0.0) ? (v + 0.5 > 32767.0) : (v - 0.5 < -32768.0);
+  }
+  return nclip;
+}
+
+/* ...................... End of fir_chain_clip() ...................... */
+
+
+/* *************************** END OF FIR-CHAIN.C *************************** */
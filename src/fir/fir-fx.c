@@ -0,0 +1,416 @@
+/*                                                            16.Oct.2026 v1.0
+  =============================================================================
+
+                          U    U   GGG    SSSS  TTTTT
+                          U    U  G       S       T
+                          U    U  G  GG   SSSS    T
+                          U    U  G   G       S   T
+                           UUU     GG     SSS     T
+
+                   ========================================
+                    ITU-T - USER'S GROUP ON SOFTWARE TOOLS
+                   ========================================
+
+       =============================================================
+       COPYRIGHT NOTE: This source code, and all of its derivations,
+       is subject to the "ITU-T General Public License". Please have
+       it  read  in    the  distribution  disk,   or  in  the  ITU-T
+       Recommendation G.191 on "SOFTWARE TOOLS FOR SPEECH AND  AUDIO
+       CODING STANDARDS".
+       =============================================================
+
+MODULE:         FIRFLT, HIGH QUALITY FIR UP/DOWN-SAMPLING FILTER
+                Sub-unit: Fixed-point (Q15/Q31) FIR filtering
+
+DESCRIPTION:
+        This file contains a fixed-point version of the FIR filters of
+        this module, for 16-bit signals: the coefficients of a filter
+        built by any of the *_init() functions are quantized to Q15,
+        the dot-products are accumulated in Q31 and rounded to 16 bits,
+        with the basic operators of the STL (src/basop):
+
+          y = round_fx (L_shl (L_mac (... L_mult (x[n], h[0]) ...), s))
+
+        where s is the number of bits of headroom needed to represent
+        the largest coefficient (e.g. the gain L of the up-sampling
+        filters) in Q15. The rate change is done as in hq_kernel():
+        up-sampling, down-sampling and rational L/M filters give the
+        same number of output samples, for any segmentation.
+
+        Two implementations give bit-exact results:
+          - with basic operators (WMOPS counted with count.c), to
+            measure the complexity of the filter in a fixed-point design;
+          - with native integer arithmetic, for throughput. When no
+            partial sum of the dot-products of a chunk of input can
+            saturate (largest input magnitude times largest sum of the
+            magnitudes of the coefficients of a bank below 1.0 in Q31),
+            the sums are computed with plain 32-bit additions in any
+            order; otherwise, each L_mac() is emulated with saturation.
+
+        Compared to the float kernels, the output differs by the
+        quantization of the coefficients and of the output only.
+
+FUNCTIONS:
+  Global (have prototype in firflt.h)
+         = hq_fx_init(...)       : fixed-point filter from an SCD_FIR
+         = hq_fx_kernel(...)     : fixed-point FIR-filter function
+         = hq_fx_reset(...)      : clear state variables
+         = hq_fx_free(...)       : deallocate memory
+
+  Local (should be used only here -- prototypes only in this file)
+         = fir_fx_dot_basop(...) : dot-product with basic operators
+         = fir_fx_dot(...)       : dot-product with native integers
+
+HISTORY:
+    16.Oct.2026 v1.0 Created.
+
+  =============================================================================
+*/
+
+
+/*
+ * ......... INCLUDES .........
+ */
+#include <stdio.h>
+#include <stdlib.h>             /* General utility definitions */
+#include <string.h>             /* memcpy(), memmove() */
+#include <math.h>
+
+#include "firflt.h"             /* Global definitions for FIR-FIR filter */
+#include "stl.h"                /* Basic operators (basop module) */
+
+
+/*
+ * ......... Local definitions .........
+ */
+
+/* Max.number of input samples appended to the delay line at a time */
+#define FIR_FX_CHUNK 256
+
+
+/*
+ * ......... Local function prototypes .........
+ */
+
+static Word16 fir_fx_dot_basop ARGS ((Word16 * W, Word16 * h, long n, Word16 shift));
+static Word16 fir_fx_dot ARGS ((Word16 * W, Word16 * h, long n, Word16 shift, int nosat));
+
+
+/*
+ * ...................... BEGIN OF FUNCTIONS .........................
+ */
+
+/*
+  ============================================================================
+
+        SCD_FIR_FX *hq_fx_init (SCD_FIR *fir_ptr, int wmops);
+        ~~~~~~~~~~~~~~~~~~~~~~
+
+        Description:
+        ~~~~~~~~~~~~
+
+        Build the fixed-point version of a filter returned by one of
+        the *_init() functions (e.g. hq_up_1_to_2_init()): the (scaled)
+        coefficients are rounded to Q15 with the smallest headroom s
+        such that the largest of them fits, and split into the same
+        polyphase banks as in hq_kernel(). The float filter is not
+        changed; it may be freed with hq_free() afterwards.
+
+        Parameters:
+        ~~~~~~~~~~~
+        fir_ptr: .. (In) pointer to the float filter
+        wmops: .... (In) 1: filter with the basic operators (counted);
+                         0: native integer code (same results)
+
+        Return value:
+        ~~~~~~~~~~~~~
+        Pointer to struct SCD_FIR_FX, or NULL if out of memory.
+
+        History:
+        ~~~~~~~~
+        16.Oct.2026 v1.0 Created.
+
+ ============================================================================
+*/
+SCD_FIR_FX *hq_fx_init (SCD_FIR * fir_ptr, int wmops) {
+  SCD_FIR_FX *fx;
+  double hmax, scale;
+  long L, lenph, p, k, q, l1;
+
+  L = fir_ptr->nphase;
+  lenph = fir_ptr->lenph;
+
+  /* Allocate struct, coefficient banks and delay line */
+  if ((fx = (SCD_FIR_FX *) malloc (sizeof (SCD_FIR_FX))) == (SCD_FIR_FX *) NULL)
+    return NULL;
+  fx->hph = (short *) malloc (L * lenph * sizeof (short));
+  fx->T = (short *) calloc (lenph - 1 + FIR_FX_CHUNK, sizeof (short));
+  if (fx->hph == NULL || fx->T == NULL) {
+    hq_fx_free (fx);
+    return NULL;
+  }
+
+  /* Rate change: L banks, one output every M samples at the rate L*fs */
+  fx->lenh0 = fir_ptr->lenh0;
+  fx->nphase = L;
+  fx->lenph = lenph;
+  fx->ndown = (fir_ptr->hswitch == 'U') ? 1 : fir_ptr->dwn_up;
+  fx->wmops = (char) wmops;
+
+  /* Headroom: smallest s such that the largest coefficient rounds into Q15 scaled by 2^-s */
+  for (k = 0, hmax = 0; k < fir_ptr->lenh0; k++)
+    if (fabs (fir_ptr->h0[k]) > hmax)
+      hmax = fabs (fir_ptr->h0[k]);
+  for (fx->shift = 0; fx->shift < 15 && floor (hmax * (32768 >> fx->shift) + 0.5) > 32767; fx->shift++);
+  scale = 32768 >> fx->shift;
+
+  /* Banks reversed (oldest sample first), as in the float kernel; -32768 is never used, so L_mult() can't saturate */
+  for (p = 0, fx->habs = 0; p < L; p++) {
+    for (k = 0, l1 = 0; k < lenph; k++) {
+      q = (long) floor (fir_ptr->h0[p + k * L] * scale + 0.5);
+      q = (q > 32767) ? 32767 : (q < -32767) ? -32767 : q;
+      fx->hph[p * lenph + lenph - 1 - k] = (short) q;
+      l1 += labs (q);
+    }
+    if (l1 > fx->habs)
+      fx->habs = l1;
+  }
+
+  hq_fx_reset (fx);
+  return fx;
+}
+
+/* ........................ End of hq_fx_init() ........................ */
+
+
+/*
+  ============================================================================
+
+        long hq_fx_kernel (long lseg, short *x_ptr, SCD_FIR_FX *fir_ptr,
+        ~~~~~~~~~~~~~~~~~  short *y_ptr);
+
+        Description:
+        ~~~~~~~~~~~~
+
+        Fixed-point FIR-filter function: filter a segment of 16-bit
+        samples, with rate change. The number of output samples is the
+        same as with hq_kernel() for the float filter the struct was
+        built from.
+
+        Parameters:
+        ~~~~~~~~~~~
+        lseg: .... (In)    number of input samples
+        x_ptr: ... (In)    array with input samples
+        fir_ptr .. (InOut) pointer to fixed-point FIR-struct
+        y_ptr .... (Out)   array with output samples
+
+        Return value:
+        ~~~~~~~~~~~~~
+        Returns the number of filtered samples.
+
+        History:
+        ~~~~~~~~
+        16.Oct.2026 v1.0 Created.
+
+ ============================================================================
+*/
+long hq_fx_kernel (long lseg, short *x_ptr, SCD_FIR_FX * fir_ptr, short *y_ptr) {
+  long lenT = fir_ptr->lenph - 1;       /* number of state samples */
+  long L = fir_ptr->nphase, M = fir_ptr->ndown;
+  long kc, nc, kx, ky, k, t, xmax;
+  short *T = fir_ptr->T, *h;
+  int nosat;
+
+  ky = 0;                       /* starting index in output array (y) */
+  kx = fir_ptr->k0;             /* first input sample to be processed */
+  for (kc = 0; kc < lseg; kc += nc) {
+    /* Append next chunk of input samples to the state */
+    nc = (lseg - kc > FIR_FX_CHUNK) ? FIR_FX_CHUNK : lseg - kc;
+    memcpy (T + lenT, x_ptr + kc, nc * sizeof (short));
+
+    /* Native code: no saturation in this chunk if 2*max|x|*habs fits in 32 bits */
+    nosat = 0;
+    if (!fir_ptr->wmops) {
+      for (k = 0, xmax = 0; k < lenT + nc; k++)
+        xmax = (labs (T[k]) > xmax) ? labs (T[k]) : xmax;
+      nosat = (2.0 * xmax * fir_ptr->habs <= MAX_32);
+    }
+
+    /* Output j: input sample kx+(phase+j*M)/L, bank (phase+j*M)%L; the window of input sample kx is T[kx...kx+lenT] */
+    while (kx < nc) {
+      h = fir_ptr->hph + fir_ptr->phase * fir_ptr->lenph;
+      if (fir_ptr->wmops)
+        y_ptr[ky++] = fir_fx_dot_basop (T + kx, h, fir_ptr->lenph, fir_ptr->shift);
+      else
+        y_ptr[ky++] = fir_fx_dot (T + kx, h, fir_ptr->lenph, fir_ptr->shift, nosat);
+      t = fir_ptr->phase + M;
+      kx += t / L;
+      fir_ptr->phase = t % L;
+    }
+    kx -= nc;
+
+    /* Keep the last lenT samples as state */
+    memmove (T, T + nc, lenT * sizeof (short));
+
+#ifdef WMOPS
+    /* Data moves of the delay line */
+    if (fir_ptr->wmops)
+      for (k = 0; k < nc + lenT; k++)
+        move16 ();
+#endif
+  }
+
+  /* Offset of the first sample to be processed in the next segment */
+  fir_ptr->k0 = kx;
+
+  return ky;
+}
+
+/* ....................... End of hq_fx_kernel() ....................... */
+
+
+/*
+  ============================================================================
+
+        void hq_fx_reset (SCD_FIR_FX *fir_ptr);
+        ~~~~~~~~~~~~~~~~
+
+        Description:
+        ~~~~~~~~~~~~
+
+        Clear state variables of a fixed-point filter.
+
+        History:
+        ~~~~~~~~
+        16.Oct.2026 v1.0 Created.
+
+ ============================================================================
+*/
+void hq_fx_reset (SCD_FIR_FX * fir_ptr) {
+  memset (fir_ptr->T, 0, (fir_ptr->lenph - 1) * sizeof (short));
+  fir_ptr->k0 = 0;
+  fir_ptr->phase = 0;
+}
+
+/* ....................... End of hq_fx_reset() ....................... */
+
+
+/*
+  ============================================================================
+
+        void hq_fx_free (SCD_FIR_FX *fir_ptr);
+        ~~~~~~~~~~~~~~~
+
+        Description:
+        ~~~~~~~~~~~~
+
+        Deallocate a fixed-point filter.
+
+        History:
+        ~~~~~~~~
+        16.Oct.2026 v1.0 Created.
+
+ ============================================================================
+*/
+void hq_fx_free (SCD_FIR_FX * fir_ptr) {
+  free (fir_ptr->T);
+  free (fir_ptr->hph);
+  free (fir_ptr);
+}
+
+/* ....................... End of hq_fx_free() ....................... */
+
+
+/*
+  ============================================================================
+
+        static Word16 fir_fx_dot_basop (Word16 *W, Word16 *h, long n,
+        ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~  Word16 shift);
+
+        Description:
+        ~~~~~~~~~~~~
+
+        Output sample of a window of n input samples with the reversed
+        bank h: Q31 multiply-accumulate, headroom removed with a
+        saturating shift, rounded to 16 bits. Reference implementation,
+        with basic operators.
+
+        History:
+        ~~~~~~~~
+        16.Oct.2026 v1.0 Created.
+
+ ============================================================================
+*/
+static Word16 fir_fx_dot_basop (Word16 * W, Word16 * h, long n, Word16 shift) {
+  Word32 acc;
+  long k;
+
+  acc = L_mult (W[0], h[0]);
+  for (k = 1; k < n; k++)
+    acc = L_mac (acc, W[k], h[k]);
+  acc = L_shl (acc, shift);
+
+  return round_fx (acc);
+}
+
+/* ..................... End of fir_fx_dot_basop() ..................... */
+
+
+/*
+  ============================================================================
+
+        static Word16 fir_fx_dot (Word16 *W, Word16 *h, long n,
+        ~~~~~~~~~~~~~~~~~~~~~~~~  Word16 shift, int nosat);
+
+        Description:
+        ~~~~~~~~~~~~
+
+        Same as fir_fx_dot_basop(), in native integer arithmetic. If
+        nosat is set, no partial sum can leave the 32-bit range and the
+        products are summed in any order (the compiler may vectorize
+        the loop); otherwise, each L_mac() saturates as the basic
+        operator. The sums are kept in a long long, so that a product
+        or a partial sum beyond the 32-bit range is clamped rather than
+        wrapped where long has 32 bits (LLP64, ILP32). The Overflow
+        flag of the basic operators is not set.
+
+        History:
+        ~~~~~~~~
+        16.Oct.2026 v1.0 Created.
+
+ ============================================================================
+*/
+static Word16 fir_fx_dot (Word16 * W, Word16 * h, long n, Word16 shift, int nosat) {
+  long long acc;
+  long k;
+  int sum;
+
+  if (nosat) {
+    for (k = 0, sum = 0; k < n; k++)
+      sum += (int) W[k] * h[k];
+    acc = 2 * (long long) sum;
+  } else {
+    for (k = 0, acc = 0; k < n; k++) {
+      acc += 2 * (long long) W[k] * h[k];
+      acc = (acc > MAX_32) ? MAX_32 : (acc < -MAX_32 - 1LL) ? -MAX_32 - 1LL : acc;
+    }
+  }
+
+  /* L_shl(): saturating shift left */
+  if (acc > (MAX_32 >> shift))
+    acc = MAX_32;
+  else if (acc < ((-MAX_32 - 1LL) >> shift))
+    acc = -MAX_32 - 1LL;
+  else
+    acc *= 1LL << shift;
+
+  /* round_fx(): L_add() of 0x8000 saturates, then upper 16 bits */
+  if (acc > MAX_32 - 0x8000)
+    return MAX_16;
+  return (Word16) ((acc + 0x8000) >> 16);
+}
+
+/* ........................ End of fir_fx_dot() ........................ */
+
+
+/* **************************** END OF FIR-FX.C **************************** */
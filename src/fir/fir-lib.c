@@ -42,6 +42,8 @@ DESCRIPTION:
 FUNCTIONS:
   Global (have prototype in firflt.h)
          = hq_kernel(...)        :  FIR-filter function
+         = hq_kernel_multi(...)  :  FIR-filter function for interleaved
+                                    channels
          = hq_reset(...)         :  clear state variables
                                     (needed only if another signal should
                                     be processed with the same filter)
@@ -52,11 +54,12 @@ FUNCTIONS:
 	 it, but not in firflt.h)
          = fir_initialization(...) : common initialization function for
                                    all filter types;
+         = fir_malloc_aligned(...) : allocate memory aligned to FIR_ALIGN
+                                   bytes;
+         = fir_free_aligned(...) : free memory from fir_malloc_aligned();
   Local (should be used only here -- prototypes only in this file)
-         = fir_upsampling_kernel(...) : kernel function for all FIR
-                                   up-sampling procedures;
-         = fir_downsampling_kernel(...) : kernel function for all FIR
-                                   down-sampling procedures;
+         = fir_polyphase_kernel(...) : kernel function for all FIR
+                                   up- and down-sampling procedures;
 
 HISTORY:
     16.Dec.91 v0.1 First beta-version <hf@pkinbg.uucp>
@@ -71,6 +74,17 @@ HISTORY:
 				   OpenVMS/AXP <simao@ctd.comsat.com>
     03.Dec.04 v2.3 Added correction in fir_downsampling_kernel() for sample-based
 				   operation.	<Cyril Guillaume & Stephane Ragot - stephane.ragot@francetelecom.com>
+    16.Oct.26 v3.0 Replaced the up- and down-sampling kernels by a polyphase
+                   kernel working on contiguous per-phase coefficient banks
+                   built at initialization time.
+    16.Oct.26 v3.1 Coefficient banks stored reversed, zero-padded and
+                   aligned for the SIMD kernels in fir-simd.c.
+    16.Oct.26 v3.2 Rational L/M resampling in fir_polyphase_kernel().
+    16.Oct.26 v3.3 FFT (overlap-save) convolution for long filters without
+                   rate change in fast mode (fir-fft.c).
+    16.Oct.26 v3.4 Delay line kept in a mirrored ring buffer: no copy of
+                   the lenh0-1 state samples after each segment.
+    16.Oct.26 v3.5 Added hq_kernel_multi() for interleaved channels.
 
   =============================================================================
 */
@@ -81,19 +95,49 @@ HISTORY:
  */
 #include <stdio.h>
 #include <stdlib.h>             /* General utility definitions */
+#include <string.h>             /* memcpy(), memset() */
 
 #include "firflt.h"             /* Global definitions for FIR-FIR filter */
 
 
+/*
+ * ......... Local definitions .........
+ */
+
+/* Max.number of input samples filtered in one pass of the kernel (larger for FFT convolution, see below) */
+#define FIR_CHUNK 512
+
+/* Coefficient banks are padded to a multiple of FIR_PAD taps (one AVX-512 vector), and SIMD data aligned to FIR_ALIGN bytes */
+#define FIR_PAD   16
+#define FIR_ALIGN 64
+
+/* Filters without rate change use FFT convolution in fast mode from
+ * fir_fft_taps[isa] taps on (cross-over with the direct form of each
+ * instruction set), for chunks of at least lenpad output samples
+ * (shorter chunks use the direct form) */
+static long fir_fft_taps[] = { 128, 192, 256, 448 };
+
+
 /*
  * ......... Local function prototypes .........
  */
 
 
 SCD_FIR *fir_initialization ARGS ((long lenh0, float h0[], double gain, long idwnup, int hswitch));
+void *fir_malloc_aligned ARGS ((long size));
+void fir_free_aligned ARGS ((void *ptr));
 
-static long fir_upsampling_kernel ARGS ((long lenx, float *x_ptr, float *y_ptr, long lenh0, float *h0_ptr, float *T_ptr, long iupfac));
-static long fir_downsampling_kernel ARGS ((long lenx, float *x_ptr, float *y_ptr, long lenh0, float *h0_ptr, float *T_ptr, long downfac, long *k0_ptr));
+static long fir_polyphase_kernel ARGS ((long lenx, float *x_ptr, float *y_ptr, SCD_FIR * fir_ptr, long nchan));
+
+
+/*
+ * ..... Private function prototypes defined in other sub-unit .....
+ */
+extern void fir_block_filter ARGS ((SCD_FIR * fir, float *W, long npos, long step, float *hb, long nb, long ys, float *y));
+extern void fir_block_filter_multi ARGS ((SCD_FIR * fir, long nchan, float *W, long npos, long step, float *hb, long nb, long ys, float *y));
+extern int fir_fft_init ARGS ((SCD_FIR * fir, long nfft));
+extern void fir_fft_filter ARGS ((SCD_FIR * fir, float *W, long npos, float *y));
+extern void fir_fft_free ARGS ((SCD_FIR * fir));
 
 
 /*
@@ -140,36 +184,84 @@ static long fir_downsampling_kernel ARGS ((long lenx, float *x_ptr, float *y_ptr
         History:
         ~~~~~~~~
         28.Feb.92 v1.0 Release of 1st version <hf@pkinbg.uucp>
+        16.Oct.26 v2.0 Single polyphase kernel for all rate changes.
+        16.Oct.26 v2.1 Same as hq_kernel_multi() with one channel.
 
  ============================================================================
 */
 long hq_kernel (long lseg, float *x_ptr, SCD_FIR * fir_ptr, float *y_ptr) {
-  if (fir_ptr->hswitch == 'U')  /* call up-sampling procedure */
-    return fir_upsampling_kernel (      /* returns number of output samples */
-                                   lseg,        /* In : length of input signal */
-                                   x_ptr,       /* In : array with input samples */
-                                   y_ptr,       /* Out : array with output samples */
-                                   fir_ptr->lenh0,      /* In : number of FIR-coefficients */
-                                   fir_ptr->h0, /* In : array with FIR-coefficients */
-                                   fir_ptr->T,  /* InOut: state variables */
-                                   fir_ptr->dwn_up      /* In : upsampling factor */
-      );
-  else                          /* call down-sampling procedure */
-    return fir_downsampling_kernel (    /* returns number of output samples */
-                                     lseg,      /* In : length of input signal */
-                                     x_ptr,     /* In : array with input samples */
-                                     y_ptr,     /* Out : array with output samples */
-                                     fir_ptr->lenh0,    /* In : number of FIR-coefficients */
-                                     fir_ptr->h0,       /* In : array with FIR-coefficients */
-                                     fir_ptr->T,        /* InOut: state variables */
-                                     fir_ptr->dwn_up,   /* In : downsampling factor */
-                                     &(fir_ptr->k0)     /* InOut: starting index in * x-array */
-      );
+  return hq_kernel_multi (1, lseg, x_ptr, fir_ptr, y_ptr);
 }
 
 /* .......................... End of hq_kernel() .......................... */
 
 
+/*
+  ============================================================================
+
+        long hq_kernel_multi (int nchan, long lseg, float *x_ptr,
+        ~~~~~~~~~~~~~~~~~~~~  SCD_FIR *fir_ptr, float *y_ptr);
+
+        Description:
+        ~~~~~~~~~~~~
+
+        FIR-filter function for `nchan' interleaved channels (e.g.
+        stereo or 5.1 material): all the channels are filtered with the
+        coefficients of fir_ptr, each one with its own state. The
+        channels are computed in parallel (SIMD lanes), in the summation
+        order of the strict kernels, hence every output channel is
+        bit-exact with the strict filtering of that channel alone with
+        hq_kernel(); FFT convolution is not used for nchan>1.
+
+        The state of the filter holds one delay line per channel. When
+        the number of channels differs from the previous call, the state
+        is re-allocated and cleared (as by hq_reset()).
+
+        Parameters:
+        ~~~~~~~~~~~
+        nchan: ... (In)    number of interleaved channels
+        lseg: .... (In)    number of input samples per channel
+        x_ptr: ... (In)    array with lseg*nchan interleaved input samples
+        fir_ptr .. (InOut) pointer to FIR-struct
+        y_ptr .... (Out)   interleaved output samples
+
+        Return value:
+        ~~~~~~~~~~~~~
+        Returns the number of filtered samples per channel, or -1 if
+        nchan is less than 1 or the state for nchan channels could not
+        be allocated.
+
+        History:
+        ~~~~~~~~
+        16.Oct.26 v1.0 Created.
+
+ ============================================================================
+*/
+long hq_kernel_multi (int nchan, long lseg, float *x_ptr, SCD_FIR * fir_ptr, float *y_ptr) {
+  float *T;
+
+  /* Delay lines for nchan channels */
+  if (nchan != fir_ptr->nchan) {
+    if (nchan < 1 || (T = (float *) fir_malloc_aligned (2 * nchan * fir_ptr->lring * sizeof (float))) == (float *) 0)
+      return -1;
+    fir_free_aligned (fir_ptr->T);
+    fir_ptr->T = T;
+    fir_ptr->nchan = nchan;
+    hq_reset (fir_ptr);
+  }
+
+  return fir_polyphase_kernel ( /* returns number of output samples */
+                                lseg,   /* In : length of input signal */
+                                x_ptr,  /* In : array with input samples */
+                                y_ptr,  /* Out : array with output samples */
+                                fir_ptr,        /* InOut: coefficient banks & state */
+                                nchan   /* In : number of channels */
+    );
+}
+
+/* ....................... End of hq_kernel_multi() ....................... */
+
+
 /*
   ============================================================================
 
@@ -203,7 +295,9 @@ long hq_kernel (long lseg, float *x_ptr, SCD_FIR * fir_ptr, float *y_ptr) {
 */
 void hq_free (SCD_FIR * fir_ptr) {
 
-  free (fir_ptr->T);            /* free state variables */
+  fir_free_aligned (fir_ptr->T);        /* free state variables */
+  fir_free_aligned (fir_ptr->hph);      /* free polyphase coefficient banks */
+  fir_fft_free (fir_ptr);       /* free FFT tables and buffers (if any) */
   free (fir_ptr->h0);           /* free state impulse response */
   free (fir_ptr);               /* free allocated struct */
 }
@@ -238,14 +332,16 @@ void hq_free (SCD_FIR * fir_ptr) {
         History:
         ~~~~~~~~
         28.Feb.92 v1.0 Release of 1st version <hf@pkinbg.uucp>
+        16.Oct.26 v1.1 Clears the mirrored ring buffer.
 
  ============================================================================
 */
 void hq_reset (SCD_FIR * fir_ptr) {
-  long k;
-  for (k = 0; k < fir_ptr->lenh0 - 1; k++)      /* clear delay line */
-    fir_ptr->T[k] = 0.0;        /* (= state variables) */
+  /* clear delay line (= state variables), both copies of the ring */
+  memset (fir_ptr->T, 0, 2 * fir_ptr->nchan * fir_ptr->lring * sizeof (float));
+  fir_ptr->widx = 0;            /* next input sample at start of ring */
   fir_ptr->k0 = 0;              /* default starting index in x-array */
+  fir_ptr->phase = 0;           /* first output uses bank 0 */
 }
 
 /* .......................... End of hq_reset() .......................... */
@@ -283,13 +379,35 @@ void hq_reset (SCD_FIR * fir_ptr) {
         ~~~~~~~~
         28.Feb.92 v1.0 Release of 1st version <hf@pkinbg.uucp>
         12.Mar.92 v1.1 Corrected casting of malloc.
+        16.Oct.26 v1.2 Split coefficients into polyphase banks; delay line
+                       extended by a work area of FIR_CHUNK samples.
+        16.Oct.26 v1.3 Banks reversed and padded to FIR_PAD taps; aligned
+                       allocation; strict kernel with best SIMD by default.
+        16.Oct.26 v1.4 FFT convolution state for long filters without rate
+                       change; work area enlarged to one FFT block.
+        16.Oct.26 v1.5 Delay line allocated as a mirrored ring buffer.
 
  ============================================================================
 */
 SCD_FIR *fir_initialization (long lenh0, float h0[], double gain, long idwnup, int hswitch) {
   SCD_FIR *ptrFIR;              /* pointer to the new struct */
   float fak;
-  long k;
+  long k, p, nphase, lenph, lenpad, lchunk, nfft;
+
+
+  /* Up-sampling by L uses L banks of lenh0/L coefficients; one bank else */
+  nphase = (hswitch == 'U') ? idwnup : 1;
+  lenph = lenh0 / nphase;
+  lenpad = (lenph + FIR_PAD - 1) / FIR_PAD * FIR_PAD;
+
+  /* Long filters without rate change: FFT of at least 2*lenpad points, so that at least half of each block are output samples; the work area holds one block */
+  lchunk = FIR_CHUNK;
+  nfft = 0;
+  if (hswitch == 'D' && idwnup == 1 && lenh0 >= fir_fft_taps[HQ_ISA_C]) {
+    for (nfft = 4; nfft < 2 * lenpad; nfft *= 2);
+    if (nfft - lenpad + 1 > lchunk)
+      lchunk = nfft - lenpad + 1;
+  }
 
 
 /*
@@ -301,15 +419,23 @@ SCD_FIR *fir_initialization (long lenh0, float h0[], double gain, long idwnup, i
     return 0;
   }
 
-  /* Allocate memory for delay line */
-  if ((ptrFIR->T = (float *) malloc ((lenh0 - 1) * sizeof (fak))) == (float *) 0) {
+  /* Allocate memory for delay line: ring of lenpad-1 state samples plus one chunk of input, stored twice */
+  if ((ptrFIR->T = (float *) fir_malloc_aligned (2 * (lenpad - 1 + lchunk) * sizeof (fak))) == (float *) 0) {
     free (ptrFIR);              /* deallocate struct FIR */
     return 0;
   }
 
   /* Allocate memory for impulse response */
   if ((ptrFIR->h0 = (float *) malloc (lenh0 * sizeof (fak))) == (float *) 0) {
-    free (ptrFIR->T);           /* deallocate delay line */
+    fir_free_aligned (ptrFIR->T);       /* deallocate delay line */
+    free (ptrFIR);              /* deallocate struct FIR */
+    return 0;
+  }
+
+  /* Allocate memory for polyphase coefficient banks */
+  if ((ptrFIR->hph = (float *) fir_malloc_aligned (nphase * lenpad * sizeof (fak))) == (float *) 0) {
+    free (ptrFIR->h0);          /* deallocate impulse response */
+    fir_free_aligned (ptrFIR->T);       /* deallocate delay line */
     free (ptrFIR);              /* deallocate struct FIR */
     return 0;
   }
@@ -325,6 +451,17 @@ SCD_FIR *fir_initialization (long lenh0, float h0[], double gain, long idwnup, i
   for (k = 0; k <= ptrFIR->lenh0 - 1; k++)
     ptrFIR->h0[k] = gain * h0[k];
 
+  /* Split coefficients into polyphase banks: bank p holds h0[p+k*nphase], stored reversed (oldest sample first) after lenpad-lenph zeros */
+  ptrFIR->nphase = nphase;
+  ptrFIR->lenph = lenph;
+  ptrFIR->lenpad = lenpad;
+  for (p = 0; p < nphase; p++) {
+    for (k = 0; k < lenpad - lenph; k++)
+      ptrFIR->hph[p * lenpad + k] = 0.0;
+    for (k = 0; k < lenph; k++)
+      ptrFIR->hph[p * lenpad + lenpad - 1 - k] = ptrFIR->h0[p + k * nphase];
+  }
+
   /* Store down-/up-sampling factor */
   ptrFIR->dwn_up = idwnup;
 
@@ -332,12 +469,26 @@ SCD_FIR *fir_initialization (long lenh0, float h0[], double gain, long idwnup, i
   ptrFIR->hswitch = hswitch;
 
   /* Clear Delay Line */
-  for (k = 0; k < ptrFIR->lenh0 - 1; k++)
-    ptrFIR->T[k] = 0.0;
+  ptrFIR->lchunk = lchunk;
+  ptrFIR->lring = lenpad - 1 + lchunk;
+  memset (ptrFIR->T, 0, 2 * ptrFIR->lring * sizeof (fak));
+  ptrFIR->widx = 0;
+  ptrFIR->nchan = 1;
+
+  /* Spectrum of h0 for FFT convolution; if out of memory, the direct form is always used */
+  ptrFIR->nfft = 0;
+  ptrFIR->fftH = ptrFIR->fftX = NULL;
+  ptrFIR->fftplan = NULL;
+  if (nfft > 0)
+    fir_fft_init (ptrFIR, nfft);
+
+  /* Default kernel: bit-exact, with the best instruction set available */
+  hq_mode (ptrFIR, HQ_STRICT, HQ_ISA_AUTO);
 
   /* Store default starting index for the x-array */
   /* NOTE: for down-sampling: if the number of input samples is not a multiple of the down-sampling factor, k0 points to the first sample in the next input segment to be processed */
   ptrFIR->k0 = 0;
+  ptrFIR->phase = 0;
 
   /* Return pointer to struct */
   return (ptrFIR);
@@ -349,243 +500,190 @@ SCD_FIR *fir_initialization (long lenh0, float h0[], double gain, long idwnup, i
 /*
   ============================================================================
 
-        long fir_downsampling_kernel (long lenx, float *x_ptr, float *y_ptr,
-        ~~~~~~~~~~~~~~~~~~~~~~~~~~~~  long lenh0, float *h0_ptr, float *T_ptr,
-                                      long downfac, long *k0_ptr);
+        void *fir_malloc_aligned (long size);
+        ~~~~~~~~~~~~~~~~~~~~~~~~
+        void fir_free_aligned (void *ptr);
+        ~~~~~~~~~~~~~~~~~~~~~
 
         Description:
         ~~~~~~~~~~~~
 
-        FIR-Filter (kernel) (for down-sampling, including downsampling
-        factor 1).
-
-        Parameters:
-        ~~~~~~~~~~~
-        lenx: ..... (In)    length of input signal
-        x: ........ (In)    array with input samples
-        y: ........ (Out)   array with output samples
-        lenh0: .... (In)    number of  FIR-coefficients
-        h0: ....... (In)    array with FIR-coefficients
-        T: ........ (InOut) state variables
-        downfac: .. (In)    downsampling factor
-        k0: ....... (InOut) offset in x-array
+        Allocate a memory block of `size' bytes starting at a multiple
+        of FIR_ALIGN bytes, as needed by the aligned SIMD loads, and
+        release it. The pointer returned by malloc() is kept just before
+        the aligned block.
 
         Return value:
         ~~~~~~~~~~~~~
-        Number of filtered samples.
-
-        Author: <hf@pkinbg.uucp>
-        ~~~~~~~
+        Pointer to the aligned block, or NULL if out of memory.
 
         History:
         ~~~~~~~~
-        28.Feb.1992 v1.0 Release of 1st version <hf@pkinbg.uucp>
-        12.Jul.2000 -    Bug identified; correction solicited  <simao>
-		03.Dec.2004 v2.3 Sample-based bug solved. <Cyril Guillaume & Stephane Ragot - stephane.ragot@francetelecom.com>
+        16.Oct.26 v1.0 Created.
 
  ============================================================================
 */
-static long fir_downsampling_kernel (long lenx, float *x, float *y, long lenh0, float *h0, float *T, long downfac, long *k0) {
-  long ktrans, kx, kStart, ky, kappa;   /* loop indices */
-
-
-/*
-  * ......... First Step: Transition from k=0 ... k=lenh0-2 .........
-  */
-
-  kStart = *k0;
-  ky = 0;                       /* starting index in output array (y) */
-  ktrans = lenh0 - 1;
-  if (ktrans > lenx - 1)
-    ktrans = lenx - 1;          /* x[*] less than h0[*]? */
-
-  for (kx = *k0; kx <= ktrans; kx += downfac) {
-    y[ky] = x[kx] * h0[0];      /* first part in dot-product */
-    for (kappa = 1; kappa <= kx; kappa++) {     /* first part from x-array */
-      y[ky] += x[kx - kappa] * h0[kappa];
-    }
-
-    for (kappa = kx + 1; kappa < lenh0; kappa++) {      /* second part from * T-array */
-      y[ky] += T[lenh0 - 2 + kx + 1 - kappa] * h0[kappa];
-    }
-    ky++;
-    kStart = kx;                /* Save index of last processed sample */
-  }
-
-
-/*
-  * ......... Second Step: remaining part in x-array .........
-  */
-
-  *k0 = kStart;
-  for (kx = kStart + downfac; kx <= lenx - 1; kx += downfac) {
-    y[ky] = x[kx] * h0[0];      /* first part in dot-product */
-    for (kappa = 1; kappa <= lenh0 - 1; kappa++) {
-      y[ky] += x[kx - kappa] * h0[kappa];       /* remaining part of dot-product */
-    }
-    ky++;
-    *k0 = kx;
-  }
-
-  /* if the number of input samples is not a multiple of the down sampling factor, k0 points to the first sample in the next input segment to be processed */
-  if (*k0 <= lenx - 1) {
-    *k0 = *k0 + downfac;
-    *k0 = *k0 - lenx;
-  } else {                      /* if the offset was greater than the block length, nothing was done. * Just decrease the value of this offset with the size of this "skipped" block */
-    *k0 = *k0 - lenx;
-  }
-
-
-/*
- * ......... Last Step: copy end of x-array into T-array .........
- *                      (update of delay line)
- */
-
-  if (lenx >= lenh0 - 1) {      /* ... all samples taken from x-array */
-    for (kappa = 0; kappa <= lenh0 - 2; kappa++) {
-      T[kappa] = x[lenx + 1 - lenh0 + kappa];
-    }
-  } else {
-    /* Left-Shift of T-array */
-    for (kappa = 0; kappa <= lenh0 - 2 - lenx; kappa++) {
-      T[kappa] = T[kappa + lenx];
-    }
-
-    /* Copy complete x-array -> T-array */
-    for (kappa = lenh0 - 1 - lenx; kappa <= lenh0 - 2; kappa++) {
-      T[kappa] = x[lenx - 1 + kappa - (lenh0 - 2)];
-    }
-  }
-
-  /* Return number of output samples */
-  return ky;
+void *fir_malloc_aligned (long size) {
+  char *raw, *ptr;
+
+  if ((raw = (char *) malloc (size + FIR_ALIGN + sizeof (void *))) == (char *) NULL)
+    return NULL;
+  ptr = raw + sizeof (void *);
+  ptr += (FIR_ALIGN - (size_t) ptr % FIR_ALIGN) % FIR_ALIGN;
+  ((void **) ptr)[-1] = raw;
+  return ptr;
 }
 
-/* ................... End of fir_downsampling_kernel() ................... */
+void fir_free_aligned (void *ptr) {
+  if (ptr != NULL)
+    free (((void **) ptr)[-1]);
+}
 
+/* ................. End of fir_{malloc,free}_aligned() ................. */
 
 
 /*
   ============================================================================
 
-        long fir_upsampling_kernel (long lenx, float *x_ptr, float *y_ptr,
-        ~~~~~~~~~~~~~~~~~~~~~~~~~~  long lenh0, float *h0_ptr, float *T_ptr,
-                                    long iupfac);
+        long fir_polyphase_kernel (long lenx, float *x_ptr, float *y_ptr,
+        ~~~~~~~~~~~~~~~~~~~~~~~~~  SCD_FIR *fir_ptr);
 
         Description:
         ~~~~~~~~~~~~
 
-        FIR-Filter (kernel) for upsampling routine.
+        Polyphase FIR-Filter (kernel) for up- and down-sampling
+        (including factor 1).
+
+        The coefficients have been split by fir_initialization() into
+        `nphase' contiguous banks of `lenph' coefficients each. For
+        up-sampling by L, bank p holds h0[p], h0[p+L], h0[p+2L], ...
+        and yields output sample p of every group of L outputs, so that
+        the zeros inserted by the up-sampler are never multiplied. For
+        down-sampling by M there is a single bank (the full impulse
+        response) which is only evaluated at the input positions whose
+        output is kept, i.e. every M-th sample starting at k0.
+
+        For rational resampling by L/M (hswitch 'R', nphase=L,
+        dwn_up=M), output n corresponds to the instant n*M of the
+        signal up-sampled by L: its newest input sample is n*M/L and its
+        bank (n*M)%L. Outputs n and n+L use the same bank and input
+        samples M apart, hence the outputs of a chunk are computed as L
+        interleaved sequences with input step M. The bank of the next
+        output is kept in `phase' between calls.
+
+        The delay line T is a ring buffer of lring=lenpad-1+lchunk
+        samples stored twice (T[i]=T[i+lring]), with the next input
+        sample written at widx. The input is processed in chunks of at
+        most lchunk samples: after a chunk has been written to the ring,
+        the lenpad-1 preceding samples and the chunk are contiguous in
+        memory starting at T[(widx-lenpad+1) mod lring], whatever the
+        position in the ring. Hence no state is copied between calls,
+        which matters for short segments (e.g. 10 to 20 samples), where
+        the copy of the lenh0-1 state samples used to cost more than the
+        filtering itself. The
+        dot-products are computed by fir_block_filter() (fir-simd.c)
+        with the kernel selected by hq_mode(); in strict mode they are
+        bit-exact with the original kernels.
+
+        In fast mode, long filters without rate change (nfft>0, at least
+        fir_fft_taps[isa] taps) compute chunks of at least lenpad
+        samples by overlap-save FFT convolution, fir_fft_filter()
+        (fir-fft.c).
+
+        With nchan>1 interleaved channels, T holds interleaved frames
+        (all indices above count frames) and the dot-products are
+        computed by fir_block_filter_multi().
 
         Parameters:
         ~~~~~~~~~~~
-        lenx: .... (In)    length of input signal
-        x: ....... (In)    array with input samples
-        y: ....... (Out)   array with output samples
-        lenh0: ... (In)    number of  FIR-coefficients
-        h0: ...... (In)    array with FIR-coefficients
-        T: ....... (InOut) state variables
-        iupfac: .. (In)    upsampling factor
+        lenx: ..... (In)    length of input signal (frames)
+        x: ........ (In)    array with input samples
+        y: ........ (Out)   array with output samples
+        fir: ...... (InOut) pointer to FIR-struct
+        nchan: .... (In)    number of interleaved channels
 
         Return value:
         ~~~~~~~~~~~~~
         Number of filtered samples.
 
-        Author: <hf@pkinbg.uucp>
-        ~~~~~~~
-
         History:
         ~~~~~~~~
-        28.Feb.92 v1.0 Release of 1st version <hf@pkinbg.uucp>
+        16.Oct.2026 v1.0 Replaces fir_downsampling_kernel() and
+                         fir_upsampling_kernel().
+        16.Oct.2026 v1.1 FFT convolution of long chunks in fast mode.
+        16.Oct.2026 v1.2 Mirrored ring buffer instead of shifting the
+                         delay line.
+        16.Oct.2026 v1.3 Interleaved channels.
 
  ============================================================================
 */
-static long fir_upsampling_kernel (lenx, x, y, lenh0, h0, T, iupfac)
-     long lenx;
-     float *x, *y;
-     long lenh0;
-     float *h0, *T;
-     long iupfac;
-{
-  long ktrans, iup, kx, kStart, ky, kappa;      /* loop indices */
+static long fir_polyphase_kernel (long lenx, float *x, float *y, SCD_FIR * fir, long nchan) {
+  long lenT = fir->lenpad - 1;  /* number of state samples */
+  long R = fir->lring;          /* ring length */
+  long step, nc, n1, kc, kx, ky, npos, nout, j, kj, t;
+  float *W;                     /* state followed by current chunk */
 
+  /* Distance between input samples that produce output */
+  step = (fir->hswitch == 'U') ? 1 : fir->dwn_up;
 
   ky = 0;                       /* starting index in output array (y) */
-
-/*
-  * ......... FIRST STEP: Transition from k=(0..lenh0/iupasm-2) .........
-  */
-
-  kStart = 0;
-  ktrans = (lenh0 / iupfac > lenx ?     /* length of transition */
-            lenx : lenh0 / iupfac);
-  for (kx = 0; kx <= ktrans - 1; kx++) {
-    /* Loop over #iupfac partial FIR coefficients */
-    for (iup = 0; iup <= iupfac - 1; iup++) {
-      /* ... first contribution in dot-product */
-      y[ky] = x[kx] * h0[iup];
-
-      /* ... compute partial dot-product with source data from x-array */
-      for (kappa = 1; kappa <= kx; kappa++) {
-        y[ky] += x[kx - kappa] * h0[iup + kappa * iupfac];
+  kx = fir->k0;                 /* first input sample to be processed */
+  for (kc = 0; kc < lenx; kc += nc) {
+    /* Append next chunk of input samples to the state */
+    nc = (lenx - kc > fir->lchunk) ? fir->lchunk : lenx - kc;
+    W = fir->T + (fir->widx + R - lenT) % R * nchan;
+
+    /* Write the chunk into both copies of the ring */
+    n1 = (nc < R - fir->widx) ? nc : R - fir->widx;
+    memcpy (fir->T + fir->widx * nchan, x + kc * nchan, n1 * nchan * sizeof (float));
+    memcpy (fir->T + (fir->widx + R) * nchan, x + kc * nchan, n1 * nchan * sizeof (float));
+    memcpy (fir->T, x + (kc + n1) * nchan, (nc - n1) * nchan * sizeof (float));
+    memcpy (fir->T + R * nchan, x + (kc + n1) * nchan, (nc - n1) * nchan * sizeof (float));
+    fir->widx = (fir->widx + nc) % R;
+
+    /* Dot-products for the kept output samples; the window of input sample kx is W[kx...kx+lenT] */
+    if (fir->hswitch == 'R' && kx < nc) {
+      /* Output j+i*L: input sample kx+(phase+j*M)/L+i*M, bank (phase+j*M)%L */
+      for (j = 0, nout = 0; j < fir->nphase; j++) {
+        t = fir->phase + j * step;
+        kj = kx + t / fir->nphase;
+        if (kj >= nc)
+          break;
+        npos = (nc - kj + step - 1) / step;
+        if (nchan == 1)
+          fir_block_filter (fir, W + kj, npos, step, fir->hph + (t % fir->nphase) * fir->lenpad, 1, fir->nphase, y + ky + j);
+        else
+          fir_block_filter_multi (fir, nchan, W + kj * nchan, npos, step, fir->hph + (t % fir->nphase) * fir->lenpad, 1, fir->nphase, y + (ky + j) * nchan);
+        nout += npos;
       }
-
-      /* ... compute rest of dot-product with source data from T-array */
-      for (kappa = kx + 1; kappa < lenh0 / iupfac; kappa++) {
-        y[ky] += T[lenh0 / iupfac - 2 + kx + 1 - kappa]
-          * h0[iup + kappa * iupfac];
-      }
-      ky++;
+      ky += nout;
+      t = fir->phase + nout * step;
+      kx += t / fir->nphase;
+      fir->phase = t % fir->nphase;
+    } else if (kx < nc) {
+      npos = (nc - kx + step - 1) / step;
+      if (nchan > 1)
+        fir_block_filter_multi (fir, nchan, W + kx * nchan, npos, step, fir->hph, fir->nphase, fir->nphase, y + ky * nchan);
+      else if (fir->mode == HQ_FAST && fir->nfft > 0 && fir->lenh0 >= fir_fft_taps[(int) fir->isa] && npos >= fir->lenpad)
+        fir_fft_filter (fir, W + kx, npos, y + ky);
+      else
+        fir_block_filter (fir, W + kx, npos, step, fir->hph, fir->nphase, fir->nphase, y + ky);
+      ky += fir->nphase * npos;
+      kx += npos * step;
     }
-    kStart = kx;                /* Save index of last processed sample */
-  }
-
-
-/*
- * ......... SECOND STEP: compute remaining dot-products ..........
- *                        completely with data from x[*]
- */
 
-  for (kx = kStart + 1; kx <= lenx - 1; kx++) {
-    for (iup = 0; iup <= iupfac - 1; iup++) {
-      /* ... first contribution in dot-product */
-      y[ky] = x[kx] * h0[iup];
-
-      /* ... compute partial dot-product with source data from x-array */
-      for (kappa = 1; kappa <= lenh0 / iupfac - 1; kappa++) {
-        y[ky] += x[kx - kappa] * h0[iup + kappa * iupfac];
-      }
-      ky++;
-    }
+    /* Offset of the next sample to be processed, relative to next chunk */
+    kx -= nc;
   }
 
+  /* if the number of input samples is not a multiple of the down sampling factor, k0 points to the first sample in the next input segment to be processed */
+  fir->k0 = kx;
 
-/*
- * ......... Last Step: copy end of x-array into T-array .........
- *                        (update of delay line)
- */
-
-  if (lenx >= lenh0 / iupfac - 1) {
-    /* ... all samples taken from x-array */
-    for (kappa = 0; kappa <= lenh0 / iupfac - 2; kappa++) {
-      T[kappa] = x[lenx + 1 - lenh0 / iupfac + kappa];
-    }
-  } else {
-    /* ... left-Shift of T-array */
-    for (kappa = 0; kappa <= lenh0 / iupfac - 2 - lenx; kappa++) {
-      T[kappa] = T[kappa + lenx];
-    }
-
-    /* ... copy complete x-array -> T-array */
-    for (kappa = lenh0 / iupfac - 1 - lenx; kappa <= lenh0 / iupfac - 2; kappa++) {
-      T[kappa] = x[lenx - 1 + kappa - (lenh0 / iupfac - 2)];
-    }
-  }
-
+  /* Return number of output samples */
   return ky;
 }
 
-/* ................. End of fir_upsampling_kernel() .................. */
+/* ................... End of fir_polyphase_kernel() ................... */
 
 
 /* **************************** END OF FIR-LIB.C ************************** */
@@ -0,0 +1,264 @@
+/*                                                            16.Oct.2026 v1.0
+  =============================================================================
+
+                          U    U   GGG    SSSS  TTTTT
+                          U    U  G       S       T
+                          U    U  G  GG   SSSS    T
+                          U    U  G   G       S   T
+                           UUU     GG     SSS     T
+
+                   ========================================
+                    ITU-T - USER'S GROUP ON SOFTWARE TOOLS
+                   ========================================
+
+       =============================================================
+       COPYRIGHT NOTE: This source code, and all of its derivations,
+       is subject to the "ITU-T General Public License". Please have
+       it  read  in    the  distribution  disk,   or  in  the  ITU-T
+       Recommendation G.191 on "SOFTWARE TOOLS FOR SPEECH AND  AUDIO
+       CODING STANDARDS".
+       =============================================================
+
+MODULE:         FIRFLT, HIGH QUALITY FIR UP/DOWN-SAMPLING FILTER
+                Sub-unit: Rational L/M resampler
+
+DESCRIPTION:
+        This file contains the initialization of a polyphase resampler
+        for an arbitrary rational factor L/M (e.g. 147/160 for 48 kHz
+        to 44.1 kHz, or 3/4 for 16 kHz to 12 kHz). The low-pass
+        prototype, running at L times the input rate, is designed at
+        initialization time with a Kaiser window. The filtering is done
+        in one pass by hq_kernel(), which only computes the output
+        samples (no computation at the intermediate rate L*fs).
+
+FUNCTIONS:
+  Global (have prototype in firflt.h)
+         = hq_resample_init(...) : initialize L/M resampler
+
+  Local (should be used only here -- prototypes only in this file)
+         = fir_bessel_i0(...)    : modified Bessel function of order 0
+         = fill_resample_lp(...) : design of Kaiser-windowed low-pass
+
+HISTORY:
+    16.Oct.2026 v1.0 Created.
+
+  =============================================================================
+*/
+
+
+/*
+ * ......... INCLUDES .........
+ */
+#include <stdio.h>
+#include <stdlib.h>             /* General utility definitions */
+#include <math.h>
+
+#include "firflt.h"             /* Global definitions for FIR-FIR filter */
+
+
+/*
+ * ......... Local definitions .........
+ */
+
+#ifndef PI
+#define PI 3.14159265358979323846
+#endif
+
+/* Stopband attenuation of the prototype low-pass, in dB */
+#define RSMP_ATT 100.0
+
+
+/*
+ * ......... Local function prototypes .........
+ */
+
+static double fir_bessel_i0 ARGS ((double x));
+static float *fill_resample_lp ARGS ((long L, long M, double passband, double stopband, long *lenh0));
+
+
+/*
+ * ..... Private function prototypes defined in other sub-unit .....
+ */
+extern SCD_FIR *fir_initialization ARGS ((long lenh0, float h0[], double gain, long idwnup, int hswitch));
+
+
+/*
+ * ...................... BEGIN OF FUNCTIONS .........................
+ */
+
+/*
+  ============================================================================
+
+        SCD_FIR *hq_resample_init (long L, long M, double passband,
+        ~~~~~~~~~~~~~~~~~~~~~~~~~  double stopband);
+
+        Description:
+        ~~~~~~~~~~~~
+
+        Initialization routine for a rational sampling rate converter:
+        the output rate is L/M times the input rate. Both edges of the
+        low-pass are given relative to the Nyquist frequency of the
+        lower of the two rates, e.g. 0.9 and 1.0. The stopband
+        attenuation is RSMP_ATT dB; the number of taps per output sample
+        grows with the inverse of the transition band.
+
+        After hq_kernel(), the number of output samples for an input
+        segment of N samples is either floor or ceil of N*L/M.
+
+        Parameters:
+        ~~~~~~~~~~~
+        L: ......... (In) up-sampling factor
+        M: ......... (In) down-sampling factor
+        passband: .. (In) end of passband  (0 < passband < stopband)
+        stopband: .. (In) start of stopband (stopband <= 1)
+
+        Return value:
+        ~~~~~~~~~~~~~
+        Returns a pointer to struct SCD_FIR, or NULL for invalid
+        parameters or if out of memory.
+
+        History:
+        ~~~~~~~~
+        16.Oct.2026 v1.0 Created.
+
+ ============================================================================
+*/
+SCD_FIR *hq_resample_init (long L, long M, double passband, double stopband) {
+  SCD_FIR *ptrFIR;
+  float *h0;                    /* pointer to array with FIR coeff. */
+  long lenh0;                   /* number of FIR coefficients */
+  long a, b, r;
+
+  if (L < 1 || M < 1 || passband <= 0 || stopband <= passband || stopband > 1)
+    return NULL;
+
+  /* Reduce L/M to lowest terms */
+  for (a = L, b = M; b != 0; r = a % b, a = b, b = r);
+  L /= a;
+  M /= a;
+
+  /* allocate array for FIR coeff. and fill with coefficients */
+  if ((h0 = fill_resample_lp (L, M, passband, stopband, &lenh0)) == NULL)
+    return NULL;
+
+  /* Polyphase banks as for up-sampling by L, with gain L */
+  ptrFIR = fir_initialization ( /* Returns: pointer to SCD_FIR-struct */
+                                lenh0,  /* In: number of FIR-coefficients */
+                                h0,     /* In: pointer to array with FIR-cof. */
+                                (double) L,     /* In: gain factor for FIR-coeffic. */
+                                L,      /* In: Up-sampling factor */
+                                'U'     /* In: build L polyphase banks */
+    );
+  free (h0);
+
+  /* Switch the kernel to rational operation: down-sampling factor M */
+  if (ptrFIR != NULL) {
+    ptrFIR->hswitch = 'R';
+    ptrFIR->dwn_up = M;
+  }
+  return ptrFIR;
+}
+
+/* ...................... End of hq_resample_init() ...................... */
+
+
+/*
+  ============================================================================
+
+        static double fir_bessel_i0 (double x);
+        ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+        Description:
+        ~~~~~~~~~~~~
+
+        Modified Bessel function of the first kind, order 0, by its
+        power series (converges quickly for the arguments of a Kaiser
+        window).
+
+        History:
+        ~~~~~~~~
+        16.Oct.2026 v1.0 Created.
+
+ ============================================================================
+*/
+static double fir_bessel_i0 (double x) {
+  double sum = 1.0, term = 1.0, q = x * x / 4.0;
+  long k;
+
+  for (k = 1; term > 1e-12 * sum; k++) {
+    term *= q / ((double) k * k);
+    sum += term;
+  }
+  return sum;
+}
+
+/* ....................... End of fir_bessel_i0() ....................... */
+
+
+/*
+  ============================================================================
+
+        static float *fill_resample_lp (long L, long M, double passband,
+        ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~  double stopband, long *lenh0);
+
+        Description:
+        ~~~~~~~~~~~~
+
+        Design of the low-pass prototype at the rate L*fs: windowed sinc
+        with cut-off in the middle of the transition band, Kaiser window
+        for RSMP_ATT dB attenuation (Kaiser's formulas for beta and for
+        the length). The length is rounded up to a multiple of L so that
+        all polyphase banks have the same number of taps. The DC gain is
+        1 at the rate L*fs.
+
+        Parameters:
+        ~~~~~~~~~~~
+        L, M: ........ (In)  rate change factors (lowest terms)
+        passband: .... (In)  end of passband, relative to the lower Nyquist
+        stopband: .... (In)  start of stopband, idem
+        lenh0: ....... (Out) number of coefficients
+
+        Return value:
+        ~~~~~~~~~~~~~
+        Array with the coefficients (to be freed by the caller), or NULL.
+
+        History:
+        ~~~~~~~~
+        16.Oct.2026 v1.0 Created.
+
+ ============================================================================
+*/
+static float *fill_resample_lp (long L, long M, double passband, double stopband, long *lenh0) {
+  double nyq, fc, dw, beta, x, c, i0beta;
+  float *h0;
+  long N, k;
+
+  /* Lower Nyquist frequency, in cycles/sample at the rate L*fs */
+  nyq = 0.5 / (L > M ? L : M);
+  fc = 0.5 * (passband + stopband) * nyq;
+  dw = 2 * PI * (stopband - passband) * nyq;
+
+  /* Kaiser's estimates for the window parameter and the length */
+  beta = 0.1102 * (RSMP_ATT - 8.7);
+  N = (long) ceil ((RSMP_ATT - 8.0) / (2.285 * dw)) + 1;
+  N = (N + L - 1) / L * L;
+
+  if ((h0 = (float *) malloc (N * sizeof (float))) == NULL)
+    return NULL;
+
+  i0beta = fir_bessel_i0 (beta);
+  for (k = 0; k < N; k++) {
+    x = k - 0.5 * (N - 1);
+    c = (x == 0) ? 2 * fc : sin (2 * PI * fc * x) / (PI * x);
+    x = 2.0 * k / (N - 1) - 1.0;
+    h0[k] = (float) (c * fir_bessel_i0 (beta * sqrt (1.0 - x * x)) / i0beta);
+  }
+
+  *lenh0 = N;
+  return h0;
+}
+
+/* ...................... End of fill_resample_lp() ...................... */
+
+
+/* *************************** END OF FIR-RSMP.C *************************** */
@@ -0,0 +1,854 @@
+/*                                                            16.Oct.2026 v1.0
+  =============================================================================
+
+                          U    U   GGG    SSSS  TTTTT
+                          U    U  G       S       T
+                          U    U  G  GG   SSSS    T
+                          U    U  G   G       S   T
+                           UUU     GG     SSS     T
+
+                   ========================================
+                    ITU-T - USER'S GROUP ON SOFTWARE TOOLS
+                   ========================================
+
+       =============================================================
+       COPYRIGHT NOTE: This source code, and all of its derivations,
+       is subject to the "ITU-T General Public License". Please have
+       it  read  in    the  distribution  disk,   or  in  the  ITU-T
+       Recommendation G.191 on "SOFTWARE TOOLS FOR SPEECH AND  AUDIO
+       CODING STANDARDS".
+       =============================================================
+
+MODULE:         FIRFLT, HIGH QUALITY FIR UP/DOWN-SAMPLING FILTER
+                Sub-unit: Dot-product kernels (portable C, SSE2, AVX2 and
+                          AVX-512) and run-time instruction set selection
+
+DESCRIPTION:
+        This file contains the block kernels used by hq_kernel() to
+        compute the dot-products of the FIR filters, and the selection
+        of the kernel according to the filter mode (strict or fast) and
+        to the instruction set supported by the processor (CPUID).
+
+        The coefficient banks are stored reversed (oldest sample first)
+        and zero-padded at the front to a multiple of FIR_PAD taps, so
+        that a dot-product runs forward over both the coefficients and
+        the contiguous window of input samples.
+
+        HQ_STRICT: the samples are accumulated in the order of the
+                   original STL kernels (newest sample first), without
+                   fused multiply-add, hence the output is bit-exact with
+                   the reference files. The SIMD versions compute several
+                   consecutive output samples in parallel (one per lane),
+                   which is only possible without rate change or for
+                   up-sampling; for down-sampling the portable C kernel
+                   is used.
+        HQ_FAST:   every dot-product is split into several partial sums
+                   (one per lane, using FMA on AVX2 and AVX-512). The
+                   result differs from the strict one by float rounding
+                   only (relative error in the order of 1e-6 of the
+                   signal amplitude, i.e. well below one LSB of a 16-bit
+                   output sample).
+
+FUNCTIONS:
+  Global (have prototype in firflt.h)
+         = hq_mode(...)          : select strict/fast kernels and max.ISA
+
+  Local (Used by other sub-units of this module, should not be needed by
+         the user's program. Prototypes here and in the sub-units that use
+         it, but not in firflt.h)
+         = fir_block_filter(...) : compute the outputs for a block of
+                                   input positions with the selected kernel
+         = fir_block_filter_multi(...) : idem, for interleaved channels
+
+  Local (should be used only here -- prototypes only in this file)
+         = fir_cpu_isa(...)      : find highest instruction set supported
+         = fir_strict_c(...), fir_strict_sse2(...), fir_strict_avx2(...)
+         = fir_fast_c(...), fir_fast_sse2(...), fir_fast_avx2(...),
+           fir_fast_avx512(...)
+         = fir_multi_c(...), fir_multi_sse2(...), fir_multi_avx2(...)
+
+        Interleaved channels (hq_kernel_multi()): the samples of all
+        channels and of consecutive input positions are contiguous, so
+        that they go into the lanes of one vector, each lane summing in
+        the strict order. The output of every channel is bit-exact with
+        the strict filtering of that channel alone, in both modes.
+
+HISTORY:
+    16.Oct.2026 v1.0 Created.
+    16.Oct.2026 v1.1 Kernels for interleaved channels.
+
+  =============================================================================
+*/
+
+
+/*
+ * ......... INCLUDES .........
+ */
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "firflt.h"             /* Global definitions for FIR-FIR filter */
+
+/* Instruction-set specific code is only compiled for x86 processors; the target attribute allows to compile all versions in one unit, without changing the compiler options */
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define FIR_X86
+#define FIR_TARGET(isa) __attribute__ ((target (isa)))
+#include <immintrin.h>
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#define FIR_X86
+#define FIR_TARGET(isa)
+#include <intrin.h>
+#include <immintrin.h>
+#endif
+
+
+/*
+ * ......... Local function prototypes .........
+ */
+
+void fir_block_filter ARGS ((SCD_FIR * fir, float *W, long npos, long step, float *hb, long nb, long ys, float *y));
+static int fir_cpu_isa ARGS ((void));
+static void fir_strict_c ARGS ((SCD_FIR * fir, float *W, long npos, long step, float *hb, long nb, long ys, float *y));
+static void fir_fast_c ARGS ((SCD_FIR * fir, float *W, long npos, long step, float *hb, long nb, long ys, float *y));
+void fir_block_filter_multi ARGS ((SCD_FIR * fir, long nchan, float *W, long npos, long step, float *hb, long nb, long ys, float *y));
+static void fir_multi_c ARGS ((SCD_FIR * fir, long nchan, float *W, long e0, long e1, long step, float *hb, long nb, long ys, float *y));
+
+
+/*
+ * ...................... BEGIN OF FUNCTIONS .........................
+ */
+
+/*
+  ============================================================================
+
+        int hq_mode (SCD_FIR *fir_ptr, int mode, int max_isa);
+        ~~~~~~~~~~~
+
+        Description:
+        ~~~~~~~~~~~~
+
+        Select the kernel used by hq_kernel() for the given filter.
+        By default (i.e., after initialization) filters run in strict
+        mode with the best instruction set of the processor.
+
+        Parameters:
+        ~~~~~~~~~~~
+        fir_ptr: .. (InOut) pointer to struct SCD_FIR;
+        mode: ..... (In)    HQ_STRICT or HQ_FAST;
+        max_isa: .. (In)    highest instruction set that may be used:
+                            HQ_ISA_C, HQ_ISA_SSE2, HQ_ISA_AVX2,
+                            HQ_ISA_AVX512, or HQ_ISA_AUTO for no limit.
+
+        Return value:
+        ~~~~~~~~~~~~~
+        The instruction set actually selected.
+
+        History:
+        ~~~~~~~~
+        16.Oct.2026 v1.0 Created.
+
+ ============================================================================
+*/
+int hq_mode (SCD_FIR * fir_ptr, int mode, int max_isa) {
+  static int cpu_isa = -1;      /* cached result of CPUID */
+  int isa;
+
+  if (cpu_isa < 0)
+    cpu_isa = fir_cpu_isa ();
+
+  isa = (max_isa < 0 || max_isa > cpu_isa) ? cpu_isa : max_isa;
+
+  /* Strict mode has no AVX-512 version: FMA could not be avoided */
+  if (mode == HQ_STRICT && isa > HQ_ISA_AVX2)
+    isa = HQ_ISA_AVX2;
+
+  fir_ptr->mode = (char) mode;
+  fir_ptr->isa = (char) isa;
+  return isa;
+}
+
+/* .......................... End of hq_mode() .......................... */
+
+
+/*
+  ============================================================================
+
+        static int fir_cpu_isa (void);
+        ~~~~~~~~~~~~~~~~~~~~~~
+
+        Description:
+        ~~~~~~~~~~~~
+
+        Find the highest instruction set supported by the processor and
+        by the operating system (saving of the AVX registers).
+
+        Return value:
+        ~~~~~~~~~~~~~
+        HQ_ISA_C, HQ_ISA_SSE2, HQ_ISA_AVX2 (including FMA) or HQ_ISA_AVX512.
+
+        History:
+        ~~~~~~~~
+        16.Oct.2026 v1.0 Created.
+
+ ============================================================================
+*/
+static int fir_cpu_isa () {
+#if defined(FIR_X86) && defined(__GNUC__)
+  __builtin_cpu_init ();
+  if (__builtin_cpu_supports ("avx512f"))
+    return HQ_ISA_AVX512;
+  if (__builtin_cpu_supports ("avx2") && __builtin_cpu_supports ("fma"))
+    return HQ_ISA_AVX2;
+  if (__builtin_cpu_supports ("sse2"))
+    return HQ_ISA_SSE2;
+  return HQ_ISA_C;
+#elif defined(FIR_X86)
+  int r[4], isa = HQ_ISA_C;
+  unsigned long long xcr0;
+
+  __cpuid (r, 1);
+  if (r[3] & (1 << 26))         /* SSE2 */
+    isa = HQ_ISA_SSE2;
+  if ((r[2] & (1 << 27)) && (r[2] & (1 << 28)) && (r[2] & (1 << 12))) {
+    /* OSXSAVE, AVX and FMA: check that the OS saves the YMM/ZMM state */
+    xcr0 = _xgetbv (0);
+    __cpuidex (r, 7, 0);
+    if ((xcr0 & 0x06) == 0x06 && (r[1] & (1 << 5)))
+      isa = HQ_ISA_AVX2;
+    if ((xcr0 & 0xe6) == 0xe6 && (r[1] & (1 << 16)))
+      isa = HQ_ISA_AVX512;
+  }
+  return isa;
+#else
+  return HQ_ISA_C;
+#endif
+}
+
+/* ........................ End of fir_cpu_isa() ........................ */
+
+
+/*
+  ============================================================================
+
+        static void fir_strict_c (SCD_FIR *fir, float *W, long npos,
+        ~~~~~~~~~~~~~~~~~~~~~~~~  long step, float *y);
+
+        Description:
+        ~~~~~~~~~~~~
+
+        Portable strict kernel. Computes `nb' outputs (one per bank,
+        starting at bank `hb') for each of the `npos' input positions;
+        the window of input position i starts at W[i*step] and has
+        `lenpad' samples (the newest one last). Output sample p of
+        position i is stored in y[i*ys+p]. Four positions are computed together with
+        independent accumulators, each one summing newest sample first
+        (same order as the original STL kernels). The zeros used for
+        padding are skipped.
+
+        This is also the reference against which all the other kernels
+        are tested.
+
+        History:
+        ~~~~~~~~
+        16.Oct.2026 v1.0 Created (from fir_polyphase_kernel()).
+
+ ============================================================================
+*/
+static void fir_strict_c (SCD_FIR * fir, float *W, long npos, long step, float *hb, long nb, long ys, float *y) {
+  long lenpad = fir->lenpad;
+  long lo = fir->lenpad - fir->lenph;   /* first non-zero coefficient */
+  long i, p, j;
+  float *w, *hp, c;
+  float acc0, acc1, acc2, acc3;
+
+  for (i = 0; i + 3 < npos; i += 4, y += 4 * ys) {
+    w = W + i * step;
+    for (p = 0, hp = hb; p < nb; p++, hp += lenpad) {
+      c = hp[lenpad - 1];
+      acc0 = w[lenpad - 1] * c;
+      acc1 = w[step + lenpad - 1] * c;
+      acc2 = w[2 * step + lenpad - 1] * c;
+      acc3 = w[3 * step + lenpad - 1] * c;
+      for (j = lenpad - 2; j >= lo; j--) {
+        c = hp[j];
+        acc0 += w[j] * c;
+        acc1 += w[step + j] * c;
+        acc2 += w[2 * step + j] * c;
+        acc3 += w[3 * step + j] * c;
+      }
+      y[p] = acc0;
+      y[ys + p] = acc1;
+      y[2 * ys + p] = acc2;
+      y[3 * ys + p] = acc3;
+    }
+  }
+
+  /* Remaining positions, one at a time */
+  for (; i < npos; i++, y += ys) {
+    w = W + i * step;
+    for (p = 0, hp = hb; p < nb; p++, hp += lenpad) {
+      acc0 = w[lenpad - 1] * hp[lenpad - 1];
+      for (j = lenpad - 2; j >= lo; j--)
+        acc0 += w[j] * hp[j];
+      y[p] = acc0;
+    }
+  }
+}
+
+/* ....................... End of fir_strict_c() ....................... */
+
+
+/*
+  ============================================================================
+
+        static void fir_fast_c (SCD_FIR *fir, float *W, long npos,
+        ~~~~~~~~~~~~~~~~~~~~~~  long step, float *y);
+
+        Description:
+        ~~~~~~~~~~~~
+
+        Portable fast kernel: as fir_strict_c(), but each dot-product
+        is computed forward with eight partial sums, which compilers can
+        map onto SIMD registers (e.g. NEON) by themselves.
+
+        History:
+        ~~~~~~~~
+        16.Oct.2026 v1.0 Created.
+
+ ============================================================================
+*/
+static void fir_fast_c (SCD_FIR * fir, float *W, long npos, long step, float *hb, long nb, long ys, float *y) {
+  long lenpad = fir->lenpad;
+  long i, p, j, k;
+  float *w, *hp;
+  float s[8];
+
+  for (i = 0; i < npos; i++, y += ys) {
+    w = W + i * step;
+    for (p = 0, hp = hb; p < nb; p++, hp += lenpad) {
+      for (k = 0; k < 8; k++)
+        s[k] = 0;
+      for (j = 0; j < lenpad; j += 8)
+        for (k = 0; k < 8; k++)
+          s[k] += w[j + k] * hp[j + k];
+      y[p] = ((s[0] + s[4]) + (s[1] + s[5])) + ((s[2] + s[6]) + (s[3] + s[7]));
+    }
+  }
+}
+
+/* ........................ End of fir_fast_c() ........................ */
+
+
+/*
+  ============================================================================
+
+        static void fir_multi_c (SCD_FIR *fir, long nchan, float *W,
+        ~~~~~~~~~~~~~~~~~~~~~~~  long e0, long e1, long step, float *hb,
+                                 long nb, long ys, float *y);
+
+        Description:
+        ~~~~~~~~~~~~
+
+        Portable kernel for `nchan' interleaved channels. The pairs
+        (input position i, channel c) are numbered e=i*nchan+c and the
+        outputs of the pairs e0 <= e < e1 are computed. Sample k of the
+        window of pair e is W[(i*step+k)*nchan+c], output p of pair e is
+        stored in y[(i*ys+p)*nchan+c]. Each output is summed as in
+        fir_strict_c(), four pairs at a time.
+
+        History:
+        ~~~~~~~~
+        16.Oct.2026 v1.0 Created.
+
+ ============================================================================
+*/
+static void fir_multi_c (SCD_FIR * fir, long nchan, float *W, long e0, long e1, long step, float *hb, long nb, long ys, float *y) {
+  long lenpad = fir->lenpad;
+  long lo = fir->lenpad - fir->lenph;   /* first non-zero coefficient */
+  long e, k, p, j;
+  float *w[4], *hp, c, acc[4];
+  long yo[4];
+
+  for (e = e0; e < e1; e += 4) {
+    /* Windows and output offsets of (up to) four pairs */
+    for (k = 0; k < 4; k++) {
+      long ek = (e + k < e1) ? e + k : e;
+      w[k] = W + (ek / nchan) * step * nchan + ek % nchan;
+      yo[k] = (ek / nchan) * ys * nchan + ek % nchan;
+    }
+    for (p = 0, hp = hb; p < nb; p++, hp += lenpad) {
+      c = hp[lenpad - 1];
+      for (k = 0; k < 4; k++)
+        acc[k] = w[k][(lenpad - 1) * nchan] * c;
+      for (j = lenpad - 2; j >= lo; j--) {
+        c = hp[j];
+        for (k = 0; k < 4; k++)
+          acc[k] += w[k][j * nchan] * c;
+      }
+      for (k = 0; k < 4 && e + k < e1; k++)
+        y[yo[k] + p * nchan] = acc[k];
+    }
+  }
+}
+
+/* ........................ End of fir_multi_c() ........................ */
+
+
+#ifdef FIR_X86
+
+/*
+  ============================================================================
+
+        static void fir_strict_{sse2,avx2} (SCD_FIR *fir, float *W,
+        ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~  long npos, long step, float *y);
+
+        Description:
+        ~~~~~~~~~~~~
+
+        Strict kernels for step=1 (no rate change, or up-sampling):
+        consecutive input positions go into the 4 (SSE2) or 8 (AVX2)
+        lanes, and every lane accumulates in the same order and with the
+        same rounding as fir_strict_c(). Multiplication and addition are
+        kept separate (no FMA), hence the results are bit-exact. The
+        positions left over are handled by fir_strict_c().
+
+        History:
+        ~~~~~~~~
+        16.Oct.2026 v1.0 Created.
+
+ ============================================================================
+*/
+FIR_TARGET ("sse2")
+static void fir_strict_sse2 (SCD_FIR * fir, float *W, long npos, float *hb, long nb, long ys, float *y) {
+  long lenpad = fir->lenpad;
+  long lo = fir->lenpad - fir->lenph;
+  long i, p, j, k;
+  float *hp;
+  float tmp[4];
+  __m128 acc;
+
+  for (i = 0; i + 3 < npos; i += 4) {
+    for (p = 0, hp = hb; p < nb; p++, hp += lenpad) {
+      acc = _mm_mul_ps (_mm_loadu_ps (W + i + lenpad - 1), _mm_set1_ps (hp[lenpad - 1]));
+      for (j = lenpad - 2; j >= lo; j--)
+        acc = _mm_add_ps (acc, _mm_mul_ps (_mm_loadu_ps (W + i + j), _mm_set1_ps (hp[j])));
+      if (nb == 1 && ys == 1)
+        _mm_storeu_ps (y + i, acc);
+      else {
+        _mm_storeu_ps (tmp, acc);
+        for (k = 0; k < 4; k++)
+          y[(i + k) * ys + p] = tmp[k];
+      }
+    }
+  }
+  if (i < npos)
+    fir_strict_c (fir, W + i, npos - i, 1, hb, nb, ys, y + i * ys);
+}
+
+FIR_TARGET ("avx2")
+static void fir_strict_avx2 (SCD_FIR * fir, float *W, long npos, float *hb, long nb, long ys, float *y) {
+  long lenpad = fir->lenpad;
+  long lo = fir->lenpad - fir->lenph;
+  long i, p, j, k;
+  float *hp;
+  float tmp[8];
+  __m256 acc0, acc1;
+
+  /* Two vectors (16 positions) per pass to hide the latency of the additions */
+  for (i = 0; i + 15 < npos; i += 16) {
+    for (p = 0, hp = hb; p < nb; p++, hp += lenpad) {
+      __m256 c = _mm256_set1_ps (hp[lenpad - 1]);
+      acc0 = _mm256_mul_ps (_mm256_loadu_ps (W + i + lenpad - 1), c);
+      acc1 = _mm256_mul_ps (_mm256_loadu_ps (W + i + 8 + lenpad - 1), c);
+      for (j = lenpad - 2; j >= lo; j--) {
+        c = _mm256_set1_ps (hp[j]);
+        acc0 = _mm256_add_ps (acc0, _mm256_mul_ps (_mm256_loadu_ps (W + i + j), c));
+        acc1 = _mm256_add_ps (acc1, _mm256_mul_ps (_mm256_loadu_ps (W + i + 8 + j), c));
+      }
+      if (nb == 1 && ys == 1) {
+        _mm256_storeu_ps (y + i, acc0);
+        _mm256_storeu_ps (y + i + 8, acc1);
+      } else {
+        _mm256_storeu_ps (tmp, acc0);
+        for (k = 0; k < 8; k++)
+          y[(i + k) * ys + p] = tmp[k];
+        _mm256_storeu_ps (tmp, acc1);
+        for (k = 0; k < 8; k++)
+          y[(i + 8 + k) * ys + p] = tmp[k];
+      }
+    }
+  }
+  if (i < npos)
+    fir_strict_sse2 (fir, W + i, npos - i, hb, nb, ys, y + i * ys);
+}
+
+
+/*
+  ============================================================================
+
+        static void fir_multi_{sse2,avx2} (SCD_FIR *fir, long nchan,
+        ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~  float *W, long e0, long e1,
+                                           long step, float *hb, long nb,
+                                           long ys, float *y);
+
+        Description:
+        ~~~~~~~~~~~~
+
+        Kernels for interleaved channels: as fir_multi_c(), but the
+        windows of the pairs e0...e1-1 must be contiguous, i.e. start at
+        consecutive samples of W (true for all pairs if step=1, and for
+        the channels of one input position otherwise). Consecutive pairs
+        go into the 4 (SSE2) or 8 (AVX2) lanes; sample k of the windows
+        of a vector is a contiguous load at distance k*nchan. Same
+        rounding as fir_multi_c() (no FMA). Pairs left over are handled
+        by the narrower kernel.
+
+        History:
+        ~~~~~~~~
+        16.Oct.2026 v1.0 Created.
+
+ ============================================================================
+*/
+FIR_TARGET ("sse2")
+static void fir_multi_sse2 (SCD_FIR * fir, long nchan, float *W, long e0, long e1, long step, float *hb, long nb, long ys, float *y) {
+  long lenpad = fir->lenpad;
+  long lo = fir->lenpad - fir->lenph;
+  long e, k, p, j;
+  float *w, *hp;
+  float tmp[4];
+  __m128 acc;
+
+  w = W + (e0 / nchan) * step * nchan + e0 % nchan;
+  for (e = e0; e + 3 < e1; e += 4, w += 4) {
+    for (p = 0, hp = hb; p < nb; p++, hp += lenpad) {
+      acc = _mm_mul_ps (_mm_loadu_ps (w + (lenpad - 1) * nchan), _mm_set1_ps (hp[lenpad - 1]));
+      for (j = lenpad - 2; j >= lo; j--)
+        acc = _mm_add_ps (acc, _mm_mul_ps (_mm_loadu_ps (w + j * nchan), _mm_set1_ps (hp[j])));
+      if (nb == 1 && ys == 1)
+        _mm_storeu_ps (y + e, acc);
+      else {
+        _mm_storeu_ps (tmp, acc);
+        for (k = 0; k < 4; k++)
+          y[((e + k) / nchan * ys + p) * nchan + (e + k) % nchan] = tmp[k];
+      }
+    }
+  }
+  if (e < e1)
+    fir_multi_c (fir, nchan, W, e, e1, step, hb, nb, ys, y);
+}
+
+FIR_TARGET ("avx2")
+static void fir_multi_avx2 (SCD_FIR * fir, long nchan, float *W, long e0, long e1, long step, float *hb, long nb, long ys, float *y) {
+  long lenpad = fir->lenpad;
+  long lo = fir->lenpad - fir->lenph;
+  long e, k, p, j;
+  float *w, *hp;
+  float tmp[16];
+  __m256 c, acc0, acc1;
+
+  /* Two vectors (16 pairs) per pass to hide the latency of the additions */
+  w = W + (e0 / nchan) * step * nchan + e0 % nchan;
+  for (e = e0; e + 15 < e1; e += 16, w += 16) {
+    for (p = 0, hp = hb; p < nb; p++, hp += lenpad) {
+      c = _mm256_set1_ps (hp[lenpad - 1]);
+      acc0 = _mm256_mul_ps (_mm256_loadu_ps (w + (lenpad - 1) * nchan), c);
+      acc1 = _mm256_mul_ps (_mm256_loadu_ps (w + (lenpad - 1) * nchan + 8), c);
+      for (j = lenpad - 2; j >= lo; j--) {
+        c = _mm256_set1_ps (hp[j]);
+        acc0 = _mm256_add_ps (acc0, _mm256_mul_ps (_mm256_loadu_ps (w + j * nchan), c));
+        acc1 = _mm256_add_ps (acc1, _mm256_mul_ps (_mm256_loadu_ps (w + j * nchan + 8), c));
+      }
+      if (nb == 1 && ys == 1) {
+        _mm256_storeu_ps (y + e, acc0);
+        _mm256_storeu_ps (y + e + 8, acc1);
+      } else {
+        _mm256_storeu_ps (tmp, acc0);
+        _mm256_storeu_ps (tmp + 8, acc1);
+        for (k = 0; k < 16; k++)
+          y[((e + k) / nchan * ys + p) * nchan + (e + k) % nchan] = tmp[k];
+      }
+    }
+  }
+  if (e < e1)
+    fir_multi_sse2 (fir, nchan, W, e, e1, step, hb, nb, ys, y);
+}
+
+
+/*
+  ============================================================================
+
+        static void fir_fast_{sse2,avx2,avx512} (SCD_FIR *fir, float *W,
+        ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~  long npos, long step,
+                                                 float *y);
+
+        Description:
+        ~~~~~~~~~~~~
+
+        Fast kernels: every dot-product runs forward over the (aligned)
+        coefficients and the window, with one vector of partial sums.
+        Four positions are computed together so that the four chains of
+        additions overlap and every coefficient vector is loaded once.
+        AVX2 and AVX-512 use fused multiply-add.
+
+        History:
+        ~~~~~~~~
+        16.Oct.2026 v1.0 Created.
+
+ ============================================================================
+*/
+FIR_TARGET ("sse2")
+static float fir_hsum_sse2 (__m128 v) {
+  v = _mm_add_ps (v, _mm_movehl_ps (v, v));
+  v = _mm_add_ss (v, _mm_shuffle_ps (v, v, 1));
+  return _mm_cvtss_f32 (v);
+}
+
+FIR_TARGET ("sse2")
+static void fir_fast_sse2 (SCD_FIR * fir, float *W, long npos, long step, float *hb, long nb, long ys, float *y) {
+  long lenpad = fir->lenpad;
+  long i, p, j;
+  float *w, *hp;
+  __m128 c, a0, a1, a2, a3;
+
+  for (i = 0; i + 3 < npos; i += 4, y += 4 * ys) {
+    w = W + i * step;
+    for (p = 0, hp = hb; p < nb; p++, hp += lenpad) {
+      a0 = a1 = a2 = a3 = _mm_setzero_ps ();
+      for (j = 0; j < lenpad; j += 4) {
+        c = _mm_load_ps (hp + j);
+        a0 = _mm_add_ps (a0, _mm_mul_ps (_mm_loadu_ps (w + j), c));
+        a1 = _mm_add_ps (a1, _mm_mul_ps (_mm_loadu_ps (w + step + j), c));
+        a2 = _mm_add_ps (a2, _mm_mul_ps (_mm_loadu_ps (w + 2 * step + j), c));
+        a3 = _mm_add_ps (a3, _mm_mul_ps (_mm_loadu_ps (w + 3 * step + j), c));
+      }
+      y[p] = fir_hsum_sse2 (a0);
+      y[ys + p] = fir_hsum_sse2 (a1);
+      y[2 * ys + p] = fir_hsum_sse2 (a2);
+      y[3 * ys + p] = fir_hsum_sse2 (a3);
+    }
+  }
+  for (; i < npos; i++, y += ys) {
+    w = W + i * step;
+    for (p = 0, hp = hb; p < nb; p++, hp += lenpad) {
+      a0 = a1 = _mm_setzero_ps ();
+      for (j = 0; j < lenpad; j += 8) {
+        a0 = _mm_add_ps (a0, _mm_mul_ps (_mm_loadu_ps (w + j), _mm_load_ps (hp + j)));
+        a1 = _mm_add_ps (a1, _mm_mul_ps (_mm_loadu_ps (w + j + 4), _mm_load_ps (hp + j + 4)));
+      }
+      y[p] = fir_hsum_sse2 (_mm_add_ps (a0, a1));
+    }
+  }
+}
+
+FIR_TARGET ("avx2,fma")
+static float fir_hsum_avx2 (__m256 v) {
+  __m128 s = _mm_add_ps (_mm256_castps256_ps128 (v), _mm256_extractf128_ps (v, 1));
+  s = _mm_add_ps (s, _mm_movehl_ps (s, s));
+  s = _mm_add_ss (s, _mm_shuffle_ps (s, s, 1));
+  return _mm_cvtss_f32 (s);
+}
+
+FIR_TARGET ("avx2,fma")
+static void fir_fast_avx2 (SCD_FIR * fir, float *W, long npos, long step, float *hb, long nb, long ys, float *y) {
+  long lenpad = fir->lenpad;
+  long i, p, j;
+  float *w, *hp;
+  __m256 c, a0, a1, a2, a3;
+
+  for (i = 0; i + 3 < npos; i += 4, y += 4 * ys) {
+    w = W + i * step;
+    for (p = 0, hp = hb; p < nb; p++, hp += lenpad) {
+      a0 = a1 = a2 = a3 = _mm256_setzero_ps ();
+      for (j = 0; j < lenpad; j += 8) {
+        c = _mm256_load_ps (hp + j);
+        a0 = _mm256_fmadd_ps (_mm256_loadu_ps (w + j), c, a0);
+        a1 = _mm256_fmadd_ps (_mm256_loadu_ps (w + step + j), c, a1);
+        a2 = _mm256_fmadd_ps (_mm256_loadu_ps (w + 2 * step + j), c, a2);
+        a3 = _mm256_fmadd_ps (_mm256_loadu_ps (w + 3 * step + j), c, a3);
+      }
+      y[p] = fir_hsum_avx2 (a0);
+      y[ys + p] = fir_hsum_avx2 (a1);
+      y[2 * ys + p] = fir_hsum_avx2 (a2);
+      y[3 * ys + p] = fir_hsum_avx2 (a3);
+    }
+  }
+  for (; i < npos; i++, y += ys) {
+    w = W + i * step;
+    for (p = 0, hp = hb; p < nb; p++, hp += lenpad) {
+      a0 = a1 = _mm256_setzero_ps ();
+      for (j = 0; j < lenpad; j += 16) {
+        a0 = _mm256_fmadd_ps (_mm256_loadu_ps (w + j), _mm256_load_ps (hp + j), a0);
+        a1 = _mm256_fmadd_ps (_mm256_loadu_ps (w + j + 8), _mm256_load_ps (hp + j + 8), a1);
+      }
+      y[p] = fir_hsum_avx2 (_mm256_add_ps (a0, a1));
+    }
+  }
+}
+
+FIR_TARGET ("avx512f")
+static float fir_hsum_avx512 (__m512 v) {
+  __m256 h = _mm256_add_ps (_mm512_castps512_ps256 (v), _mm256_castpd_ps (_mm512_extractf64x4_pd (_mm512_castps_pd (v), 1)));
+  __m128 s = _mm_add_ps (_mm256_castps256_ps128 (h), _mm256_extractf128_ps (h, 1));
+  s = _mm_add_ps (s, _mm_movehl_ps (s, s));
+  s = _mm_add_ss (s, _mm_shuffle_ps (s, s, 1));
+  return _mm_cvtss_f32 (s);
+}
+
+FIR_TARGET ("avx512f")
+static void fir_fast_avx512 (SCD_FIR * fir, float *W, long npos, long step, float *hb, long nb, long ys, float *y) {
+  long lenpad = fir->lenpad;
+  long i, p, j;
+  float *w, *hp;
+  __m512 c, a0, a1, a2, a3;
+
+  for (i = 0; i + 3 < npos; i += 4, y += 4 * ys) {
+    w = W + i * step;
+    for (p = 0, hp = hb; p < nb; p++, hp += lenpad) {
+      a0 = a1 = a2 = a3 = _mm512_setzero_ps ();
+      for (j = 0; j < lenpad; j += 16) {
+        c = _mm512_load_ps (hp + j);
+        a0 = _mm512_fmadd_ps (_mm512_loadu_ps (w + j), c, a0);
+        a1 = _mm512_fmadd_ps (_mm512_loadu_ps (w + step + j), c, a1);
+        a2 = _mm512_fmadd_ps (_mm512_loadu_ps (w + 2 * step + j), c, a2);
+        a3 = _mm512_fmadd_ps (_mm512_loadu_ps (w + 3 * step + j), c, a3);
+      }
+      y[p] = fir_hsum_avx512 (a0);
+      y[ys + p] = fir_hsum_avx512 (a1);
+      y[2 * ys + p] = fir_hsum_avx512 (a2);
+      y[3 * ys + p] = fir_hsum_avx512 (a3);
+    }
+  }
+  for (; i < npos; i++, y += ys) {
+    w = W + i * step;
+    for (p = 0, hp = hb; p < nb; p++, hp += lenpad) {
+      a0 = _mm512_setzero_ps ();
+      for (j = 0; j < lenpad; j += 16)
+        a0 = _mm512_fmadd_ps (_mm512_loadu_ps (w + j), _mm512_load_ps (hp + j), a0);
+      y[p] = fir_hsum_avx512 (a0);
+    }
+  }
+}
+
+#endif /* FIR_X86 */
+
+
+/*
+  ============================================================================
+
+        void fir_block_filter (SCD_FIR *fir, float *W, long npos,
+        ~~~~~~~~~~~~~~~~~~~~~  long step, float *y);
+
+        Description:
+        ~~~~~~~~~~~~
+
+        Compute the `nb' output samples of each of `npos' input
+        positions with the kernel selected by hq_mode(). The window of
+        position i is W[i*step ... i*step+lenpad-1], newest sample last,
+        and output p of position i is y[i*ys+p].
+
+        Parameters:
+        ~~~~~~~~~~~
+        fir: ...... (In)  pointer to FIR-struct
+        W: ........ (In)  window of the first position
+        npos: ..... (In)  number of input positions
+        step: ..... (In)  distance between input positions
+        hb: ....... (In)  first coefficient bank to use
+        nb: ....... (In)  number of consecutive banks to use
+        ys: ....... (In)  distance between outputs of consecutive positions
+        y: ........ (Out) output samples
+
+        Return value:
+        ~~~~~~~~~~~~~
+        None.
+
+        History:
+        ~~~~~~~~
+        16.Oct.2026 v1.0 Created.
+
+ ============================================================================
+*/
+void fir_block_filter (SCD_FIR * fir, float *W, long npos, long step, float *hb, long nb, long ys, float *y) {
+  if (fir->mode == HQ_STRICT) {
+#ifdef FIR_X86
+    if (step == 1 && fir->isa >= HQ_ISA_AVX2) {
+      fir_strict_avx2 (fir, W, npos, hb, nb, ys, y);
+      return;
+    }
+    if (step == 1 && fir->isa == HQ_ISA_SSE2) {
+      fir_strict_sse2 (fir, W, npos, hb, nb, ys, y);
+      return;
+    }
+#endif
+    fir_strict_c (fir, W, npos, step, hb, nb, ys, y);
+    return;
+  }
+
+  switch (fir->isa) {
+#ifdef FIR_X86
+  case HQ_ISA_AVX512:
+    fir_fast_avx512 (fir, W, npos, step, hb, nb, ys, y);
+    break;
+  case HQ_ISA_AVX2:
+    fir_fast_avx2 (fir, W, npos, step, hb, nb, ys, y);
+    break;
+  case HQ_ISA_SSE2:
+    fir_fast_sse2 (fir, W, npos, step, hb, nb, ys, y);
+    break;
+#endif
+  default:
+    fir_fast_c (fir, W, npos, step, hb, nb, ys, y);
+  }
+}
+
+/* ...................... End of fir_block_filter() ...................... */
+
+
+/*
+  ============================================================================
+
+        void fir_block_filter_multi (SCD_FIR *fir, long nchan, float *W,
+        ~~~~~~~~~~~~~~~~~~~~~~~~~~~  long npos, long step, float *hb,
+                                     long nb, long ys, float *y);
+
+        Description:
+        ~~~~~~~~~~~~
+
+        As fir_block_filter(), for `nchan' interleaved channels: the
+        window of position i, channel c is W[(i*step+k)*nchan+c],
+        k=0...lenpad-1, and output p of position i, channel c is
+        y[(i*ys+p)*nchan+c]. For step=1 all the windows are contiguous
+        and are processed as one run of npos*nchan lanes; otherwise
+        there is one run of nchan lanes per input position.
+
+        The lanes always sum in the strict order (see file header).
+
+        History:
+        ~~~~~~~~
+        16.Oct.2026 v1.0 Created.
+
+ ============================================================================
+*/
+void fir_block_filter_multi (SCD_FIR * fir, long nchan, float *W, long npos, long step, float *hb, long nb, long ys, float *y) {
+  long nrun = (step == 1) ? 1 : npos;   /* runs of contiguous windows */
+  long lrun = (step == 1) ? npos * nchan : nchan;
+  long r;
+
+  for (r = 0; r < nrun; r++) {
+#ifdef FIR_X86
+    if (fir->isa >= HQ_ISA_AVX2) {
+      fir_multi_avx2 (fir, nchan, W, r * lrun, (r + 1) * lrun, step, hb, nb, ys, y);
+      continue;
+    }
+    if (fir->isa == HQ_ISA_SSE2) {
+      fir_multi_sse2 (fir, nchan, W, r * lrun, (r + 1) * lrun, step, hb, nb, ys, y);
+      continue;
+    }
+#endif
+    fir_multi_c (fir, nchan, W, r * lrun, (r + 1) * lrun, step, hb, nb, ys, y);
+  }
+}
+
+/* ................... End of fir_block_filter_multi() ................... */
+
+
+/* **************************** END OF FIR-SIMD.C ************************** */
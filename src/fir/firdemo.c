@@ -1,4 +1,4 @@
-/*                                                            02.Feb.2010 v2.5
+/*                                                            16.Oct.2026 v2.6
   ============================================================================
 
         FIRDEMO.C
@@ -76,6 +76,9 @@
                   "regular" one (if IRS was selected).
         -ht ..... uses the half-tilt IRS (if IRS was selected)
         -lseg ... changes the segment (block) length (default:LSEG0=256)
+        -fuse ... fuses adjacent up- and down-sampling stages into one
+                  rational filter (see fir-chain.c); the output is then
+                  not bit-exact with the separate stages
         -q ...... quiet processing (no progress flag)
 
 
@@ -193,6 +196,8 @@
         06.Jul.99 v2.3 Inserted conditional compilation for CYGWIN and
                        MS Visual C compiler.
         02.Feb.10 v2.5 Modified maximum filename length (y.hiwasaki)
+        16.Oct.26 v2.6 Stages run as a FIR_CHAIN, tile by tile, with one
+                       pair of work buffers; added option -fuse.
   ============================================================================
 */
 
@@ -280,6 +285,7 @@ void display_usage () {
   printf ("  -ht ........ uses the half-tilt for 16 kHz IRS, if IRS filtering is selected\n");
   printf ("  -q ......... quiet processing (no progress flag)\n");
   printf ("  -lseg ...... changes the segment (block) length (default:%d)\n", LSEG0);
+  printf ("  -fuse ...... fuses adjacent up- and down-sampling stages (not bit-exact)\n");
 
   /* Quit program */
   exit (-128);
@@ -311,23 +317,21 @@ int main (int argc, char *argv[]) {
   SCD_FIR *down1_ptr;
   SCD_FIR *down2_ptr;
 
+  /* ......... Chain of the selected filters ......... */
+  SCD_FIR *stage[6];            /* selected filters, in order */
+  int istage[6];                /* filter number (0=IRS ... 5=down2) of each stage */
+  int nstage = 0, fuse = 0;
+  FIR_CHAIN *chain;
+
   /* ......... signal arrays ......... */
 #ifdef STATIC_ALLOCATION
-  short sh_buff[9 * LSEGMAX];   /* 16-bit buffer */
+  short sh_buff[9 * LSEGMAX + 6];       /* 16-bit buffer */
   float fl_buff[LSEGMAX];       /* float buffer */
-  float irs_buff[LSEGMAX];      /* output of irs filter */
-  float up1_buff[3 * LSEGMAX];  /* output of first upsampling buffer */
-  float up2_buff[9 * LSEGMAX];  /* output of second upsampling buffer */
-  float down1_buff[9 * LSEGMAX];        /* output of first downsampling buf. */
-  float down2_buff[9 * LSEGMAX];        /* output of second downsampling buf. */
+  float out_buff[9 * LSEGMAX + 6];      /* output of the last filter */
 #else
   short *sh_buff;               /* 16-bit buffer */
   float *fl_buff;               /* float buffer */
-  float *irs_buff;              /* output of irs filter */
-  float *up1_buff;              /* output of first upsampling buffer */
-  float *up2_buff;              /* output of second upsampling buffer */
-  float *down1_buff;            /* output of first downsampling buf. */
-  float *down2_buff;            /* output of second downsampling buf. */
+  float *out_buff;              /* output of the last filter */
 #endif
 
   /* ......... File related variables ......... */
@@ -344,12 +348,10 @@ int main (int argc, char *argv[]) {
   long delta_sm;
   long up_1, up_2;
   long down_1, down_2;
-  long lsegdown1, lsegdown2;
-  long lsegup1, lsegup2;
-  long lsegx, lsegirs, lseg = LSEG0;
-  static long noverflows0 = 0, noverflows1 = 0, noverflows2 = 0, noverflows3 = 0, noverflows4 = 0, noverflows5 = 0;
+  long lsegx, lsegout, lseg = LSEG0;
+  static long noverflows[6];    /* per filter, and for the final conversion */
   long nsam = 0;
-  long k;
+  int k;
   int quiet = 0, modified_irs = 0, half_tilt = 0;
 
 
@@ -357,7 +359,7 @@ int main (int argc, char *argv[]) {
   * ......... PRINT INFOS .........
   */
 
-  printf ("%s%s", "*** v2.5 FIR-Up/Down-Sampling ", "and IRS Send Part Filter -  02.Feb.2010 ***\n");
+  printf ("%s%s", "*** v2.6 FIR-Up/Down-Sampling ", "and IRS Send Part Filter -  16.Oct.2026 ***\n");
 
 /*
  * ......... PARAMETERS FOR PROCESSING .........
@@ -398,6 +400,13 @@ int main (int argc, char *argv[]) {
         /* Move argv over the option to the next argument */
         argv += 2;
         argc -= 2;
+      } else if (strcmp (argv[1], "-fuse") == 0) {
+        /* Fuse adjacent up- and down-sampling stages */
+        fuse = 1;
+
+        /* Move argv over the option to the next argument */
+        argv++;
+        argc--;
       } else if (strcmp (argv[1], "-?") == 0 || strcmp (argv[1], "-help") == 0) {
         /* Print help */
         display_usage ();
@@ -457,16 +466,15 @@ int main (int argc, char *argv[]) {
 /*
    * ... Allocate memory ...
    */
-  sh_buff = (short *) calloc (9l * lseg, sizeof (short));
+#ifndef STATIC_ALLOCATION
+  /* Output: up-sampling by 9 at most, plus one sample per stage when down-sampling */
+  sh_buff = (short *) calloc (9l * lseg + 6, sizeof (short));
   fl_buff = (float *) calloc (lseg, sizeof (float));
-  irs_buff = (float *) calloc (lseg, sizeof (float));
-  up1_buff = (float *) calloc (3l * lseg, sizeof (float));
-  up2_buff = (float *) calloc (9l * lseg, sizeof (float));
-  down1_buff = (float *) calloc (9l * lseg, sizeof (float));
-  down2_buff = (float *) calloc (9l * lseg, sizeof (float));
+  out_buff = (float *) calloc (9l * lseg + 6, sizeof (float));
 
-  if (!(sh_buff && fl_buff && irs_buff && up1_buff && up2_buff && down1_buff && down2_buff))
+  if (!(sh_buff && fl_buff && out_buff))
     error_terminate ("Error allocating memory for sample buffers\n", 3);
+#endif
 
 /*
    * ... Initialize selected FIR-structures for up-/downsampling ...
@@ -593,6 +601,41 @@ int main (int argc, char *argv[]) {
     down2_ptr = NULL;
 
 
+/*
+   * ... Chain of the selected filters, in order of processing ...
+   */
+  if (irs_ptr != NULL) {
+    stage[nstage] = irs_ptr;
+    istage[nstage++] = 0;
+  }
+  if (delta_sm_ptr != NULL) {
+    stage[nstage] = delta_sm_ptr;
+    istage[nstage++] = 1;
+  }
+  if (up1_ptr != NULL) {
+    stage[nstage] = up1_ptr;
+    istage[nstage++] = 2;
+  }
+  if (up2_ptr != NULL) {
+    stage[nstage] = up2_ptr;
+    istage[nstage++] = 3;
+  }
+  if (down1_ptr != NULL) {
+    stage[nstage] = down1_ptr;
+    istage[nstage++] = 4;
+  }
+  if (down2_ptr != NULL) {
+    stage[nstage] = down2_ptr;
+    istage[nstage++] = 5;
+  }
+
+  /* The chain owns the filters from now on */
+  if ((chain = hq_chain_init (nstage, stage, 0, fuse)) == NULL)
+    error_terminate ("FIR chain initialization failure!\n", 1);
+  if (fuse && chain->nstage < nstage)
+    fprintf (stderr, "Fused %d filters into %d\n", nstage, chain->nstage);
+
+
 /*
    * ... Print some infos ...
    */
@@ -618,135 +661,33 @@ int main (int argc, char *argv[]) {
     /* ... and convert short to float, normalizing */
     sh2fl_16bit (lsegx, sh_buff, fl_buff, 1);
 
-    /* 1ST STAGE: which kind of IRS filtering? (0=none / 8=8kHz / 16=16kHz) */
-    if (irs == 0) {
-      /* copy input buffer to 1st stage output (irs buffer) */
-      for (k = 0; k <= lsegx - 1; k++)
-        irs_buff[k] = fl_buff[k];
-      lsegirs = lsegx;          /* Returned: number of output samples */
-    } else {
-      /* Filter using the IRS coeffs. initialized before (8 or 16 kHz) */
-      lsegirs =                 /* Returned: number of output samples */
-        hq_kernel (             /* IRS send part filter */
-                    lsegx,      /* In : number of input samples */
-                    fl_buff,    /* In : array with input samples */
-                    irs_ptr,    /* InOut: pointer to FIR struct */
-                    irs_buff    /* Out : array with output samples */
-        );
-
-      /* Convert to integer for testing overflows -- do not save! */
-      noverflows0 += fl2sh_16bit (lsegirs, irs_buff, sh_buff, (int) 1);
-    }
-
-    /* INTERMEDIATE STAGE: Apply Delta-SM? (0=no / 1=yes) */
-    if (delta_sm) {
-      /* Copy IRS-processed buffer back onto the original data buffer */
-      for (k = 0; k < lsegirs; k++)
-        fl_buff[k] = irs_buff[k];
-
-      /* Apply filtering */
-      lsegirs =                 /* Returned: number of output samples */
-        hq_kernel (             /* IRS send part filter */
-                    lsegx,      /* In : number of input samples */
-                    fl_buff,    /* In : array with input samples */
-                    delta_sm_ptr,       /* InOut: pointer to FIR struct */
-                    irs_buff    /* Out : array with output samples */
-        );
-
-      /* Convert to integer for testing overflows -- do not save! */
-      noverflows1 += fl2sh_16bit (lsegirs, irs_buff, sh_buff, (int) 1);
-    }
-
-
-    /* 2ND STAGE: First upsampling filter (0=none / +-2=1:2 / 3=1:3) */
-    if (up_1 == 0) {
-      /* copy irs buffer to 2nd stage output (up-sample buffer 1) */
-      for (k = 0; k <= lsegirs - 1; k++)
-        up1_buff[k] = irs_buff[k];
-      lsegup1 = lsegirs;        /* Returned: number of output samples */
-    } else {
-      lsegup1 =                 /* Returned: number of output samples */
-        hq_kernel (             /* (up-sampling filter) */
-                    lsegirs,    /* In : number of input samples */
-                    irs_buff,   /* In : array with input samples */
-                    up1_ptr,    /* InOut: pointer to FIR struct */
-                    up1_buff    /* Out : array with output samples */
-        );
-
-      /* Convert to integer for testing overflows -- do not save! */
-      noverflows2 += fl2sh_16bit (lsegup1, up1_buff, sh_buff, (int) 1);
-    }
-
-
-    /* THIRD STAGE: Second upsampling filter: (0=none / +-2=1:2 / 3=1:3) */
-    if (up_2 == 0) {
-      /* copy buffer up-sample buf.1 to 3rd stage output (up-sample buf.2) */
-      for (k = 0; k <= lsegup1 - 1; k++)
-        up2_buff[k] = up1_buff[k];
-      lsegup2 = lsegup1;        /* Returned: number of output samples */
-    } else {
-      lsegup2 =                 /* Returned: number of output samples */
-        hq_kernel (             /* (up-sampling filter) */
-                    lsegup1,    /* In : number of input samples */
-                    up1_buff,   /* In : array with input samples */
-                    up2_ptr,    /* InOut: pointer to FIR struct */
-                    up2_buff    /* Out : array with output samples */
-        );
-
-      /* Convert to integer for testing overflows -- do not save! */
-      noverflows3 += fl2sh_16bit (lsegup2, up2_buff, sh_buff, (int) 1);
-    }
-
-
-    /* FOURTH STAGE: First downsampling filter: (0=none / +-2=2:1 / 3=3:1) */
-    if (down_1 == 0) {
-      /* copy buffer up-sample buf.2 to 4th stage output (down-sample buf.1) */
-      for (k = 0; k <= lsegup2 - 1; k++)
-        down1_buff[k] = up2_buff[k];
-      lsegdown1 = lsegup2;      /* Returned: number of output samples */
-    } else {
-      lsegdown1 =               /* Returned: number of output samples */
-        hq_kernel (             /* (down-sampling filter) */
-                    lsegup2,    /* In : number of input samples */
-                    up2_buff,   /* In : array with input samples */
-                    down1_ptr,  /* InOut: pointer to FIR struct */
-                    down1_buff  /* Out : array with output samples */
-        );
-
-      /* Convert to integer for testing overflows -- do not save! */
-      noverflows4 += fl2sh_16bit (lsegdown1, down1_buff, sh_buff, (int) 1);
-    }
-
-
-    /* FIFTH STAGE: Second downsampling filter: (0=none / +-2=2:1 / 3=3:1) */
-    if (down_2 == 0) {
-      /* copy buffer down-sample buf.1 to 5th stage output (down-sample buf.2) */
-      for (k = 0; k <= lsegdown1 - 1; k++)
-        down2_buff[k] = down1_buff[k];
-      lsegdown2 = lsegdown1;    /* Returned: number of output samples */
-    } else {
-      lsegdown2 =               /* Returned: number of output samples */
-        hq_kernel (             /* (down-sampling filter) */
-                    lsegdown1,  /* In : number of input samples */
-                    down1_buff, /* In : array with input samples */
-                    down2_ptr,  /* InOut: pointer to FIR struct */
-                    down2_buff  /* Out : array with output samples */
-        );
-    }
+    /* ALL STAGES: IRS, Delta-SM, up-sampling 1 and 2, down-sampling 1 and 2 (skipped stages are not in the chain) */
+    lsegout =                   /* Returned: number of output samples */
+      hq_chain_kernel (         /* cascade of the filters */
+                        lsegx,  /* In : number of input samples */
+                        fl_buff,        /* In : array with input samples */
+                        chain,  /* InOut: pointer to FIR chain */
+                        out_buff        /* Out : array with output samples */
+      );
 
 
 /*
   * ......... CONVERTION FROM FLOAT TO SHORT with rounding .........
   *                      (now saves the data!)
   */
-    noverflows5 += fl2sh_16bit (lsegdown2, down2_buff, sh_buff, (int) 1);
+    noverflows[5] += fl2sh_16bit (lsegout, out_buff, sh_buff, (int) 1);
 
 /*
   * ......... WRITE SAMPLES TO OUTPUT FILE .........
   */
-    nsam += fwrite (sh_buff, sizeof (short), lsegdown2, outfilptr);
+    nsam += fwrite (sh_buff, sizeof (short), lsegout, outfilptr);
   }
 
+  /* Overflows of the intermediate stages (the last down-sampling filter is counted by the final conversion) */
+  for (k = 0; k < nstage; k++)
+    if (istage[k] < 5)
+      noverflows[istage[k]] = chain->nclip[k];
+
 
 /*
    * ......... FINALIZATIONS .........
@@ -757,37 +698,26 @@ int main (int argc, char *argv[]) {
   printf ("\nDONE: %f sec CPU-time for %ld generated samples\n", (t2 - t1) / (double) CLOCKS_PER_SEC, nsam);
 
   /* Print overflow statistics */
-  if (noverflows0 == 0 && noverflows1 == 0 && noverflows2 == 0 && noverflows3 == 0 && noverflows4 == 0 && noverflows5 == 0)
+  if (noverflows[0] == 0 && noverflows[1] == 0 && noverflows[2] == 0 && noverflows[3] == 0 && noverflows[4] == 0 && noverflows[5] == 0)
     printf ("      no overflows occurred\n");
   else {
-    printf ("\tOverflows  - IRS filter ................: %ld\n", noverflows0);
-    printf ("\t           - Delta-SM filter ...........: %ld\n", noverflows1);
-    printf ("\t           - up-sampling filter 1 ......: %ld\n", noverflows2);
-    printf ("\t           - up-sampling filter 2 ......: %ld\n", noverflows3);
-    printf ("\t           - down-sampling filter 1 ....: %ld\n", noverflows4);
-    printf ("\t           - down-sampling filter 2 ....: %ld\n", noverflows5);
+    printf ("\tOverflows  - IRS filter ................: %ld\n", noverflows[0]);
+    printf ("\t           - Delta-SM filter ...........: %ld\n", noverflows[1]);
+    printf ("\t           - up-sampling filter 1 ......: %ld\n", noverflows[2]);
+    printf ("\t           - up-sampling filter 2 ......: %ld\n", noverflows[3]);
+    printf ("\t           - down-sampling filter 1 ....: %ld\n", noverflows[4]);
+    printf ("\t           - down-sampling filter 2 ....: %ld\n", noverflows[5]);
   }
 
-  /* Release allocated FIR structures */
-  if (down2_ptr != (SCD_FIR *) NULL)
-    hq_free (down2_ptr);
-  if (down1_ptr != (SCD_FIR *) NULL)
-    hq_free (down1_ptr);
-  if (up2_ptr != (SCD_FIR *) NULL)
-    hq_free (up2_ptr);
-  if (up1_ptr != (SCD_FIR *) NULL)
-    hq_free (up1_ptr);
-  if (irs_ptr != (SCD_FIR *) NULL)
-    hq_free (irs_ptr);
+  /* Release the chain and its FIR structures */
+  hq_chain_free (chain);
 
+#ifndef STATIC_ALLOCATION
   /* Release memory */
-  free (down2_buff);
-  free (down1_buff);
-  free (up2_buff);
-  free (up1_buff);
-  free (irs_buff);
+  free (out_buff);
   free (fl_buff);
   free (sh_buff);
+#endif
 
   /* Close files */
   fclose (outfilptr);
@@ -1,6 +1,6 @@
 /*
   ============================================================================
-   File: FIRFLT.H                                           v.2.5 -  31.Dec.2008
+   File: FIRFLT.H                                           v.3.4 -  16.Oct.2026
   ============================================================================
 
 	    ITU-T STL HIGH QUALITY FIR UP/DOWN-SAMPLING FILTER
@@ -18,6 +18,15 @@
    15.May.07	v2.4+	Added protoype for the [20Hz-20kHz] filter 
 						and the 1.5kHz, 14kHz. 20kHz LP filters	<Ericsson>
    31.Dec.2008  v2.5    Added LP filters (12kHz) for fs=48kHz < huawei >
+   16.Oct.2026  v2.6    Added polyphase coefficient banks to SCD_FIR
+   16.Oct.2026  v2.7    Added kernel selection (strict/fast, SIMD) hq_mode()
+   16.Oct.2026  v2.8    Added rational L/M resampler hq_resample_init()
+  16.Oct.2026  v2.9    Added FFT (overlap-save) state for long 1:1 filters
+  16.Oct.2026  v3.0    Delay line changed to a mirrored ring buffer
+  16.Oct.2026  v3.1    Added interleaved multichannel filtering hq_kernel_multi()
+  16.Oct.2026  v3.2    Added chains of FIR filters FIR_CHAIN, hq_chain_*()
+  16.Oct.2026  v3.3    Added fixed-point filters SCD_FIR_FX, hq_fx_*()
+  16.Oct.2026  v3.4    FFT tables of the filters replaced by a shared FFT plan
 
   ============================================================================
 */
@@ -45,16 +54,76 @@ typedef struct {
   long k0;                      /* start index in next segment */
   /* (needed in segmentwise filtering) */
   float *h0;                    /* pointer to array with FIR coeff.  */
-  float *T;                     /* pointer to delay line */
-  char hswitch;                 /* switch to FIR-kernel */
+  float *T;                     /* pointer to delay line: mirrored ring
+                                 * buffer of interleaved channels,
+                                 * T[i]=T[i+nchan*lring] (aligned) */
+  char hswitch;                 /* switch to FIR-kernel: 'U'p-, 'D'own-sampling or 'R'ational L/M (nphase/dwn_up) */
+  long nphase;                  /* number of polyphase coefficient banks */
+  long lenph;                   /* number of coefficients per bank */
+  long lenpad;                  /* bank length padded to multiple of FIR_PAD */
+  float *hph;                   /* pointer to reversed polyphase banks
+                                 * (nphase*lenpad, aligned) */
+  char mode;                    /* kernel mode: HQ_STRICT or HQ_FAST */
+  char isa;                     /* instruction set used by the kernel */
+  long phase;                   /* bank of next output (rational L/M) */
+  long lchunk;                  /* max.input samples per kernel pass */
+  long lring;                   /* ring length: lenpad-1+lchunk */
+  long widx;                    /* ring index of next input sample */
+  long nchan;                   /* number of interleaved channels in T */
+  long nfft;                    /* FFT size for fast convolution (0: none) */
+  float *fftH;                  /* spectrum of h0, nfft points (aligned) */
+  float *fftX;                  /* FFT work buffer, nfft points (aligned) */
+  const struct fft_plan *fftplan; /* shared FFT plan of nfft points (fft.h) */
 } SCD_FIR;
 
+/* 
+ * ..... Chain of FIR filters processed tile by tile (fir-chain.c) ..... 
+ */
+typedef struct {
+  int nstage;                   /* number of filters (after fusing) */
+  SCD_FIR **fir;                /* filters, first to last (owned by the chain) */
+  int *ostage;                  /* index of the stage given at init. whose output each filter computes */
+  long *nclip;                  /* per stage given at init.: output samples out of 16-bit range */
+  long tile;                    /* input samples per tile */
+  long lbuf;                    /* length of each work buffer */
+  float *buf[2];                /* work buffers for the intermediate signals (aligned) */
+} FIR_CHAIN;
+
+/* 
+ * ..... State of a fixed-point FIR filter: Q15 coefficients, Q31 accumulator (fir-fx.c) ..... 
+ */
+typedef struct {
+  long lenh0;                   /* number of FIR coefficients */
+  long nphase;                  /* number of coefficient banks (up-sampling factor) */
+  long lenph;                   /* number of coefficients per bank */
+  long ndown;                   /* down-sampling factor */
+  short *hph;                   /* reversed Q15 banks, scaled by 2^-shift (nphase*lenph) */
+  short shift;                  /* headroom of the coefficients, in bits */
+  long habs;                    /* largest sum of the magnitudes of a bank */
+  short *T;                     /* delay line: lenph-1 state samples and one chunk */
+  long k0;                      /* start index in next segment */
+  long phase;                   /* bank of next output */
+  char wmops;                   /* 1: basic operators (WMOPS counted); 0: native integer code */
+} SCD_FIR_FX;
+
+/* Kernel modes for hq_mode() */
+#define HQ_STRICT      0        /* float summation order of the original STL kernels (bit-exact) */
+#define HQ_FAST        1        /* reordered summation for throughput runs */
+
+/* Instruction sets for hq_mode() */
+#define HQ_ISA_AUTO   -1        /* best instruction set of the processor */
+#define HQ_ISA_C       0        /* portable C */
+#define HQ_ISA_SSE2    1
+#define HQ_ISA_AVX2    2        /* AVX2 and FMA */
+#define HQ_ISA_AVX512  3        /* AVX-512F */
+
 
 /* 
  * ..... Global function prototypes ..... 
  */
 
 long hq_kernel ARGS ((long lseg, float *x_ptr, SCD_FIR * fir_ptr, float *y_ptr));
+long hq_kernel_multi ARGS ((int nchan, long lseg, float *x_ptr, SCD_FIR * fir_ptr, float *y_ptr));
 SCD_FIR *hq_down_2_to_1_init ARGS ((void));
 SCD_FIR *hq_up_1_to_2_init ARGS ((void));
 SCD_FIR *hq_down_3_to_1_init ARGS ((void));
@@ -87,8 +156,18 @@ SCD_FIR *LP20_48kHz_init ARGS ((void));
 // FILTER_12k48k_HW
 SCD_FIR *LP12_48kHz_init ARGS ((void));
 // FILTER_12k48k_HW
+SCD_FIR *hq_resample_init ARGS ((long L, long M, double passband, double stopband));
 void hq_free ARGS ((SCD_FIR * fir_ptr));
 void hq_reset ARGS ((SCD_FIR * fir_ptr));
+int hq_mode ARGS ((SCD_FIR * fir_ptr, int mode, int max_isa));
+FIR_CHAIN *hq_chain_init ARGS ((int nstage, SCD_FIR ** fir, long tile, int fuse));
+long hq_chain_kernel ARGS ((long lseg, float *x_ptr, FIR_CHAIN * chain, float *y_ptr));
+void hq_chain_reset ARGS ((FIR_CHAIN * chain));
+void hq_chain_free ARGS ((FIR_CHAIN * chain));
+SCD_FIR_FX *hq_fx_init ARGS ((SCD_FIR * fir_ptr, int wmops));
+long hq_fx_kernel ARGS ((long lseg, short *x_ptr, SCD_FIR_FX * fir_ptr, short *y_ptr));
+void hq_fx_reset ARGS ((SCD_FIR_FX * fir_ptr));
+void hq_fx_free ARGS ((SCD_FIR_FX * fir_ptr));
 
 #endif /* FIRFLT_FIRstruct_defined */
 
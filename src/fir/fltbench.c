@@ -0,0 +1,569 @@
+/*                                                           16.Oct.2026 v1.1
+  ===========================================================================
+
+  FLTBENCH.C
+  ~~~~~~~~~~
+
+  Description:
+  ~~~~~~~~~~~~
+
+  Throughput benchmark of the FIR and IIR filters of the STL: every
+  *_init() function of firflt.h and iirflt.h is run on white noise,
+  segment by segment, for several segment lengths, and one line of
+  comma-separated values is printed per filter, kernel and segment
+  length, so that runs can be compared by scripts to detect
+  regressions or to compare the kernels of the FIR module:
+
+    filter,init,form,kernel,isa,lseg,fs,calls,samples,seconds,
+    samples_per_s,rtf,allocs_per_call
+
+  where
+    filter ........ filter name as in the filter program
+    init .......... initialization function
+    form .......... FIR, IIR-P (parallel), IIR-C (cascade), IIR-D (direct)
+    kernel ........ strict (FIR, see hq_mode()), fast (FIR, or IIR-C
+                    with cascade_iir_mode()), q15 (FIR, see
+                    hq_fx_kernel()), std (IIR), multi (IIR-C, -nchan
+                    interleaved channels with cascade_iir_kernel_multi())
+                    or threads (IIR-P and IIR-D, stdpcm_kernel_parallel()
+                    and direct_iir_kernel_parallel() with -threads)
+    isa ........... instruction set used by the FIR float kernels
+    lseg .......... input samples per channel per call of the kernel
+    fs ............ input sampling rate of the filter, in Hz
+    calls ......... calls of the kernel measured
+    samples ....... input samples filtered (all channels)
+    seconds ....... CPU time, in s (elapsed time for the threads
+                    kernel, where POSIX threads are available)
+    samples_per_s . input samples per second
+    rtf ........... real-time factor: seconds of signal per second
+                    (>1 is faster than real time)
+    allocs_per_call memory allocations per call of the kernel (-1 if
+                    the allocations can't be counted in this build)
+
+  Lines starting with '#' are comments. Each measurement is done on a
+  filter just initialized, after one warm-up pass over the input and
+  a reset, and is repeated until the CPU time reaches the minimum
+  given by -time.
+
+  Usage:
+  ~~~~~~
+  $ stl_filter_bench [-options]
+
+  Options:
+  -seg l1,l2,.. segment lengths, in samples [def: 1,10,80,160,4096]
+  -len n ....... input samples per pass [def: 48000]
+  -time t ...... minimum CPU time of a measurement, in s [def: 0.2]
+  -filter name . only filters whose name or init function contain name
+  -kernel k .... only kernel k: strict, fast, q15, std, multi or
+                 threads [def: all]
+  -isa n ....... highest instruction set of the FIR kernels: 0=C,
+                 1=SSE2, 2=AVX2, 3=AVX-512 [def: best available]
+  -nchan n ..... interleaved channels of the multi kernel [def: 2]
+  -threads n ... max.threads of the threads kernel; 0 for the number
+                 of processors [def: 0]
+  -list ........ list the filters and exit
+
+  Allocations are counted when the program is linked with the GNU
+  linker option --wrap for malloc(), calloc() and realloc(), as done in
+  CMakeLists.txt (COUNT_ALLOC defined).
+
+  History:
+  ~~~~~~~~
+  16.Oct.2026 v1.0 Created.
+  16.Oct.2026 v1.1 Added the fast and multi kernels of the cascade-form
+                   and the threads kernels of the parallel- and
+                   direct-form IIR filters.
+  ===========================================================================
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>               /* clock() */
+#ifdef IIR_PTHREADS
+#include <unistd.h>             /* POSIX clock_gettime() */
+#endif
+
+/* UGST MODULES */
+#include "iirflt.h"
+#include "firflt.h"
+
+/* LOCAL DEFINITIONS */
+#define MAX_SEG 16              /* max.number of segment lengths */
+#define BENCH_SEED 12345L       /* seed of the noise generator */
+
+
+/*
+ * Memory allocation counter: with the linker option
+ * --wrap=malloc,--wrap=calloc,--wrap=realloc all calls of these
+ * functions in the program come through here
+ */
+#ifdef COUNT_ALLOC
+static long nalloc = 0;
+
+void *__real_malloc (size_t size);
+void *__real_calloc (size_t n, size_t size);
+void *__real_realloc (void *p, size_t size);
+
+void *__wrap_malloc (size_t size) {
+  nalloc++;
+  return __real_malloc (size);
+}
+
+void *__wrap_calloc (size_t n, size_t size) {
+  nalloc++;
+  return __real_calloc (n, size);
+}
+
+void *__wrap_realloc (void *p, size_t size) {
+  nalloc++;
+  return __real_realloc (p, size);
+}
+#endif
+
+
+/*
+ * Rational resamplers of the filter program (RSMP), as fixed inits
+ */
+static SCD_FIR *rsmp_147_160_init (void) {
+  return hq_resample_init (147, 160, 0.9, 1.0);
+}
+
+static SCD_FIR *rsmp_160_147_init (void) {
+  return hq_resample_init (160, 147, 0.9, 1.0);
+}
+
+
+/*
+ * Table of the filters: name (as in filter.c), init function, form
+ * ('F'IR, 'P'arallel, 'C'ascade, 'D'irect IIR), input sampling rate
+ */
+typedef struct {
+  char *name;
+  char *init_name;
+  char form;
+  double fs;
+  SCD_FIR *(*fir_init) ARGS ((void));
+  SCD_IIR *(*parallel_init) ARGS ((void));
+  CASCADE_IIR *(*cascade_init) ARGS ((void));
+  DIRECT_IIR *(*direct_init) ARGS ((void));
+} BENCH_FILTER;
+
+#define FIR_ENTRY(n,f,fs) { n, #f, 'F', fs, f, NULL, NULL, NULL }
+#define PAR_ENTRY(n,f,fs) { n, #f, 'P', fs, NULL, f, NULL, NULL }
+#define CAS_ENTRY(n,f,fs) { n, #f, 'C', fs, NULL, NULL, f, NULL }
+#define DIR_ENTRY(n,f,fs) { n, #f, 'D', fs, NULL, NULL, NULL, f }
+
+static BENCH_FILTER filters[] = {
+  FIR_ENTRY ("HQ2-down", hq_down_2_to_1_init, 16000),
+  FIR_ENTRY ("HQ2-up", hq_up_1_to_2_init, 8000),
+  FIR_ENTRY ("HQ3-down", hq_down_3_to_1_init, 48000),
+  FIR_ENTRY ("HQ3-up", hq_up_1_to_3_init, 16000),
+  FIR_ENTRY ("IRS8", irs_8khz_init, 8000),
+  FIR_ENTRY ("IRS16", irs_16khz_init, 16000),
+  FIR_ENTRY ("IRS16-mod", mod_irs_16khz_init, 16000),
+  FIR_ENTRY ("IRS48-mod", mod_irs_48khz_init, 48000),
+  FIR_ENTRY ("TIRS", tia_irs_8khz_init, 8000),
+  FIR_ENTRY ("HIRS16", ht_irs_16khz_init, 16000),
+  FIR_ENTRY ("RXIRS16", rx_mod_irs_16khz_init, 16000),
+  FIR_ENTRY ("RXIRS8", rx_mod_irs_8khz_init, 8000),
+  FIR_ENTRY ("DSM", delta_sm_16khz_init, 16000),
+  FIR_ENTRY ("FLAT-down", linear_phase_pb_2_to_1_init, 16000),
+  FIR_ENTRY ("FLAT-up", linear_phase_pb_1_to_2_init, 8000),
+  FIR_ENTRY ("FLAT1", linear_phase_pb_1_to_1_init, 16000),
+  FIR_ENTRY ("PSO", psophometric_8khz_init, 8000),
+  FIR_ENTRY ("MSIN", msin_16khz_init, 16000),
+  FIR_ENTRY ("P341", p341_16khz_init, 16000),
+  FIR_ENTRY ("5KBP", bp5k_16khz_init, 16000),
+  FIR_ENTRY ("100_5KBP", bp100_5k_16khz_init, 16000),
+  FIR_ENTRY ("14KBP", bp14k_32khz_init, 32000),
+  FIR_ENTRY ("20KBP", bp20k_48khz_init, 48000),
+  FIR_ENTRY ("LP1p5", LP1p5_48kHz_init, 48000),
+  FIR_ENTRY ("LP35", LP35_48kHz_init, 48000),
+  FIR_ENTRY ("LP7", LP7_48kHz_init, 48000),
+  FIR_ENTRY ("LP10", LP10_48kHz_init, 48000),
+  FIR_ENTRY ("LP12", LP12_48kHz_init, 48000),
+  FIR_ENTRY ("LP14", LP14_48kHz_init, 48000),
+  FIR_ENTRY ("LP20", LP20_48kHz_init, 48000),
+  FIR_ENTRY ("RSMP-147/160", rsmp_147_160_init, 48000),
+  FIR_ENTRY ("RSMP-160/147", rsmp_160_147_init, 44100),
+  PAR_ENTRY ("PCM1", stdpcm_16khz_init, 16000),
+  PAR_ENTRY ("PCM-down", stdpcm_2_to_1_init, 16000),
+  PAR_ENTRY ("PCM-up", stdpcm_1_to_2_init, 8000),
+  CAS_ENTRY ("G712-casc", iir_G712_8khz_init, 8000),
+  CAS_ENTRY ("IRS8-casc", iir_irs_8khz_init, 8000),
+  CAS_ENTRY ("IFLAT-down", iir_casc_lp_3_to_1_init, 48000),
+  CAS_ENTRY ("IFLAT-up", iir_casc_lp_1_to_3_init, 16000),
+  DIR_ENTRY ("DC", iir_dir_dc_removal_init, 8000)
+};
+
+#define NFILTERS (sizeof (filters) / sizeof (filters[0]))
+
+
+/* Kernels measured, and the forms ('F','P','C','D') each one applies to */
+enum bench_kernel { K_STRICT, K_FAST, K_Q15, K_STD, K_MULTI, K_THREADS };
+char *kernel_str[] = { "strict", "fast", "q15", "std", "multi", "threads" };
+char *kernel_forms[] = { "F", "FC", "F", "PCD", "C", "PD" };
+char *form_str[] = { "FIR", "IIR-P", "IIR-C", "IIR-D" };
+char *isa_str[] = { "C", "SSE2", "AVX2", "AVX-512" };
+
+
+/*
+ * State of one filter under test
+ */
+typedef struct {
+  int kernel;
+  int nchan;                    /* interleaved channels per call */
+  int nthreads;                 /* max.threads of the threads kernel */
+  SCD_FIR *fir;
+  SCD_FIR_FX *fx;
+  SCD_IIR *parallel;
+  CASCADE_IIR *cascade;
+  DIRECT_IIR *direct;
+} BENCH_STATE;
+
+
+/*
+ * Function to display usage
+ */
+void display_usage () {
+  printf ("FLTBENCH.C - Version 1.1 of 16.Oct.2026 \n\n");
+  printf (" Throughput benchmark of the FIR and IIR filters of the STL. One\n");
+  printf (" line of comma-separated values per filter, kernel and segment\n");
+  printf (" length is printed:\n");
+  printf ("  filter,init,form,kernel,isa,lseg,fs,calls,samples,seconds,\n");
+  printf ("  samples_per_s,rtf,allocs_per_call\n");
+  printf ("\n");
+  printf (" Usage:\n");
+  printf (" $ stl_filter_bench [-options]\n");
+  printf (" Options:\n");
+  printf ("  -seg l1,l2,.. segment lengths, in samples [def: 1,10,80,160,4096]\n");
+  printf ("  -len n ....... input samples per pass [def: 48000]\n");
+  printf ("  -time t ...... minimum CPU time of a measurement, in s [def: 0.2]\n");
+  printf ("  -filter name . only filters whose name or init function contain name\n");
+  printf ("  -kernel k .... only kernel k: strict, fast, q15, std, multi or\n");
+  printf ("                 threads [def: all]\n");
+  printf ("  -isa n ....... highest instruction set of the FIR kernels: 0=C,\n");
+  printf ("                 1=SSE2, 2=AVX2, 3=AVX-512 [def: best available]\n");
+  printf ("  -nchan n ..... interleaved channels of the multi kernel [def: 2]\n");
+  printf ("  -threads n ... max.threads of the threads kernel; 0 for the number\n");
+  printf ("                 of processors [def: 0]\n");
+  printf ("  -list ........ list the filters and exit\n");
+
+  /* Quit program */
+  exit (-128);
+}
+
+
+/*
+ * Time in s: CPU time of the process, or elapsed time if wall is set
+ * and POSIX clocks are available (the CPU time of several threads
+ * adds up)
+ */
+double bench_time (int wall) {
+#if defined(IIR_PTHREADS) && defined(_POSIX_TIMERS)
+  struct timespec ts;
+
+  if (wall && clock_gettime (CLOCK_MONOTONIC, &ts) == 0)
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+#endif
+  return (double) clock () / CLOCKS_PER_SEC;
+}
+
+
+/*
+ * Initialize filter f for kernel k; returns the max.number of output
+ * samples per channel for a segment of lseg input samples per
+ * channel, or 0 on failure
+ */
+long bench_init (BENCH_FILTER * f, int kernel, int max_isa, int nchan, int nthreads, long lseg, BENCH_STATE * st, int *isa) {
+  long L, M;
+
+  memset (st, 0, sizeof (BENCH_STATE));
+  st->kernel = kernel;
+  st->nchan = (kernel == K_MULTI) ? nchan : 1;
+  st->nthreads = nthreads;
+  *isa = -1;
+
+  switch (f->form) {
+  case 'F':
+    if ((st->fir = f->fir_init ()) == NULL)
+      return 0;
+    *isa = hq_mode (st->fir, kernel == K_FAST ? HQ_FAST : HQ_STRICT, max_isa);
+    if (kernel == K_Q15 && (st->fx = hq_fx_init (st->fir, 0)) == NULL)
+      return 0;
+    L = (st->fir->hswitch == 'D') ? 1 : st->fir->nphase;
+    M = (st->fir->hswitch == 'U') ? 1 : st->fir->dwn_up;
+    return (lseg * L) / M + 1;
+  case 'P':
+    if ((st->parallel = f->parallel_init ()) == NULL)
+      return 0;
+    return (st->parallel->hswitch == 'U') ? lseg * st->parallel->idown : lseg / st->parallel->idown + 1;
+  case 'C':
+    if ((st->cascade = f->cascade_init ()) == NULL)
+      return 0;
+    if (kernel == K_FAST && cascade_iir_mode (st->cascade, IIR_FAST) < 0)
+      return 0;
+    return (st->cascade->hswitch == 'U') ? lseg * st->cascade->idown : lseg / st->cascade->idown + 1;
+  case 'D':
+    if ((st->direct = f->direct_init ()) == NULL)
+      return 0;
+    return (st->direct->hswitch == 'U') ? lseg * st->direct->idown : lseg / st->direct->idown + 1;
+  }
+  return 0;
+}
+
+
+/*
+ * Filter one segment (lseg samples per channel) with the kernel under test
+ */
+long bench_kernel (BENCH_STATE * st, long lseg, float *x, short *xs, float *y, short *ys) {
+  if (st->fx)
+    return hq_fx_kernel (lseg, xs, st->fx, ys);
+  if (st->fir)
+    return hq_kernel (lseg, x, st->fir, y);
+  if (st->parallel)
+    return (st->kernel == K_THREADS) ? stdpcm_kernel_parallel (lseg, x, st->parallel, y, st->nthreads)
+      : stdpcm_kernel (lseg, x, st->parallel, y);
+  if (st->cascade)
+    return (st->kernel == K_MULTI) ? cascade_iir_kernel_multi (st->nchan, lseg, x, st->cascade, y)
+      : cascade_iir_kernel (lseg, x, st->cascade, y);
+  return (st->kernel == K_THREADS) ? direct_iir_kernel_parallel (lseg, x, st->direct, y, st->nthreads)
+    : direct_iir_kernel (lseg, x, st->direct, y);
+}
+
+
+/*
+ * Clear the state of the filter under test
+ */
+void bench_reset (BENCH_STATE * st) {
+  if (st->fx)
+    hq_fx_reset (st->fx);
+  if (st->fir)
+    hq_reset (st->fir);
+  if (st->parallel)
+    stdpcm_reset (st->parallel);
+  if (st->cascade)
+    cascade_iir_reset (st->cascade);
+  if (st->direct)
+    direct_reset (st->direct);
+}
+
+
+/*
+ * Deallocate the filter under test
+ */
+void bench_free (BENCH_STATE * st) {
+  if (st->fx)
+    hq_fx_free (st->fx);
+  if (st->fir)
+    hq_free (st->fir);
+  if (st->parallel)
+    stdpcm_free (st->parallel);
+  if (st->cascade)
+    cascade_iir_free (st->cascade);
+  if (st->direct)
+    direct_iir_free (st->direct);
+}
+
+
+/*============================== */
+int main (int argc, char *argv[]) {
+  /* DECLARATIONS */
+  BENCH_FILTER *f;
+  BENCH_STATE st;
+  float *x, *y;
+  short *xs, *ys;
+  long seg[MAX_SEG] = { 1, 10, 80, 160, 4096 }, nseg = 5;
+  long len = 48000, lseg, lout, ncalls, nsmp, allocs, k, s, i;
+  unsigned long seed = BENCH_SEED;
+  double min_time = 0.2, sec, t1;
+  char *only_filter = NULL, *p;
+  int only_kernel = -1, max_isa = HQ_ISA_AUTO, kernel, isa, list = 0;
+  int nchan = 2, nthreads = 0;
+
+
+  /* ......... GET PARAMETERS ......... */
+
+  /* Check options */
+  while (argc > 1 && argv[1][0] == '-')
+    if (strcmp (argv[1], "-seg") == 0 && argc > 2) {
+      /* Comma-separated segment lengths */
+      for (nseg = 0, p = argv[2]; nseg < MAX_SEG && *p; nseg++) {
+        seg[nseg] = strtol (p, &p, 10);
+        if (seg[nseg] < 1)
+          display_usage ();
+        if (*p == ',')
+          p++;
+      }
+
+      /* Move arg{c,v} over the option to the next argument */
+      argc -= 2;
+      argv += 2;
+    } else if (strcmp (argv[1], "-len") == 0 && argc > 2) {
+      /* Input samples per pass */
+      len = atol (argv[2]);
+
+      /* Move arg{c,v} over the option to the next argument */
+      argc -= 2;
+      argv += 2;
+    } else if (strcmp (argv[1], "-time") == 0 && argc > 2) {
+      /* Minimum CPU time per measurement */
+      min_time = atof (argv[2]);
+
+      /* Move arg{c,v} over the option to the next argument */
+      argc -= 2;
+      argv += 2;
+    } else if (strcmp (argv[1], "-filter") == 0 && argc > 2) {
+      /* Select filters */
+      only_filter = argv[2];
+
+      /* Move arg{c,v} over the option to the next argument */
+      argc -= 2;
+      argv += 2;
+    } else if (strcmp (argv[1], "-kernel") == 0 && argc > 2) {
+      /* Select kernel */
+      for (only_kernel = K_THREADS; only_kernel >= 0; only_kernel--)
+        if (strcmp (argv[2], kernel_str[only_kernel]) == 0)
+          break;
+      if (only_kernel < 0)
+        display_usage ();
+
+      /* Move arg{c,v} over the option to the next argument */
+      argc -= 2;
+      argv += 2;
+    } else if (strcmp (argv[1], "-isa") == 0 && argc > 2) {
+      /* Limit the instruction set of the FIR kernels */
+      max_isa = atoi (argv[2]);
+
+      /* Move arg{c,v} over the option to the next argument */
+      argc -= 2;
+      argv += 2;
+    } else if (strcmp (argv[1], "-nchan") == 0 && argc > 2) {
+      /* Channels of the multichannel kernel */
+      nchan = atoi (argv[2]);
+      if (nchan < 1)
+        display_usage ();
+
+      /* Move arg{c,v} over the option to the next argument */
+      argc -= 2;
+      argv += 2;
+    } else if (strcmp (argv[1], "-threads") == 0 && argc > 2) {
+      /* Threads of the multi-threaded kernels */
+      nthreads = atoi (argv[2]);
+      if (nthreads < 0)
+        display_usage ();
+
+      /* Move arg{c,v} over the option to the next argument */
+      argc -= 2;
+      argv += 2;
+    } else if (strcmp (argv[1], "-list") == 0) {
+      /* List filters only */
+      list = 1;
+
+      /* Move arg{c,v} over the option to the next argument */
+      argc--;
+      argv++;
+    } else
+      display_usage ();
+
+  if (list) {
+    for (i = 0; i < (long) NFILTERS; i++)
+      printf ("%s,%s,%s,%.0f\n", filters[i].name, filters[i].init_name,
+              form_str[strchr ("FPCD", filters[i].form) - "FPCD"], filters[i].fs);
+    return 0;
+  }
+  if (len < 1)
+    display_usage ();
+  for (s = 0; s < nseg; s++)
+    if (seg[s] * nchan > len)
+      len = seg[s] * nchan;
+
+
+  /* ......... INPUT SIGNAL ......... */
+
+  /* White noise, uniform in [-8192,8192), float and 16-bit copies */
+  x = (float *) malloc (len * sizeof (float));
+  xs = (short *) malloc (len * sizeof (short));
+  if (x == NULL || xs == NULL)
+    return 1;
+  for (k = 0; k < len; k++) {
+    seed = (seed * 1103515245UL + 12345UL) & 0xFFFFFFFFUL;
+    xs[k] = (short) ((long) (seed >> 16 & 0x3FFF) - 8192);
+    x[k] = xs[k];
+  }
+
+
+  /* ......... MEASUREMENTS ......... */
+
+  printf ("# STL filter throughput benchmark v1.1: %ld samples per pass, min. %.3f s per measurement\n", len, min_time);
+#ifndef COUNT_ALLOC
+  printf ("# allocations not counted in this build (allocs_per_call=-1)\n");
+#endif
+  printf ("filter,init,form,kernel,isa,lseg,fs,calls,samples,seconds,samples_per_s,rtf,allocs_per_call\n");
+
+  for (i = 0; i < (long) NFILTERS; i++) {
+    f = &filters[i];
+    if (only_filter && strstr (f->name, only_filter) == NULL && strstr (f->init_name, only_filter) == NULL)
+      continue;
+
+    for (kernel = K_STRICT; kernel <= K_THREADS; kernel++) {
+      if (strchr (kernel_forms[kernel], f->form) == NULL || (only_kernel >= 0 && kernel != only_kernel))
+        continue;
+
+      for (s = 0; s < nseg; s++) {
+        /* Fresh filter and output buffers */
+        if ((lout = bench_init (f, kernel, max_isa, nchan, nthreads, seg[s], &st, &isa)) == 0) {
+          fprintf (stderr, "Can't initialize %s; skipped\n", f->name);
+          bench_free (&st);
+          break;
+        }
+        lseg = seg[s] * st.nchan;       /* input samples per call, all channels */
+        y = (float *) malloc (lout * st.nchan * sizeof (float));
+        ys = (short *) malloc (lout * sizeof (short));
+        if (y == NULL || ys == NULL)
+          return 1;
+
+        /* Warm-up pass */
+        for (k = 0; k + lseg <= len; k += lseg)
+          bench_kernel (&st, seg[s], x + k, xs + k, y, ys);
+        bench_reset (&st);
+
+        /* Passes over the input until the min.CPU time is reached */
+#ifdef COUNT_ALLOC
+        allocs = nalloc;
+#endif
+        ncalls = nsmp = 0;
+        t1 = bench_time (kernel == K_THREADS);
+        do {
+          for (k = 0; k + lseg <= len; k += lseg, ncalls++)
+            bench_kernel (&st, seg[s], x + k, xs + k, y, ys);
+          nsmp += k;
+          sec = bench_time (kernel == K_THREADS) - t1;
+        } while (sec < min_time);
+#ifdef COUNT_ALLOC
+        allocs = nalloc - allocs;
+#else
+        allocs = -ncalls;
+#endif
+
+        /* Report */
+        if (sec <= 0)
+          sec = 1.0 / CLOCKS_PER_SEC;
+        printf ("%s,%s,%s,%s,%s,%ld,%.0f,%ld,%ld,%.6f,%.6g,%.6g,%.6g\n",
+                f->name, f->init_name, form_str[strchr ("FPCD", f->form) - "FPCD"],
+                kernel_str[kernel], (isa >= 0 && kernel != K_Q15) ? isa_str[isa] : "-",
+                seg[s], f->fs, ncalls, nsmp, sec, nsmp / sec, nsmp / st.nchan / f->fs / sec, (double) allocs / ncalls);
+        fflush (stdout);
+
+        free (y);
+        free (ys);
+        bench_free (&st);
+      }
+    }
+  }
+
+  free (x);
+  free (xs);
+  return 0;
+}
@@ -0,0 +1,44 @@
+#Compare two ASCII outputs of freqresp: same table, values in dB within TOL hundredths of a dB (default 1)
+#Usage: cmake -DREF=file1 -DTST=file2 [-DTOL=n] -P compare-ascii.cmake
+if(NOT DEFINED TOL)
+  set(TOL 1)
+endif()
+
+file(STRINGS ${REF} ref_lines)
+file(STRINGS ${TST} tst_lines)
+list(LENGTH ref_lines nref)
+list(LENGTH tst_lines ntst)
+if(NOT nref EQUAL ntst)
+  message(FATAL_ERROR "${TST}: ${ntst} lines, ${REF}: ${nref} lines")
+endif()
+
+math(EXPR last "${nref} - 1")
+foreach(i RANGE ${last})
+  list(GET ref_lines ${i} r)
+  list(GET tst_lines ${i} t)
+  if(NOT r STREQUAL t)
+    math(EXPR line "${i} + 1")
+    #Same text apart from the values in dB (numbers with 2 decimals)
+    string(REGEX REPLACE "-?[0-9]+\\.[0-9][0-9]" "#" rs "${r}")
+    string(REGEX REPLACE "-?[0-9]+\\.[0-9][0-9]" "#" ts "${t}")
+    if(NOT rs STREQUAL ts)
+      message(FATAL_ERROR "${TST}, line ${line}: \"${t}\" instead of \"${r}\"")
+    endif()
+
+    #Values in hundredths of a dB
+    string(REGEX MATCHALL "-?[0-9]+\\.[0-9][0-9]" rv "${r}")
+    string(REGEX MATCHALL "-?[0-9]+\\.[0-9][0-9]" tv "${t}")
+    list(LENGTH rv nv)
+    math(EXPR lastv "${nv} - 1")
+    foreach(k RANGE ${lastv})
+      list(GET rv ${k} a)
+      list(GET tv ${k} b)
+      string(REPLACE "." "" a "${a}")
+      string(REPLACE "." "" b "${b}")
+      math(EXPR d "${a} - (${b})")
+      if(d LESS -${TOL} OR d GREATER ${TOL})
+        message(FATAL_ERROR "${TST}, line ${line}: \"${t}\" instead of \"${r}\"")
+      endif()
+    endforeach()
+  endif()
+endforeach()
@@ -0,0 +1,676 @@
+/*                                                            16.Oct.2026 v1.0
+  =============================================================================
+
+                          U    U   GGG    SSSS  TTTTT
+                          U    U  G       S       T
+                          U    U  G  GG   SSSS    T
+                          U    U  G   G       S   T
+                           UUU     GG     SSS     T
+
+                   ========================================
+                    ITU-T - USER'S GROUP ON SOFTWARE TOOLS
+                   ========================================
+
+       =============================================================
+       COPYRIGHT NOTE: This source code, and all of its derivations,
+       is subject to the "ITU-T General Public License". Please have
+       it  read  in    the  distribution  disk,   or  in  the  ITU-T
+       Recommendation G.191 on "SOFTWARE TOOLS FOR SPEECH AND  AUDIO
+       CODING STANDARDS".
+       =============================================================
+
+MODULE:         FFT, SPLIT-RADIX REAL FFT OF THE FREQRESP TOOL
+                Sub-unit: Real FFT of sizes that are not powers of 2
+                          (mixed radix 2/3/4/5, Bluestein)
+
+DESCRIPTION:
+        This file contains the real FFT used by the FFT plans of fft.c
+        when the size n is even but not a power of 2, e.g. 960 points
+        (20 ms at 48 kHz) for spectra that line up with codec frames.
+
+        The n real samples are packed into n/2 complex samples (even
+        samples as real parts, odd samples as imaginary parts), whose
+        complex FFT is split into the spectrum of the real signal.
+
+        The complex FFT of n/2 points is a recursive decimation in time
+        with radix 4, 2, 3 and 5 butterflies, and a generic butterfly
+        for the primes 7, 11 and 13 (44100 points, for example). If n/2
+        has other prime factors, Bluestein's algorithm computes it as a circular
+        convolution with a chirp, done with complex FFTs of a power of
+        2 >= n-1 points.
+
+        The computation is done in double precision, and the spectrum
+        is packed as by actrdft(): a[0] and a[1] hold the real bins 0
+        and n/2, a[2k] and a[2k+1] the real part and the negated
+        imaginary part of bin k. The inverse is scaled so that it
+        returns the original signal (as actrdft() with isgn=-1).
+
+        The tables are read-only after fft_mr_create(); the work memory
+        of a transform is allocated at each call, so that one plan can
+        be used by several threads at the same time.
+
+FUNCTIONS:
+  Local (Used by fft.c, should not be needed by the user's program.
+         Prototypes here and in fft.c, but not in fft.h)
+         = fft_mr_create(...)    : tables of a real FFT of n points
+         = fft_mr_free(...)      : free the tables
+         = fft_mr_exec(...)      : forward or inverse real FFT
+
+  Local (should be used only here -- prototypes only in this file)
+         = cfft_create(...), cfft_free(...), cfft_exec(...),
+           cfft_work(...)        : complex FFT, mixed radix or Bluestein
+
+HISTORY:
+    16.Oct.2026 v1.0 Created.
+
+  =============================================================================
+*/
+
+
+/*
+ * ......... INCLUDES .........
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "fft.h"
+
+
+/*
+ * ......... Local definitions .........
+ */
+#define CFFT_MAXFAC 32          /* max.number of factors of a size */
+#define CFFT_MAXRADIX 13        /* largest radix of the generic butterfly */
+#define CFFT_PI 3.14159265358979323846  /* pi in fft.h has 10 digits only */
+
+/* Complex FFT of n points (interleaved re/im doubles) */
+typedef struct cfft {
+  int n;                        /* FFT size */
+  int fac[2 * CFFT_MAXFAC];     /* radix p and remaining size m of each stage */
+  double *tw;                   /* exp(-2*pi*j*k/n), k=0..n-1 */
+  int m;                        /* Bluestein: convolution size (0: mixed radix) */
+  double *chirp;                /* Bluestein: exp(-j*pi*k^2/n), k=0..n-1 */
+  double *bspec;                /* Bluestein: FFT of the conjugated chirp, /m */
+  struct cfft *sub;             /* Bluestein: mixed-radix FFT of m points */
+  long nwork;                   /* work memory of cfft_exec(), in doubles */
+} CFFT;
+
+/* Real FFT of n points */
+typedef struct fft_mrplan {
+  int n;                        /* real FFT size (even) */
+  CFFT *cf;                     /* complex FFT of n/2 points */
+  double *rtw;                  /* exp(-2*pi*j*k/n), k=0..n/4 */
+} FFT_MRPLAN;
+
+
+/*
+ * ......... Local function prototypes .........
+ */
+FFT_MRPLAN *fft_mr_create (int n);
+void fft_mr_free (FFT_MRPLAN * mr);
+int fft_mr_exec (const FFT_MRPLAN * mr, int isgn, float *a);
+static CFFT *cfft_create (int n);
+static void cfft_free (CFFT * cf);
+static void cfft_exec (const CFFT * cf, const double *in, double *out, double *work);
+static void cfft_work (const CFFT * cf, double *out, const double *in, int fstride, const int *fac);
+
+
+/*
+ * ...................... BEGIN OF FUNCTIONS .........................
+ */
+
+/*
+  ============================================================================
+
+        static CFFT *cfft_create (int n);
+        ~~~~~~~~~~~~~~~~~~~~~~~~
+
+        Description:
+        ~~~~~~~~~~~~
+
+        Tables of a complex FFT of n points: factors 4, 2, 3, 5, 7, 11
+        and 13 if n has no other prime factors, else Bluestein's algorithm with a
+        mixed-radix FFT of a power of 2 >= 2n-1 points.
+
+        Return value:
+        ~~~~~~~~~~~~~
+        Pointer to the tables, NULL if out of memory.
+
+        History:
+        ~~~~~~~~
+        16.Oct.2026 v1.0 Created.
+
+ ============================================================================
+*/
+static CFFT *cfft_create (int n) {
+  CFFT *cf;
+  double *b;
+  int k, p, r, nf;
+  double k2;
+
+  if ((cf = (CFFT *) calloc (1, sizeof (CFFT))) == NULL)
+    return NULL;
+  cf->n = n;
+
+  /* Factors: 4 first, then 2, 3, 5, 7, 11, 13 */
+  for (r = n, nf = 0, p = 4; r > 1 && nf < CFFT_MAXFAC;) {
+    while (r % p != 0 && p <= CFFT_MAXRADIX) {
+      if (p == 4)
+        p = 2;
+      else if (p == 2)
+        p = 3;
+      else if (p == 7)
+        p = 11;
+      else
+        p += 2;
+    }
+    if (p > CFFT_MAXRADIX)
+      break;
+    if (r % p != 0)
+      break;
+    r /= p;
+    cf->fac[2 * nf] = p;
+    cf->fac[2 * nf + 1] = r;
+    nf++;
+  }
+
+  if (r == 1) {
+    /* Mixed radix: twiddle factors */
+    if ((cf->tw = (double *) malloc (2 * n * sizeof (double))) == NULL) {
+      cfft_free (cf);
+      return NULL;
+    }
+    for (k = 0; k < n; k++) {
+      cf->tw[2 * k] = cos (2 * CFFT_PI * k / n);
+      cf->tw[2 * k + 1] = -sin (2 * CFFT_PI * k / n);
+    }
+    cf->nwork = 0;
+    return cf;
+  }
+
+  /* Bluestein: chirp, and spectrum of the convolution kernel */
+  for (cf->m = 1; cf->m < 2 * n - 1; cf->m <<= 1);
+  cf->chirp = (double *) malloc (2 * n * sizeof (double));
+  cf->bspec = (double *) malloc (2 * cf->m * sizeof (double));
+  b = (double *) calloc (2 * cf->m, sizeof (double));
+  cf->sub = cfft_create (cf->m);
+  if (cf->chirp == NULL || cf->bspec == NULL || b == NULL || cf->sub == NULL) {
+    free (b);
+    cfft_free (cf);
+    return NULL;
+  }
+  for (k = 0; k < n; k++) {
+    /* k^2 modulo 2n, so that the angle stays accurate for large k */
+    k2 = fmod ((double) k * k, 2.0 * n);
+    cf->chirp[2 * k] = cos (CFFT_PI * k2 / n);
+    cf->chirp[2 * k + 1] = -sin (CFFT_PI * k2 / n);
+  }
+  b[0] = cf->chirp[0];
+  b[1] = -cf->chirp[1];
+  for (k = 1; k < n; k++) {
+    b[2 * k] = b[2 * (cf->m - k)] = cf->chirp[2 * k];
+    b[2 * k + 1] = b[2 * (cf->m - k) + 1] = -cf->chirp[2 * k + 1];
+  }
+  cfft_exec (cf->sub, b, cf->bspec, NULL);
+  for (k = 0; k < 2 * cf->m; k++)
+    cf->bspec[k] /= cf->m;
+  free (b);
+
+  cf->nwork = 4L * cf->m;
+  return cf;
+}
+
+/* ....................... End of cfft_create() ....................... */
+
+
+/*
+  ============================================================================
+
+        static void cfft_free (CFFT *cf);
+        ~~~~~~~~~~~~~~~~~~~~~
+
+        Description:
+        ~~~~~~~~~~~~
+
+        Free the tables of a complex FFT.
+
+        History:
+        ~~~~~~~~
+        16.Oct.2026 v1.0 Created.
+
+ ============================================================================
+*/
+static void cfft_free (CFFT * cf) {
+  if (cf == NULL)
+    return;
+  free (cf->tw);
+  free (cf->chirp);
+  free (cf->bspec);
+  cfft_free (cf->sub);
+  free (cf);
+}
+
+/* ........................ End of cfft_free() ........................ */
+
+
+/*
+  ============================================================================
+
+        static void cfft_work (const CFFT *cf, double *out,
+        ~~~~~~~~~~~~~~~~~~~~~  const double *in, int fstride,
+                               const int *fac);
+
+        Description:
+        ~~~~~~~~~~~~
+
+        One stage of the mixed-radix FFT (decimation in time): the p
+        FFTs of m points of the samples in[q*fstride], in[(q+p)*fstride],
+        ... (q=0..p-1) are computed recursively into out[q*m...], then
+        combined by m butterflies of radix p. The twiddle factor
+        exp(-2*pi*j*k/(p*m)) is tw[k*fstride]. Radix 7, 11 and 13 use a
+        generic butterfly of p*p complex multiplications.
+
+        History:
+        ~~~~~~~~
+        16.Oct.2026 v1.0 Created.
+
+ ============================================================================
+*/
+static void cfft_work (const CFFT * cf, double *out, const double *in, int fstride, const int *fac) {
+  const double *tw = cf->tw;
+  int p = fac[0], m = fac[1];
+  int q, k;
+  double s0r, s0i, s1r, s1i, s2r, s2i, s3r, s3i, s4r, s4i, s5r, s5i;
+  double s6r, s6i, s7r, s7i, s8r, s8i, s9r, s9i, s10r, s10i, s11r, s11i, s12r, s12i;
+  double *f0, *f1, *f2, *f3, *f4;
+  double yar, yai, ybr, ybi, t;
+  double sc[2 * CFFT_MAXRADIX];
+  int q1, u, i;
+
+  /* Sub-FFTs */
+  if (m == 1)
+    for (q = 0; q < p; q++) {
+      out[2 * q] = in[2 * q * fstride];
+      out[2 * q + 1] = in[2 * q * fstride + 1];
+  } else
+    for (q = 0; q < p; q++)
+      cfft_work (cf, out + 2 * q * m, in + 2 * q * fstride, fstride * p, fac + 2);
+
+/* s = f * tw[i] */
+#define CMUL_TW(sr, si, f, i) \
+  sr = (f)[0] * tw[2 * (i)] - (f)[1] * tw[2 * (i) + 1]; \
+  si = (f)[0] * tw[2 * (i) + 1] + (f)[1] * tw[2 * (i)]
+
+  /* Butterflies */
+  f0 = out;
+  f1 = out + 2 * m;
+  f2 = out + 4 * m;
+  f3 = out + 6 * m;
+  f4 = out + 8 * m;
+  switch (p) {
+  case 2:
+    for (k = 0; k < m; k++, f0 += 2, f1 += 2) {
+      CMUL_TW (s0r, s0i, f1, k * fstride);
+      f1[0] = f0[0] - s0r;
+      f1[1] = f0[1] - s0i;
+      f0[0] += s0r;
+      f0[1] += s0i;
+    }
+    break;
+
+  case 3:
+    t = tw[2 * fstride * m + 1];        /* -sin(2*pi/3) */
+    for (k = 0; k < m; k++, f0 += 2, f1 += 2, f2 += 2) {
+      CMUL_TW (s1r, s1i, f1, k * fstride);
+      CMUL_TW (s2r, s2i, f2, 2 * k * fstride);
+      s3r = s1r + s2r;
+      s3i = s1i + s2i;
+      s0r = (s1r - s2r) * t;
+      s0i = (s1i - s2i) * t;
+      f1[0] = f0[0] - 0.5 * s3r;
+      f1[1] = f0[1] - 0.5 * s3i;
+      f0[0] += s3r;
+      f0[1] += s3i;
+      f2[0] = f1[0] + s0i;
+      f2[1] = f1[1] - s0r;
+      f1[0] -= s0i;
+      f1[1] += s0r;
+    }
+    break;
+
+  case 4:
+    for (k = 0; k < m; k++, f0 += 2, f1 += 2, f2 += 2, f3 += 2) {
+      CMUL_TW (s0r, s0i, f1, k * fstride);
+      CMUL_TW (s1r, s1i, f2, 2 * k * fstride);
+      CMUL_TW (s2r, s2i, f3, 3 * k * fstride);
+      s5r = f0[0] - s1r;
+      s5i = f0[1] - s1i;
+      f0[0] += s1r;
+      f0[1] += s1i;
+      s3r = s0r + s2r;
+      s3i = s0i + s2i;
+      s4r = s0r - s2r;
+      s4i = s0i - s2i;
+      f2[0] = f0[0] - s3r;
+      f2[1] = f0[1] - s3i;
+      f0[0] += s3r;
+      f0[1] += s3i;
+      f1[0] = s5r + s4i;
+      f1[1] = s5i - s4r;
+      f3[0] = s5r - s4i;
+      f3[1] = s5i + s4r;
+    }
+    break;
+
+  case 5:
+    yar = tw[2 * fstride * m];
+    yai = tw[2 * fstride * m + 1];
+    ybr = tw[4 * fstride * m];
+    ybi = tw[4 * fstride * m + 1];
+    for (k = 0; k < m; k++, f0 += 2, f1 += 2, f2 += 2, f3 += 2, f4 += 2) {
+      s0r = f0[0];
+      s0i = f0[1];
+      CMUL_TW (s1r, s1i, f1, k * fstride);
+      CMUL_TW (s2r, s2i, f2, 2 * k * fstride);
+      CMUL_TW (s3r, s3i, f3, 3 * k * fstride);
+      CMUL_TW (s4r, s4i, f4, 4 * k * fstride);
+      s7r = s1r + s4r;
+      s7i = s1i + s4i;
+      s10r = s1r - s4r;
+      s10i = s1i - s4i;
+      s8r = s2r + s3r;
+      s8i = s2i + s3i;
+      s9r = s2r - s3r;
+      s9i = s2i - s3i;
+      f0[0] = s0r + s7r + s8r;
+      f0[1] = s0i + s7i + s8i;
+      s5r = s0r + s7r * yar + s8r * ybr;
+      s5i = s0i + s7i * yar + s8i * ybr;
+      s6r = s10i * yai + s9i * ybi;
+      s6i = -s10r * yai - s9r * ybi;
+      f1[0] = s5r - s6r;
+      f1[1] = s5i - s6i;
+      f4[0] = s5r + s6r;
+      f4[1] = s5i + s6i;
+      s11r = s0r + s7r * ybr + s8r * yar;
+      s11i = s0i + s7i * ybr + s8i * yar;
+      s12r = -s10i * ybi + s9i * yai;
+      s12i = s10r * ybi - s9r * yai;
+      f2[0] = s11r + s12r;
+      f2[1] = s11i + s12i;
+      f3[0] = s11r - s12r;
+      f3[1] = s11i - s12i;
+    }
+    break;
+
+  default:                     /* 7, 11, 13 */
+    for (k = 0; k < m; k++) {
+      for (q = 0; q < p; q++) {
+        sc[2 * q] = out[2 * (k + q * m)];
+        sc[2 * q + 1] = out[2 * (k + q * m) + 1];
+      }
+      for (q1 = 0, u = k; q1 < p; q1++, u += m) {
+        s0r = sc[0];
+        s0i = sc[1];
+        for (q = 1, i = 0; q < p; q++) {
+          if ((i += fstride * u) >= cf->n)
+            i -= cf->n;
+          CMUL_TW (s1r, s1i, sc + 2 * q, i);
+          s0r += s1r;
+          s0i += s1i;
+        }
+        out[2 * u] = s0r;
+        out[2 * u + 1] = s0i;
+      }
+    }
+    break;
+  }
+#undef CMUL_TW
+}
+
+/* ........................ End of cfft_work() ........................ */
+
+
+/*
+  ============================================================================
+
+        static void cfft_exec (const CFFT *cf, const double *in,
+        ~~~~~~~~~~~~~~~~~~~~~  double *out, double *work);
+
+        Description:
+        ~~~~~~~~~~~~
+
+        Forward complex FFT of the n points of in[] into out[] (in and
+        out must not overlap). work[] has cf->nwork doubles (Bluestein
+        only, may be NULL otherwise).
+
+        History:
+        ~~~~~~~~
+        16.Oct.2026 v1.0 Created.
+
+ ============================================================================
+*/
+static void cfft_exec (const CFFT * cf, const double *in, double *out, double *work) {
+  double *x, *X, re, im;
+  int n = cf->n, m = cf->m, k;
+
+  if (m == 0) {
+    cfft_work (cf, out, in, 1, cf->fac);
+    return;
+  }
+
+  /* Bluestein: x = in*chirp, zero-padded to m points */
+  x = work;
+  X = work + 2 * m;
+  for (k = 0; k < n; k++) {
+    x[2 * k] = in[2 * k] * cf->chirp[2 * k] - in[2 * k + 1] * cf->chirp[2 * k + 1];
+    x[2 * k + 1] = in[2 * k] * cf->chirp[2 * k + 1] + in[2 * k + 1] * cf->chirp[2 * k];
+  }
+  memset (x + 2 * n, 0, 2 * (m - n) * sizeof (double));
+
+  /* Circular convolution with the conjugated chirp: inverse FFT as the
+     conjugate of the FFT of the conjugate */
+  cfft_exec (cf->sub, x, X, NULL);
+  for (k = 0; k < m; k++) {
+    re = X[2 * k] * cf->bspec[2 * k] - X[2 * k + 1] * cf->bspec[2 * k + 1];
+    im = X[2 * k] * cf->bspec[2 * k + 1] + X[2 * k + 1] * cf->bspec[2 * k];
+    X[2 * k] = re;
+    X[2 * k + 1] = -im;
+  }
+  cfft_exec (cf->sub, X, x, NULL);
+
+  /* out = chirp*conj(x) */
+  for (k = 0; k < n; k++) {
+    out[2 * k] = x[2 * k] * cf->chirp[2 * k] + x[2 * k + 1] * cf->chirp[2 * k + 1];
+    out[2 * k + 1] = x[2 * k] * cf->chirp[2 * k + 1] - x[2 * k + 1] * cf->chirp[2 * k];
+  }
+}
+
+/* ........................ End of cfft_exec() ........................ */
+
+
+/*
+  ============================================================================
+
+        FFT_MRPLAN *fft_mr_create (int n);
+        ~~~~~~~~~~~~~~~~~~~~~~~~~
+
+        Description:
+        ~~~~~~~~~~~~
+
+        Tables of a real FFT of n points, n even and >= 4.
+
+        Return value:
+        ~~~~~~~~~~~~~
+        Pointer to the tables, NULL if n is invalid or out of memory.
+
+        History:
+        ~~~~~~~~
+        16.Oct.2026 v1.0 Created.
+
+ ============================================================================
+*/
+FFT_MRPLAN *fft_mr_create (int n) {
+  FFT_MRPLAN *mr;
+  int k;
+
+  if (n < 4 || n % 2 != 0)
+    return NULL;
+  if ((mr = (FFT_MRPLAN *) calloc (1, sizeof (FFT_MRPLAN))) == NULL)
+    return NULL;
+  mr->n = n;
+  mr->cf = cfft_create (n / 2);
+  mr->rtw = (double *) malloc (2 * (n / 4 + 1) * sizeof (double));
+  if (mr->cf == NULL || mr->rtw == NULL) {
+    fft_mr_free (mr);
+    return NULL;
+  }
+  for (k = 0; k <= n / 4; k++) {
+    mr->rtw[2 * k] = cos (2 * CFFT_PI * k / n);
+    mr->rtw[2 * k + 1] = -sin (2 * CFFT_PI * k / n);
+  }
+  return mr;
+}
+
+/* ...................... End of fft_mr_create() ...................... */
+
+
+/*
+  ============================================================================
+
+        void fft_mr_free (FFT_MRPLAN *mr);
+        ~~~~~~~~~~~~~~~~
+
+        Description:
+        ~~~~~~~~~~~~
+
+        Free the tables of a real FFT.
+
+        History:
+        ~~~~~~~~
+        16.Oct.2026 v1.0 Created.
+
+ ============================================================================
+*/
+void fft_mr_free (FFT_MRPLAN * mr) {
+  if (mr == NULL)
+    return;
+  cfft_free (mr->cf);
+  free (mr->rtw);
+  free (mr);
+}
+
+/* ....................... End of fft_mr_free() ....................... */
+
+
+/*
+  ============================================================================
+
+        int fft_mr_exec (const FFT_MRPLAN *mr, int isgn, float *a);
+        ~~~~~~~~~~~~~~~
+
+        Description:
+        ~~~~~~~~~~~~
+
+        Real FFT of the n samples of a[] in place (isgn>=0), or its
+        inverse (isgn<0), in the format of actrdft().
+
+        With N=n/2, z[k]=a[2k]+j*a[2k+1] and Z its FFT, the bins of the
+        real signal are, for k=0..N:
+          X[k] = (Z[k]+conj(Z[N-k]))/2 - j*W^k*(Z[k]-conj(Z[N-k]))/2
+        where W=exp(-2*pi*j/n) and Z[N]=Z[0]. The bins k and N-k are
+        computed together, with W^(N-k) = -conj(W^k); the inverse
+        solves these equations for Z[k] and Z[N-k].
+
+        Return value:
+        ~~~~~~~~~~~~~
+        0, or -1 if out of memory (a[] is then unchanged).
+
+        History:
+        ~~~~~~~~
+        16.Oct.2026 v1.0 Created.
+
+ ============================================================================
+*/
+int fft_mr_exec (const FFT_MRPLAN * mr, int isgn, float *a) {
+  const double *w = mr->rtw;
+  double *z, *Z, *work;
+  double er, ei, orr, oi, tr, ti;
+  int N = mr->n / 2, k, nk, j;
+
+  work = (double *) malloc ((4 * N + mr->cf->nwork) * sizeof (double));
+  if (work == NULL)
+    return -1;
+  z = work;
+  Z = work + 2 * N;
+
+  if (isgn >= 0) {
+    for (j = 0; j < 2 * N; j++)
+      z[j] = a[j];
+    cfft_exec (mr->cf, z, Z, work + 4 * N);
+
+    /* Bins 0 and N (real) */
+    a[0] = (float) (Z[0] + Z[1]);
+    a[1] = (float) (Z[0] - Z[1]);
+
+    /* Bins k and N-k, stored as (re,-im) */
+    for (k = 1; 2 * k <= N; k++) {
+      nk = N - k;
+      /* E = (Z[k]+conj(Z[N-k]))/2, O = -j*(Z[k]-conj(Z[N-k]))/2 */
+      er = 0.5 * (Z[2 * k] + Z[2 * nk]);
+      ei = 0.5 * (Z[2 * k + 1] - Z[2 * nk + 1]);
+      orr = 0.5 * (Z[2 * k + 1] + Z[2 * nk + 1]);
+      oi = -0.5 * (Z[2 * k] - Z[2 * nk]);
+      /* t = W^k*O; X[k] = E+t, X[N-k] = conj(E)-conj(t) */
+      tr = w[2 * k] * orr - w[2 * k + 1] * oi;
+      ti = w[2 * k] * oi + w[2 * k + 1] * orr;
+      a[2 * k] = (float) (er + tr);
+      a[2 * k + 1] = (float) -(ei + ti);
+      if (nk != k) {
+        a[2 * nk] = (float) (er - tr);
+        a[2 * nk + 1] = (float) (ei - ti);
+      }
+    }
+  } else {
+    /* Bins 0 and N */
+    Z[0] = 0.5 * (a[0] + a[1]);
+    Z[1] = 0.5 * (a[0] - a[1]);
+
+    for (k = 1; 2 * k <= N; k++) {
+      nk = N - k;
+      /* E = (X[k]+conj(X[N-k]))/2, t = (X[k]-conj(X[N-k]))/2 = W^k*O */
+      er = 0.5 * (a[2 * k] + a[2 * nk]);
+      ei = 0.5 * (-a[2 * k + 1] + a[2 * nk + 1]);
+      tr = 0.5 * (a[2 * k] - a[2 * nk]);
+      ti = 0.5 * (-a[2 * k + 1] - a[2 * nk + 1]);
+      /* O = conj(W^k)*t; Z[k] = E+j*O, Z[N-k] = conj(E)+j*conj(O) */
+      orr = w[2 * k] * tr + w[2 * k + 1] * ti;
+      oi = w[2 * k] * ti - w[2 * k + 1] * tr;
+      Z[2 * k] = er - oi;
+      Z[2 * k + 1] = ei + orr;
+      if (nk != k) {
+        Z[2 * nk] = er + oi;
+        Z[2 * nk + 1] = -ei + orr;
+      }
+    }
+
+    /* Inverse FFT as the conjugate of the FFT of the conjugate, /N */
+    for (k = 0; k < N; k++)
+      Z[2 * k + 1] = -Z[2 * k + 1];
+    cfft_exec (mr->cf, Z, z, work + 4 * N);
+    for (j = 0; j < N; j++) {
+      a[2 * j] = (float) (z[2 * j] / N);
+      a[2 * j + 1] = (float) (-z[2 * j + 1] / N);
+    }
+  }
+
+  free (work);
+  return 0;
+}
+
+/* ....................... End of fft_mr_exec() ....................... */
+
+
+/* *************************** END OF FFT-MR.C *************************** */
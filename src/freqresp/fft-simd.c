@@ -0,0 +1,904 @@
+/*                                                            16.Oct.2026 v1.0
+  =============================================================================
+
+                          U    U   GGG    SSSS  TTTTT
+                          U    U  G       S       T
+                          U    U  G  GG   SSSS    T
+                          U    U  G   G       S   T
+                           UUU     GG     SSS     T
+
+                   ========================================
+                    ITU-T - USER'S GROUP ON SOFTWARE TOOLS
+                   ========================================
+
+       =============================================================
+       COPYRIGHT NOTE: This source code, and all of its derivations,
+       is subject to the "ITU-T General Public License". Please have
+       it  read  in    the  distribution  disk,   or  in  the  ITU-T
+       Recommendation G.191 on "SOFTWARE TOOLS FOR SPEECH AND  AUDIO
+       CODING STANDARDS".
+       =============================================================
+
+MODULE:         FFT, SPLIT-RADIX REAL FFT OF THE FREQRESP TOOL
+                Sub-unit: Butterfly stages and real-FFT post-processing
+                          for SSE2 and AVX, run-time instruction set
+                          selection
+
+DESCRIPTION:
+        This file contains vector versions of the stages of the
+        split-radix FFT of fft.c (cft1st(), cftmdl(), the last stage of
+        cftfsub()/cftbsub(), rftfsub() and rftbsub()), used by
+        actrdft() and the FFT plans when the processor supports them.
+
+        The radix-4 butterflies of one stage are independent: the
+        complex points of consecutive butterflies go into the lanes of
+        a vector (2 per SSE2 vector, 4 per AVX vector), with the same
+        twiddle factor in all lanes. In cft1st() every butterfly has
+        its own twiddle factors and the 4 points of one butterfly go
+        into one SSE2 vector. In rftfsub()/rftbsub() the points j and
+        n-j are loaded as two vectors, the second one reversed.
+
+        Every output is computed with the same operations, in the same
+        order, as in the C version: a-b is computed as a+(-b) (sign
+        flip by exclusive or) and the multiplications are not fused
+        with the additions, so that the results are bit-exact with the
+        C version, including the signs of zeros (as long as the compiler
+        does not contract the C version into fused multiply-adds, e.g.
+        with -march=native; use -ffp-contract=off then).
+
+FUNCTIONS:
+  Global (have prototype in fft.h)
+         = fft_isa(...)          : select the highest instruction set
+
+  Local (Used by fft.c, should not be needed by the user's program.
+         Prototypes here and in fft.c, but not in fft.h)
+         = fft_isa_init(...)     : default instruction set, if none selected
+         = cftfsub_simd(...)     : complex FFT stages, forward
+         = cftbsub_simd(...)     : complex FFT stages, backward
+         = rftfsub_simd(...)     : real FFT post-processing, forward
+         = rftbsub_simd(...)     : real FFT pre-processing, backward
+
+  Local (should be used only here -- prototypes only in this file)
+         = fft_cpu_isa(...)      : find highest instruction set supported
+         = cftfsub_sse2(...), cftfsub_avx(...), cftbsub_sse2(...),
+           cftbsub_avx(...), rftfsub_sse2(...), rftfsub_avx(...),
+           rftbsub_sse2(...), rftbsub_avx(...)
+
+HISTORY:
+    16.Oct.2026 v1.0 Created.
+    16.Oct.2026 v1.1 Default instruction set selected once by fft_isa_init()
+                     (called by fft.c under pthread_once) instead of by
+                     each FFT stage.
+
+  =============================================================================
+*/
+
+
+/*
+ * ......... INCLUDES .........
+ */
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "fft.h"
+
+/* Instruction-set specific code is only compiled for x86 processors; the target attribute allows to compile all versions in one unit, without changing the compiler options */
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define FFT_X86
+#define FFT_TARGET(isa) __attribute__ ((target (isa)))
+#include <immintrin.h>
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#define FFT_X86
+#define FFT_TARGET(isa)
+#include <intrin.h>
+#include <immintrin.h>
+#endif
+
+
+/*
+ * ......... Local function prototypes .........
+ */
+void fft_isa_init (void);
+void cftfsub_simd (int n, float *a, const float *w);
+void cftbsub_simd (int n, float *a, const float *w);
+void rftfsub_simd (int n, float *a, int nc, const float *c);
+void rftbsub_simd (int n, float *a, int nc, const float *c);
+static int fft_cpu_isa (void);
+
+
+/*
+ * ..... Private function prototypes defined in other sub-unit .....
+ */
+extern void cftfsub (int n, float *a, const float *w);
+extern void cftbsub (int n, float *a, const float *w);
+extern void cft1st (int n, float *a, const float *w);
+extern void rftfsub (int n, float *a, int nc, const float *c);
+extern void rftbsub (int n, float *a, int nc, const float *c);
+
+
+/* Instruction set of the FFT, -1 until selected */
+static int fft_isa_sel = -1;
+
+
+/*
+ * ...................... BEGIN OF FUNCTIONS .........................
+ */
+
+/*
+  ============================================================================
+
+        int fft_isa (int max_isa);
+        ~~~~~~~~~~~
+
+        Description:
+        ~~~~~~~~~~~~
+
+        Select the instruction set used by all the FFTs (actrdft(),
+        FFT plans, powSpect()). By default the best instruction set of
+        the processor is used. As the results are the same with all
+        instruction sets, this is only needed for tests and benchmarks;
+        it should be called before any FFT runs in other threads.
+
+        Parameters:
+        ~~~~~~~~~~~
+        max_isa: .. (In) highest instruction set that may be used:
+                         FFT_ISA_C, FFT_ISA_SSE2, FFT_ISA_AVX, or
+                         FFT_ISA_AUTO for no limit.
+
+        Return value:
+        ~~~~~~~~~~~~~
+        The instruction set actually selected.
+
+        History:
+        ~~~~~~~~
+        16.Oct.2026 v1.0 Created.
+
+ ============================================================================
+*/
+int fft_isa (int max_isa) {
+  static int cpu_isa = -1;      /* cached result of CPUID */
+
+  if (cpu_isa < 0)
+    cpu_isa = fft_cpu_isa ();
+
+  fft_isa_sel = (max_isa < 0 || max_isa > cpu_isa) ? cpu_isa : max_isa;
+  return fft_isa_sel;
+}
+
+/* .......................... End of fft_isa() .......................... */
+
+
+/*
+  ============================================================================
+
+        void fft_isa_init (void);
+        ~~~~~~~~~~~~~~~~~
+
+        Description:
+        ~~~~~~~~~~~~
+
+        Select the best instruction set of the processor, unless
+        fft_isa() was already called. fft.c calls it once (with
+        pthread_once() if FFT_PTHREADS is defined) before the first
+        FFT plan or actrdft() table is made, so that the FFT stages
+        below only read the selection.
+
+        History:
+        ~~~~~~~~
+        16.Oct.2026 v1.0 Created.
+
+ ============================================================================
+*/
+void fft_isa_init (void) {
+  if (fft_isa_sel < 0)
+    fft_isa (FFT_ISA_AUTO);
+}
+
+/* ........................ End of fft_isa_init() ........................ */
+
+
+/*
+  ============================================================================
+
+        static int fft_cpu_isa (void);
+        ~~~~~~~~~~~~~~~~~~~~~~
+
+        Description:
+        ~~~~~~~~~~~~
+
+        Find the highest instruction set supported by the processor and
+        by the operating system (saving of the AVX registers).
+
+        Return value:
+        ~~~~~~~~~~~~~
+        FFT_ISA_C, FFT_ISA_SSE2 or FFT_ISA_AVX.
+
+        History:
+        ~~~~~~~~
+        16.Oct.2026 v1.0 Created.
+
+ ============================================================================
+*/
+static int fft_cpu_isa () {
+#if defined(FFT_X86) && defined(__GNUC__)
+  __builtin_cpu_init ();
+  if (__builtin_cpu_supports ("avx"))
+    return FFT_ISA_AVX;
+  if (__builtin_cpu_supports ("sse2"))
+    return FFT_ISA_SSE2;
+  return FFT_ISA_C;
+#elif defined(FFT_X86)
+  int r[4], isa = FFT_ISA_C;
+
+  __cpuid (r, 1);
+  if (r[3] & (1 << 26))         /* SSE2 */
+    isa = FFT_ISA_SSE2;
+  /* OSXSAVE and AVX: check that the OS saves the YMM state */
+  if ((r[2] & (1 << 27)) && (r[2] & (1 << 28)) && (_xgetbv (0) & 0x06) == 0x06)
+    isa = FFT_ISA_AVX;
+  return isa;
+#else
+  return FFT_ISA_C;
+#endif
+}
+
+/* ........................ End of fft_cpu_isa() ........................ */
+
+
+#ifdef FFT_X86
+
+/*
+  ============================================================================
+
+        SSE2 versions: 2 complex points per vector
+
+        The sign masks flip the real (SGN_RE) or imaginary (SGN_IM)
+        parts; cmul(wr,wi,x) is the complex product (wr+j*wi)*x computed
+        as wr*x + (-wi*xi, wi*xr), cmulc() the product with the
+        conjugate of w.
+
+ ============================================================================
+*/
+#define SSE2_SGN_RE _mm_set_ps (0.0f, -0.0f, 0.0f, -0.0f)
+#define SSE2_SGN_IM _mm_set_ps (-0.0f, 0.0f, -0.0f, 0.0f)
+#define SSE2_SWAP(x) _mm_shuffle_ps (x, x, _MM_SHUFFLE (2, 3, 0, 1))
+#define SSE2_DUPRE(x) _mm_shuffle_ps (x, x, _MM_SHUFFLE (2, 2, 0, 0))
+#define SSE2_DUPIM(x) _mm_shuffle_ps (x, x, _MM_SHUFFLE (3, 3, 1, 1))
+
+FFT_TARGET ("sse2")
+static __m128 cmul_sse2 (__m128 wr, __m128 wi, __m128 x) {
+  return _mm_add_ps (_mm_mul_ps (wr, x), _mm_xor_ps (_mm_mul_ps (wi, SSE2_SWAP (x)), SSE2_SGN_RE));
+}
+
+FFT_TARGET ("sse2")
+static __m128 cmulc_sse2 (__m128 wr, __m128 wi, __m128 x) {
+  return _mm_add_ps (_mm_mul_ps (wr, x), _mm_xor_ps (_mm_mul_ps (wi, SSE2_SWAP (x)), SSE2_SGN_IM));
+}
+
+
+/* Radix-4 butterflies of points a[j], a[j+l], a[j+2l], a[j+3l], j=0..l-1
+   (l a multiple of 4), with twiddle factors w1, w2, w3 (type 'C'),
+   without twiddle factors (type 'A') or with w1=w2^2=(1+j)/sqrt(2) (type
+   'B', wk1r=1/sqrt(2)) */
+FFT_TARGET ("sse2")
+static void bfly4_sse2 (float *a, int l, char type, float wk1r, float wk1i, float wk2r, float wk2i, float wk3r, float wk3i) {
+  __m128 w1r = _mm_set1_ps (wk1r), w1i = _mm_set1_ps (wk1i);
+  __m128 w2r = _mm_set1_ps (wk2r), w2i = _mm_set1_ps (wk2i);
+  __m128 w3r = _mm_set1_ps (wk3r), w3i = _mm_set1_ps (wk3i);
+  __m128 mre = _mm_castsi128_ps (_mm_set_epi32 (0, -1, 0, -1));
+  __m128 x0, x1, x2, x3, a0, a1, a2, a3, s3, u, v, d, e;
+  int j;
+
+  for (j = 0; j < l; j += 4) {
+    a0 = _mm_loadu_ps (a + j);
+    a1 = _mm_loadu_ps (a + j + l);
+    a2 = _mm_loadu_ps (a + j + 2 * l);
+    a3 = _mm_loadu_ps (a + j + 3 * l);
+    x0 = _mm_add_ps (a0, a1);
+    x1 = _mm_sub_ps (a0, a1);
+    x2 = _mm_add_ps (a2, a3);
+    x3 = _mm_sub_ps (a2, a3);
+    s3 = SSE2_SWAP (x3);
+    u = _mm_add_ps (x1, _mm_xor_ps (s3, SSE2_SGN_RE));  /* x1r-x3i, x1i+x3r */
+    v = _mm_add_ps (x1, _mm_xor_ps (s3, SSE2_SGN_IM));  /* x1r+x3i, x1i-x3r */
+    _mm_storeu_ps (a + j, _mm_add_ps (x0, x2));
+    d = _mm_sub_ps (x0, x2);
+    switch (type) {
+    case 'A':
+      _mm_storeu_ps (a + j + l, u);
+      _mm_storeu_ps (a + j + 2 * l, d);
+      _mm_storeu_ps (a + j + 3 * l, v);
+      break;
+    case 'B':
+      /* x2i-x0i, x0r-x2r */
+      e = _mm_sub_ps (x2, x0);
+      _mm_storeu_ps (a + j + 2 * l, SSE2_SWAP (_mm_or_ps (_mm_and_ps (mre, d), _mm_andnot_ps (mre, e))));
+      /* wk1r*(x0r-x0i), wk1r*(x0r+x0i) */
+      _mm_storeu_ps (a + j + l, _mm_mul_ps (w1r, _mm_add_ps (SSE2_DUPRE (u), _mm_xor_ps (SSE2_DUPIM (u), SSE2_SGN_RE))));
+      /* x3i+x1r, x3r-x1i, then wk1r*(x0i-x0r), wk1r*(x0i+x0r) */
+      v = _mm_add_ps (s3, _mm_xor_ps (x1, SSE2_SGN_IM));
+      _mm_storeu_ps (a + j + 3 * l, _mm_mul_ps (w1r, _mm_add_ps (SSE2_DUPIM (v), _mm_xor_ps (SSE2_DUPRE (v), SSE2_SGN_RE))));
+      break;
+    default:
+      _mm_storeu_ps (a + j + l, cmul_sse2 (w1r, w1i, u));
+      _mm_storeu_ps (a + j + 2 * l, cmul_sse2 (w2r, w2i, d));
+      _mm_storeu_ps (a + j + 3 * l, cmul_sse2 (w3r, w3i, v));
+    }
+  }
+}
+
+
+/* Butterflies of cft1st() for j>=16: 4 points of one butterfly per
+   vector, two butterflies per loop */
+FFT_TARGET ("sse2")
+static void cft1st_sse2 (int n, float *a, const float *w) {
+  __m128 sgn_hi = _mm_set_ps (-0.0f, -0.0f, 0.0f, 0.0f);
+  __m128 sgn_x3 = _mm_set_ps (-0.0f, 0.0f, 0.0f, -0.0f);
+  __m128 A, B, S, D, T, U, wr, wi;
+  float wk1r, wk1i, wk2r, wk2i, wk3r, wk3i;
+  float *p;
+  int j, h, k1, k2;
+
+  /* First two butterflies (trivial twiddle factors) */
+  cft1st (16, a, w);
+
+  k1 = 0;
+  for (j = 16; j < n; j += 16) {
+    k1 += 2;
+    k2 = 2 * k1;
+    wk2r = w[k1];
+    wk2i = w[k1 + 1];
+    for (h = 0; h < 2; h++) {
+      p = a + j + 8 * h;
+      if (h == 0) {
+        wk1r = w[k2];
+        wk1i = w[k2 + 1];
+        wk3r = wk1r - 2 * wk2i * wk1i;
+        wk3i = 2 * wk2i * wk1r - wk1i;
+      } else {
+        wk1r = w[k2 + 2];
+        wk1i = w[k2 + 3];
+        wk3r = wk1r - 2 * wk2r * wk1i;
+        wk3i = 2 * wk2r * wk1r - wk1i;
+      }
+
+      /* (p0,p2) and (p1,p3): x0,x2 and x1,x3 */
+      A = _mm_loadu_ps (p);
+      B = _mm_loadu_ps (p + 4);
+      S = _mm_add_ps (_mm_shuffle_ps (A, B, _MM_SHUFFLE (1, 0, 1, 0)), _mm_shuffle_ps (A, B, _MM_SHUFFLE (3, 2, 3, 2)));
+      D = _mm_sub_ps (_mm_shuffle_ps (A, B, _MM_SHUFFLE (1, 0, 1, 0)), _mm_shuffle_ps (A, B, _MM_SHUFFLE (3, 2, 3, 2)));
+
+      /* T = (x0+x2, x0-x2), U = (x1r-x3i, x1i+x3r, x1r+x3i, x1i-x3r) */
+      T = _mm_add_ps (_mm_shuffle_ps (S, S, _MM_SHUFFLE (1, 0, 1, 0)), _mm_xor_ps (_mm_shuffle_ps (S, S, _MM_SHUFFLE (3, 2, 3, 2)), sgn_hi));
+      U = _mm_add_ps (_mm_shuffle_ps (D, D, _MM_SHUFFLE (1, 0, 1, 0)), _mm_xor_ps (_mm_shuffle_ps (D, D, _MM_SHUFFLE (2, 3, 2, 3)), sgn_x3));
+
+      /* a[2..3] = w1*U[0..1]; a[4..7] = (w2,w3)*(T[2..3],U[2..3]); the second butterfly uses w2*j */
+      A = cmul_sse2 (_mm_set1_ps (wk1r), _mm_set1_ps (wk1i), _mm_shuffle_ps (U, U, _MM_SHUFFLE (1, 0, 1, 0)));
+      if (h == 0) {
+        wr = _mm_set_ps (wk3r, wk3r, wk2r, wk2r);
+        wi = _mm_set_ps (wk3i, wk3i, wk2i, wk2i);
+      } else {
+        wr = _mm_set_ps (wk3r, wk3r, -wk2i, -wk2i);
+        wi = _mm_set_ps (wk3i, wk3i, wk2r, wk2r);
+      }
+      B = cmul_sse2 (wr, wi, _mm_shuffle_ps (T, U, _MM_SHUFFLE (3, 2, 3, 2)));
+      _mm_storeu_ps (p, _mm_shuffle_ps (T, A, _MM_SHUFFLE (1, 0, 1, 0)));
+      _mm_storeu_ps (p + 4, B);
+    }
+  }
+}
+
+
+/* Middle radix-4 stage, as cftmdl() */
+FFT_TARGET ("sse2")
+static void cftmdl_sse2 (int n, int l, float *a, const float *w) {
+  int k, k1, k2, m, m2;
+  float wk1r, wk1i, wk2r, wk2i, wk3r, wk3i;
+
+  m = l << 2;
+  bfly4_sse2 (a, l, 'A', 0, 0, 0, 0, 0, 0);
+  bfly4_sse2 (a + m, l, 'B', w[2], 0, 0, 0, 0, 0);
+  k1 = 0;
+  m2 = 2 * m;
+  for (k = m2; k < n; k += m2) {
+    k1 += 2;
+    k2 = 2 * k1;
+    wk2r = w[k1];
+    wk2i = w[k1 + 1];
+    wk1r = w[k2];
+    wk1i = w[k2 + 1];
+    wk3r = wk1r - 2 * wk2i * wk1i;
+    wk3i = 2 * wk2i * wk1r - wk1i;
+    bfly4_sse2 (a + k, l, 'C', wk1r, wk1i, wk2r, wk2i, wk3r, wk3i);
+    wk1r = w[k2 + 2];
+    wk1i = w[k2 + 3];
+    wk3r = wk1r - 2 * wk2r * wk1i;
+    wk3i = 2 * wk2r * wk1r - wk1i;
+    bfly4_sse2 (a + k + m, l, 'C', wk1r, wk1i, -wk2i, wk2r, wk3r, wk3i);
+  }
+}
+
+
+/* Forward complex FFT stages, as cftfsub() for n>=16 */
+FFT_TARGET ("sse2")
+static void cftfsub_sse2 (int n, float *a, const float *w) {
+  __m128 a0, a1;
+  int j, l;
+
+  cft1st_sse2 (n, a, w);
+  l = 8;
+  while ((l << 2) < n) {
+    cftmdl_sse2 (n, l, a, w);
+    l <<= 2;
+  }
+  if ((l << 2) == n)
+    bfly4_sse2 (a, l, 'A', 0, 0, 0, 0, 0, 0);
+  else {
+    for (j = 0; j < l; j += 4) {
+      a0 = _mm_loadu_ps (a + j);
+      a1 = _mm_loadu_ps (a + j + l);
+      _mm_storeu_ps (a + j, _mm_add_ps (a0, a1));
+      _mm_storeu_ps (a + j + l, _mm_sub_ps (a0, a1));
+    }
+  }
+}
+
+
+/* Backward complex FFT stages, as cftbsub() for n>=16 */
+FFT_TARGET ("sse2")
+static void cftbsub_sse2 (int n, float *a, const float *w) {
+  __m128 a0, a1, x0, x1, x2, x3;
+  int j, l;
+
+  cft1st_sse2 (n, a, w);
+  l = 8;
+  while ((l << 2) < n) {
+    cftmdl_sse2 (n, l, a, w);
+    l <<= 2;
+  }
+  if ((l << 2) == n) {
+    for (j = 0; j < l; j += 4) {
+      a0 = _mm_xor_ps (_mm_loadu_ps (a + j), SSE2_SGN_IM);
+      a1 = _mm_xor_ps (_mm_loadu_ps (a + j + l), SSE2_SGN_IM);
+      x0 = _mm_add_ps (a0, a1);
+      x1 = _mm_sub_ps (a0, a1);
+      a0 = _mm_loadu_ps (a + j + 2 * l);
+      a1 = _mm_loadu_ps (a + j + 3 * l);
+      x2 = _mm_xor_ps (_mm_add_ps (a0, a1), SSE2_SGN_IM);
+      x3 = SSE2_SWAP (_mm_sub_ps (a0, a1));
+      _mm_storeu_ps (a + j, _mm_add_ps (x0, x2));
+      _mm_storeu_ps (a + j + 2 * l, _mm_sub_ps (x0, x2));
+      _mm_storeu_ps (a + j + l, _mm_sub_ps (x1, x3));
+      _mm_storeu_ps (a + j + 3 * l, _mm_add_ps (x1, x3));
+    }
+  } else {
+    for (j = 0; j < l; j += 4) {
+      a0 = _mm_xor_ps (_mm_loadu_ps (a + j), SSE2_SGN_IM);
+      a1 = _mm_xor_ps (_mm_loadu_ps (a + j + l), SSE2_SGN_IM);
+      _mm_storeu_ps (a + j, _mm_add_ps (a0, a1));
+      _mm_storeu_ps (a + j + l, _mm_sub_ps (a0, a1));
+    }
+  }
+}
+
+
+/* Real FFT post-processing, as rftfsub() with nc=n/4 (ks=1) */
+FFT_TARGET ("sse2")
+static int rftfsub_sse2 (int n, float *a, const float *c, int nc) {
+  __m128 aj, ak, x, y, wr, wi;
+  int j, kk, m;
+
+  m = n >> 1;
+  for (j = 2; j + 4 <= m; j += 4) {
+    kk = j >> 1;
+    wi = _mm_set_ps (c[kk + 1], c[kk + 1], c[kk], c[kk]);
+    wr = _mm_sub_ps (_mm_set1_ps (0.5f), _mm_set_ps (c[nc - kk - 1], c[nc - kk - 1], c[nc - kk], c[nc - kk]));
+    aj = _mm_loadu_ps (a + j);
+    ak = _mm_loadu_ps (a + n - j - 2);
+    ak = _mm_shuffle_ps (ak, ak, _MM_SHUFFLE (1, 0, 3, 2));
+    x = _mm_add_ps (aj, _mm_xor_ps (ak, SSE2_SGN_RE));
+    y = cmul_sse2 (wr, wi, x);
+    _mm_storeu_ps (a + j, _mm_sub_ps (aj, y));
+    ak = _mm_add_ps (ak, _mm_xor_ps (y, SSE2_SGN_IM));
+    _mm_storeu_ps (a + n - j - 2, _mm_shuffle_ps (ak, ak, _MM_SHUFFLE (1, 0, 3, 2)));
+  }
+  return j;
+}
+
+
+/* Real FFT pre-processing of the inverse, as rftbsub() with nc=n/4, without
+   the sign changes of a[1] and a[m+1] */
+FFT_TARGET ("sse2")
+static int rftbsub_sse2 (int n, float *a, const float *c, int nc) {
+  __m128 aj, ak, x, y, wr, wi;
+  int j, kk, m;
+
+  m = n >> 1;
+  for (j = 2; j + 4 <= m; j += 4) {
+    kk = j >> 1;
+    wi = _mm_set_ps (c[kk + 1], c[kk + 1], c[kk], c[kk]);
+    wr = _mm_sub_ps (_mm_set1_ps (0.5f), _mm_set_ps (c[nc - kk - 1], c[nc - kk - 1], c[nc - kk], c[nc - kk]));
+    aj = _mm_loadu_ps (a + j);
+    ak = _mm_loadu_ps (a + n - j - 2);
+    ak = _mm_shuffle_ps (ak, ak, _MM_SHUFFLE (1, 0, 3, 2));
+    x = _mm_add_ps (aj, _mm_xor_ps (ak, SSE2_SGN_RE));
+    y = cmulc_sse2 (wr, wi, x);
+    _mm_storeu_ps (a + j, _mm_sub_ps (_mm_xor_ps (aj, SSE2_SGN_IM), _mm_xor_ps (y, SSE2_SGN_IM)));
+    ak = _mm_add_ps (_mm_xor_ps (ak, SSE2_SGN_IM), y);
+    _mm_storeu_ps (a + n - j - 2, _mm_shuffle_ps (ak, ak, _MM_SHUFFLE (1, 0, 3, 2)));
+  }
+  return j;
+}
+
+
+/*
+  ============================================================================
+
+        AVX versions: 4 complex points per vector
+
+ ============================================================================
+*/
+#define AVX_SGN_RE _mm256_set_ps (0.0f, -0.0f, 0.0f, -0.0f, 0.0f, -0.0f, 0.0f, -0.0f)
+#define AVX_SGN_IM _mm256_set_ps (-0.0f, 0.0f, -0.0f, 0.0f, -0.0f, 0.0f, -0.0f, 0.0f)
+#define AVX_SWAP(x) _mm256_permute_ps (x, 0xB1)
+
+FFT_TARGET ("avx")
+static __m256 cmul_avx (__m256 wr, __m256 wi, __m256 x) {
+  return _mm256_add_ps (_mm256_mul_ps (wr, x), _mm256_xor_ps (_mm256_mul_ps (wi, AVX_SWAP (x)), AVX_SGN_RE));
+}
+
+FFT_TARGET ("avx")
+static __m256 cmulc_avx (__m256 wr, __m256 wi, __m256 x) {
+  return _mm256_add_ps (_mm256_mul_ps (wr, x), _mm256_xor_ps (_mm256_mul_ps (wi, AVX_SWAP (x)), AVX_SGN_IM));
+}
+
+
+/* Radix-4 butterflies, as bfly4_sse2() (l a multiple of 8) */
+FFT_TARGET ("avx")
+static void bfly4_avx (float *a, int l, char type, float wk1r, float wk1i, float wk2r, float wk2i, float wk3r, float wk3i) {
+  __m256 w1r = _mm256_set1_ps (wk1r), w1i = _mm256_set1_ps (wk1i);
+  __m256 w2r = _mm256_set1_ps (wk2r), w2i = _mm256_set1_ps (wk2i);
+  __m256 w3r = _mm256_set1_ps (wk3r), w3i = _mm256_set1_ps (wk3i);
+  __m256 x0, x1, x2, x3, a0, a1, a2, a3, s3, u, v, d, e;
+  int j;
+
+  for (j = 0; j < l; j += 8) {
+    a0 = _mm256_loadu_ps (a + j);
+    a1 = _mm256_loadu_ps (a + j + l);
+    a2 = _mm256_loadu_ps (a + j + 2 * l);
+    a3 = _mm256_loadu_ps (a + j + 3 * l);
+    x0 = _mm256_add_ps (a0, a1);
+    x1 = _mm256_sub_ps (a0, a1);
+    x2 = _mm256_add_ps (a2, a3);
+    x3 = _mm256_sub_ps (a2, a3);
+    s3 = AVX_SWAP (x3);
+    u = _mm256_add_ps (x1, _mm256_xor_ps (s3, AVX_SGN_RE));
+    v = _mm256_add_ps (x1, _mm256_xor_ps (s3, AVX_SGN_IM));
+    _mm256_storeu_ps (a + j, _mm256_add_ps (x0, x2));
+    d = _mm256_sub_ps (x0, x2);
+    switch (type) {
+    case 'A':
+      _mm256_storeu_ps (a + j + l, u);
+      _mm256_storeu_ps (a + j + 2 * l, d);
+      _mm256_storeu_ps (a + j + 3 * l, v);
+      break;
+    case 'B':
+      e = _mm256_sub_ps (x2, x0);
+      _mm256_storeu_ps (a + j + 2 * l, AVX_SWAP (_mm256_blend_ps (d, e, 0xAA)));
+      _mm256_storeu_ps (a + j + l, _mm256_mul_ps (w1r, _mm256_add_ps (_mm256_moveldup_ps (u), _mm256_xor_ps (_mm256_movehdup_ps (u), AVX_SGN_RE))));
+      v = _mm256_add_ps (s3, _mm256_xor_ps (x1, AVX_SGN_IM));
+      _mm256_storeu_ps (a + j + 3 * l, _mm256_mul_ps (w1r, _mm256_add_ps (_mm256_movehdup_ps (v), _mm256_xor_ps (_mm256_moveldup_ps (v), AVX_SGN_RE))));
+      break;
+    default:
+      _mm256_storeu_ps (a + j + l, cmul_avx (w1r, w1i, u));
+      _mm256_storeu_ps (a + j + 2 * l, cmul_avx (w2r, w2i, d));
+      _mm256_storeu_ps (a + j + 3 * l, cmul_avx (w3r, w3i, v));
+    }
+  }
+}
+
+
+/* Middle radix-4 stage, as cftmdl() */
+FFT_TARGET ("avx")
+static void cftmdl_avx (int n, int l, float *a, const float *w) {
+  int k, k1, k2, m, m2;
+  float wk1r, wk1i, wk2r, wk2i, wk3r, wk3i;
+
+  m = l << 2;
+  bfly4_avx (a, l, 'A', 0, 0, 0, 0, 0, 0);
+  bfly4_avx (a + m, l, 'B', w[2], 0, 0, 0, 0, 0);
+  k1 = 0;
+  m2 = 2 * m;
+  for (k = m2; k < n; k += m2) {
+    k1 += 2;
+    k2 = 2 * k1;
+    wk2r = w[k1];
+    wk2i = w[k1 + 1];
+    wk1r = w[k2];
+    wk1i = w[k2 + 1];
+    wk3r = wk1r - 2 * wk2i * wk1i;
+    wk3i = 2 * wk2i * wk1r - wk1i;
+    bfly4_avx (a + k, l, 'C', wk1r, wk1i, wk2r, wk2i, wk3r, wk3i);
+    wk1r = w[k2 + 2];
+    wk1i = w[k2 + 3];
+    wk3r = wk1r - 2 * wk2r * wk1i;
+    wk3i = 2 * wk2r * wk1r - wk1i;
+    bfly4_avx (a + k + m, l, 'C', wk1r, wk1i, -wk2i, wk2r, wk3r, wk3i);
+  }
+}
+
+
+/* Forward complex FFT stages, as cftfsub() for n>=16; the first stage has
+   one butterfly per vector and is left to the SSE2 version */
+FFT_TARGET ("avx")
+static void cftfsub_avx (int n, float *a, const float *w) {
+  __m256 a0, a1;
+  int j, l;
+
+  cft1st_sse2 (n, a, w);
+  l = 8;
+  while ((l << 2) < n) {
+    cftmdl_avx (n, l, a, w);
+    l <<= 2;
+  }
+  if ((l << 2) == n)
+    bfly4_avx (a, l, 'A', 0, 0, 0, 0, 0, 0);
+  else {
+    for (j = 0; j < l; j += 8) {
+      a0 = _mm256_loadu_ps (a + j);
+      a1 = _mm256_loadu_ps (a + j + l);
+      _mm256_storeu_ps (a + j, _mm256_add_ps (a0, a1));
+      _mm256_storeu_ps (a + j + l, _mm256_sub_ps (a0, a1));
+    }
+  }
+}
+
+
+/* Backward complex FFT stages, as cftbsub() for n>=16 */
+FFT_TARGET ("avx")
+static void cftbsub_avx (int n, float *a, const float *w) {
+  __m256 a0, a1, x0, x1, x2, x3;
+  int j, l;
+
+  cft1st_sse2 (n, a, w);
+  l = 8;
+  while ((l << 2) < n) {
+    cftmdl_avx (n, l, a, w);
+    l <<= 2;
+  }
+  if ((l << 2) == n) {
+    for (j = 0; j < l; j += 8) {
+      a0 = _mm256_xor_ps (_mm256_loadu_ps (a + j), AVX_SGN_IM);
+      a1 = _mm256_xor_ps (_mm256_loadu_ps (a + j + l), AVX_SGN_IM);
+      x0 = _mm256_add_ps (a0, a1);
+      x1 = _mm256_sub_ps (a0, a1);
+      a0 = _mm256_loadu_ps (a + j + 2 * l);
+      a1 = _mm256_loadu_ps (a + j + 3 * l);
+      x2 = _mm256_xor_ps (_mm256_add_ps (a0, a1), AVX_SGN_IM);
+      x3 = AVX_SWAP (_mm256_sub_ps (a0, a1));
+      _mm256_storeu_ps (a + j, _mm256_add_ps (x0, x2));
+      _mm256_storeu_ps (a + j + 2 * l, _mm256_sub_ps (x0, x2));
+      _mm256_storeu_ps (a + j + l, _mm256_sub_ps (x1, x3));
+      _mm256_storeu_ps (a + j + 3 * l, _mm256_add_ps (x1, x3));
+    }
+  } else {
+    for (j = 0; j < l; j += 8) {
+      a0 = _mm256_xor_ps (_mm256_loadu_ps (a + j), AVX_SGN_IM);
+      a1 = _mm256_xor_ps (_mm256_loadu_ps (a + j + l), AVX_SGN_IM);
+      _mm256_storeu_ps (a + j, _mm256_add_ps (a0, a1));
+      _mm256_storeu_ps (a + j + l, _mm256_sub_ps (a0, a1));
+    }
+  }
+}
+
+
+/* Twiddle factors of rftfsub()/rftbsub() for points j..j+6 (kk=j/2):
+   wi = c[kk..kk+3], wr = 0.5-c[nc-kk..nc-kk-3], each twice */
+FFT_TARGET ("avx")
+static void rft_twiddles_avx (const float *c, int nc, int kk, __m256 * wr, __m256 * wi) {
+  __m128 t;
+
+  t = _mm_loadu_ps (c + kk);
+  *wi = _mm256_insertf128_ps (_mm256_castps128_ps256 (_mm_unpacklo_ps (t, t)), _mm_unpackhi_ps (t, t), 1);
+  t = _mm_loadu_ps (c + nc - kk - 3);
+  t = _mm_shuffle_ps (t, t, _MM_SHUFFLE (0, 1, 2, 3));
+  *wr = _mm256_insertf128_ps (_mm256_castps128_ps256 (_mm_unpacklo_ps (t, t)), _mm_unpackhi_ps (t, t), 1);
+  *wr = _mm256_sub_ps (_mm256_set1_ps (0.5f), *wr);
+}
+
+
+/* Reverse the order of the 4 complex points of a vector */
+#define AVX_REVERSE(x) _mm256_permute2f128_ps (_mm256_permute_ps (x, _MM_SHUFFLE (1, 0, 3, 2)), _mm256_permute_ps (x, _MM_SHUFFLE (1, 0, 3, 2)), 0x01)
+
+
+/* Real FFT post-processing, as rftfsub() with nc=n/4 (ks=1) */
+FFT_TARGET ("avx")
+static int rftfsub_avx (int n, float *a, const float *c, int nc) {
+  __m256 aj, ak, x, y, wr, wi;
+  int j, m;
+
+  m = n >> 1;
+  for (j = 2; j + 8 <= m; j += 8) {
+    rft_twiddles_avx (c, nc, j >> 1, &wr, &wi);
+    aj = _mm256_loadu_ps (a + j);
+    ak = _mm256_loadu_ps (a + n - j - 6);
+    ak = AVX_REVERSE (ak);
+    x = _mm256_add_ps (aj, _mm256_xor_ps (ak, AVX_SGN_RE));
+    y = cmul_avx (wr, wi, x);
+    _mm256_storeu_ps (a + j, _mm256_sub_ps (aj, y));
+    ak = _mm256_add_ps (ak, _mm256_xor_ps (y, AVX_SGN_IM));
+    _mm256_storeu_ps (a + n - j - 6, AVX_REVERSE (ak));
+  }
+  return j;
+}
+
+
+/* Real FFT pre-processing of the inverse, as rftbsub_sse2() */
+FFT_TARGET ("avx")
+static int rftbsub_avx (int n, float *a, const float *c, int nc) {
+  __m256 aj, ak, x, y, wr, wi;
+  int j, m;
+
+  m = n >> 1;
+  for (j = 2; j + 8 <= m; j += 8) {
+    rft_twiddles_avx (c, nc, j >> 1, &wr, &wi);
+    aj = _mm256_loadu_ps (a + j);
+    ak = _mm256_loadu_ps (a + n - j - 6);
+    ak = AVX_REVERSE (ak);
+    x = _mm256_add_ps (aj, _mm256_xor_ps (ak, AVX_SGN_RE));
+    y = cmulc_avx (wr, wi, x);
+    _mm256_storeu_ps (a + j, _mm256_sub_ps (_mm256_xor_ps (aj, AVX_SGN_IM), _mm256_xor_ps (y, AVX_SGN_IM)));
+    ak = _mm256_add_ps (_mm256_xor_ps (ak, AVX_SGN_IM), y);
+    _mm256_storeu_ps (a + n - j - 6, AVX_REVERSE (ak));
+  }
+  return j;
+}
+
+#endif /* FFT_X86 */
+
+
+/*
+  ============================================================================
+
+        void cftfsub_simd (int n, float *a, const float *w);
+        void cftbsub_simd (int n, float *a, const float *w);
+        ~~~~~~~~~~~~~~~~~
+
+        Description:
+        ~~~~~~~~~~~~
+
+        Complex FFT stages of actrdft() (forward and backward), with
+        the selected instruction set; n<16 or FFT_ISA_C: C version.
+
+        History:
+        ~~~~~~~~
+        16.Oct.2026 v1.0 Created.
+
+ ============================================================================
+*/
+void cftfsub_simd (int n, float *a, const float *w) {
+#ifdef FFT_X86
+  if (n >= 16 && fft_isa_sel >= FFT_ISA_AVX) {
+    cftfsub_avx (n, a, w);
+    return;
+  }
+  if (n >= 16 && fft_isa_sel == FFT_ISA_SSE2) {
+    cftfsub_sse2 (n, a, w);
+    return;
+  }
+#endif
+  cftfsub (n, a, w);
+}
+
+void cftbsub_simd (int n, float *a, const float *w) {
+#ifdef FFT_X86
+  if (n >= 16 && fft_isa_sel >= FFT_ISA_AVX) {
+    cftbsub_avx (n, a, w);
+    return;
+  }
+  if (n >= 16 && fft_isa_sel == FFT_ISA_SSE2) {
+    cftbsub_sse2 (n, a, w);
+    return;
+  }
+#endif
+  cftbsub (n, a, w);
+}
+
+/* .................... End of cft{f,b}sub_simd() .................... */
+
+
+/*
+  ============================================================================
+
+        void rftfsub_simd (int n, float *a, int nc, const float *c);
+        void rftbsub_simd (int n, float *a, int nc, const float *c);
+        ~~~~~~~~~~~~~~~~~
+
+        Description:
+        ~~~~~~~~~~~~
+
+        Post-processing of the real FFT (forward) and pre-processing of
+        the inverse real FFT of actrdft(), with the selected
+        instruction set. The vector versions need a cos table of
+        exactly n/4 values (nc=n/4, as in the FFT plans); the points
+        left over, or all of them for other tables, are done as in
+        rftfsub()/rftbsub().
+
+        History:
+        ~~~~~~~~
+        16.Oct.2026 v1.0 Created.
+
+ ============================================================================
+*/
+void rftfsub_simd (int n, float *a, int nc, const float *c) {
+  int j = 2, k, kk, ks, m;
+  float wkr, wki, xr, xi, yr, yi;
+
+  if (nc != n >> 2 || fft_isa_sel == FFT_ISA_C || n < 32) {
+    rftfsub (n, a, nc, c);
+    return;
+  }
+#ifdef FFT_X86
+  if (fft_isa_sel >= FFT_ISA_AVX)
+    j = rftfsub_avx (n, a, c, nc);
+  else
+    j = rftfsub_sse2 (n, a, c, nc);
+#endif
+
+  /* Points left over, as in rftfsub() */
+  m = n >> 1;
+  ks = 2 * nc / m;
+  for (kk = (j >> 1) * ks; j < m; j += 2, kk += ks) {
+    k = n - j;
+    wkr = (float) 0.5 - c[nc - kk];
+    wki = c[kk];
+    xr = a[j] - a[k];
+    xi = a[j + 1] + a[k + 1];
+    yr = wkr * xr - wki * xi;
+    yi = wkr * xi + wki * xr;
+    a[j] -= yr;
+    a[j + 1] -= yi;
+    a[k] += yr;
+    a[k + 1] -= yi;
+  }
+}
+
+void rftbsub_simd (int n, float *a, int nc, const float *c) {
+  int j = 2, k, kk, ks, m;
+  float wkr, wki, xr, xi, yr, yi;
+
+  if (nc != n >> 2 || fft_isa_sel == FFT_ISA_C || n < 32) {
+    rftbsub (n, a, nc, c);
+    return;
+  }
+  a[1] = -a[1];
+#ifdef FFT_X86
+  if (fft_isa_sel >= FFT_ISA_AVX)
+    j = rftbsub_avx (n, a, c, nc);
+  else
+    j = rftbsub_sse2 (n, a, c, nc);
+#endif
+
+  /* Points left over, as in rftbsub() */
+  m = n >> 1;
+  ks = 2 * nc / m;
+  for (kk = (j >> 1) * ks; j < m; j += 2, kk += ks) {
+    k = n - j;
+    wkr = (float) 0.5 - c[nc - kk];
+    wki = c[kk];
+    xr = a[j] - a[k];
+    xi = a[j + 1] + a[k + 1];
+    yr = wkr * xr + wki * xi;
+    yi = wkr * xi - wki * xr;
+    a[j] -= yr;
+    a[j + 1] = yi - a[j + 1];
+    a[k] += yr;
+    a[k + 1] = yi - a[k + 1];
+  }
+  a[m + 1] = -a[m + 1];
+}
+
+/* .................... End of rft{f,b}sub_simd() .................... */
+
+
+/* ************************** END OF FFT-SIMD.C ************************** */
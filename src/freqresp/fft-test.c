@@ -0,0 +1,191 @@
+/*                                                           16.Oct.2026 v1.0
+  ===========================================================================
+
+  FFT-TEST.C
+  ~~~~~~~~~~
+
+  Description:
+  ~~~~~~~~~~~~
+
+  Test of the FFT plans of fft.c: for each size given on the command
+  line, the real FFT of a pseudo-random signal computed by
+  fft_plan_exec_real() is compared with a direct DFT in double
+  precision, packed as by actrdft():
+
+    a[0] = R[0], a[1] = R[n/2], a[2k] = R[k], a[2k+1] = I[k]
+
+  with R[k] + j*I[k] = sum(x[i] * exp(j*2*pi*i*k/n)), and the output
+  of fft_plan_exec_inverse() (scaled by 2/n) with the input. Powers of
+  2 check the split-radix FFT, other even sizes the mixed-radix or
+  Bluestein FFT of fft-mr.c.
+
+  The largest error relative to the largest magnitude of the DFT (or
+  of the input) is printed for each size; the program fails if it
+  exceeds the tolerance.
+
+  Usage:
+  ~~~~~~
+  $ fft-test [-isa n] [-tol t] n1 [n2 ...]
+
+  Options:
+  -isa n ... highest instruction set of the FFT: 0=C, 1=SSE2, 2=AVX
+             [def: best available]
+  -tol t ... max.relative error [def: 1e-5]
+
+  Exit value: 0 if all sizes pass, 1 otherwise.
+
+  History:
+  ~~~~~~~~
+  16.Oct.2026 v1.0 Created.
+  ===========================================================================
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+/* UGST MODULES */
+#include "fft.h"
+
+/* LOCAL DEFINITIONS */
+#define TEST_SEED 12345L        /* seed of the noise generator */
+#define TEST_PI 3.14159265358979323846
+
+
+/*
+ * Function to display usage
+ */
+void display_usage () {
+  printf ("FFT-TEST.C - Version 1.0 of 16.Oct.2026 \n\n");
+  printf (" Compares the FFT plans of fft.c with a direct DFT.\n");
+  printf ("\n");
+  printf (" Usage:\n");
+  printf (" $ fft-test [-isa n] [-tol t] n1 [n2 ...]\n");
+  printf (" Options:\n");
+  printf ("  -isa n ... highest instruction set of the FFT: 0=C, 1=SSE2, 2=AVX\n");
+  printf ("             [def: best available]\n");
+  printf ("  -tol t ... max.relative error [def: 1e-5]\n");
+
+  /* Quit program */
+  exit (-128);
+}
+
+
+/*
+ * Relative errors of the FFT and of the inverse FFT of size n;
+ * returns -1 if the plan can't be created
+ */
+int fft_test (int n, double *err_fwd, double *err_inv) {
+  FFT_PLAN *plan;
+  float *x, *a;
+  double *c, *s, re, im, ref, max_ref, max_err;
+  unsigned long seed = TEST_SEED;
+  long i, k, t;
+
+  if ((plan = fft_plan_create (n)) == NULL)
+    return -1;
+  x = (float *) malloc (n * sizeof (float));
+  a = (float *) malloc (n * sizeof (float));
+  c = (double *) malloc (n * sizeof (double));
+  s = (double *) malloc (n * sizeof (double));
+  if (x == NULL || a == NULL || c == NULL || s == NULL)
+    return -1;
+
+  /* Twiddle factors of the direct DFT, exp(j*2*pi*i/n) */
+  for (i = 0; i < n; i++) {
+    c[i] = cos (2 * TEST_PI * i / n);
+    s[i] = sin (2 * TEST_PI * i / n);
+  }
+
+  /* White noise, uniform in [-1,1) */
+  for (i = 0; i < n; i++) {
+    seed = (seed * 1103515245UL + 12345UL) & 0xFFFFFFFFUL;
+    x[i] = (float) ((long) (seed >> 16 & 0xFFFF) - 32768) / 32768;
+  }
+
+  /* Forward FFT against the direct DFT */
+  memcpy (a, x, n * sizeof (float));
+  if (fft_plan_exec_real (plan, a) < 0)
+    return -1;
+  for (k = 0, max_ref = max_err = 0; k <= n / 2; k++) {
+    for (i = 0, t = 0, re = im = 0; i < n; i++, t = (t + k < n) ? t + k : t + k - n) {
+      re += x[i] * c[t];
+      im += x[i] * s[t];
+    }
+    if (k == 0 || k == n / 2) {
+      ref = re;
+      re = fabs (a[k == 0 ? 0 : 1] - ref);
+      im = 0;
+    } else {
+      ref = sqrt (re * re + im * im);
+      re = fabs (a[2 * k] - re);
+      im = fabs (a[2 * k + 1] - im);
+    }
+    max_ref = (fabs (ref) > max_ref) ? fabs (ref) : max_ref;
+    max_err = (re > max_err) ? re : max_err;
+    max_err = (im > max_err) ? im : max_err;
+  }
+  *err_fwd = max_err / max_ref;
+
+  /* Inverse FFT against the input */
+  if (fft_plan_exec_inverse (plan, a) < 0)
+    return -1;
+  for (i = 0, max_ref = max_err = 0; i < n; i++) {
+    max_ref = (fabs (x[i]) > max_ref) ? fabs (x[i]) : max_ref;
+    re = fabs (a[i] - x[i]);
+    max_err = (re > max_err) ? re : max_err;
+  }
+  *err_inv = max_err / max_ref;
+
+  free (x);
+  free (a);
+  free (c);
+  free (s);
+  fft_plan_free (plan);
+  return 0;
+}
+
+
+/*============================== */
+int main (int argc, char *argv[]) {
+  double tol = 1e-5, err_fwd, err_inv;
+  int n, failed = 0;
+
+  /* Check options */
+  while (argc > 1 && argv[1][0] == '-')
+    if (strcmp (argv[1], "-isa") == 0 && argc > 2) {
+      /* Limit the instruction set of the FFT */
+      fft_isa (atoi (argv[2]));
+
+      /* Move arg{c,v} over the option to the next argument */
+      argc -= 2;
+      argv += 2;
+    } else if (strcmp (argv[1], "-tol") == 0 && argc > 2) {
+      /* Tolerance */
+      tol = atof (argv[2]);
+
+      /* Move arg{c,v} over the option to the next argument */
+      argc -= 2;
+      argv += 2;
+    } else
+      display_usage ();
+  if (argc < 2)
+    display_usage ();
+
+  /* Sizes */
+  for (; argc > 1; argc--, argv++) {
+    n = atoi (argv[1]);
+    if (fft_test (n, &err_fwd, &err_inv) < 0) {
+      printf ("n=%d: can't create the plan\n", n);
+      failed = 1;
+      continue;
+    }
+    printf ("n=%d: FFT error %.3g, inverse FFT error %.3g%s\n", n, err_fwd, err_inv,
+            (err_fwd > tol || err_inv > tol) ? " FAILED" : "");
+    if (err_fwd > tol || err_inv > tol)
+      failed = 1;
+  }
+
+  return failed;
+}
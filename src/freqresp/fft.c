@@ -1,4 +1,4 @@
-/*                                                          15.Feb.2010 v1.3 */
+/*                                                          16.Oct.2026 v1.7 */
 /*=============================================================================
 
                           U    U   GGG    SSSS  TTTTT
@@ -32,6 +32,16 @@
                   -nfft : indicates the number of points used in FFT.
   15.Feb.10 v1.3  Modified maximum string length for filename, and
 	                removed some macros (OVERLAP, VAR_NFFT)
+  16.Oct.26 v1.4  FFT plans: fft_plan_create(), fft_plan_get() (cache of
+                  one plan per size), fft_plan_exec_real/inverse(), with
+                  a read-only bit reversal; the global tables DFTip[] and
+                  DFTw[] are removed and powSpect() uses the shared plans
+  16.Oct.26 v1.5  Butterfly stages and real-FFT post-processing run with
+                  SSE2 or AVX when available (fft-simd.c), bit-exact
+  16.Oct.26 v1.6  Plans of even sizes that are not powers of 2
+                  (fft-mr.c), kept in a list in the cache
+  16.Oct.26 v1.7  Default instruction set of the FFT selected once, by
+                  the first plan or actrdft() call (pthread_once)
 
   AUTHORS :
 	Cyril Guillaume & Stephane Ragot -- stephane.ragot@francetelecom.com
@@ -40,7 +50,12 @@
   yusuke hiwasaki (v1.3) NTT
 */
 
+#include <stdio.h>
+#include <stdlib.h>
 #include <math.h>
+#ifdef FFT_PTHREADS
+#include <pthread.h>
+#endif
 #include "fft.h"
 
 
@@ -79,16 +94,39 @@ void powSpect (float *real, float *imag, float *pwSpct, int n) {
 
 #else
 
-int DFTip[128] = { 0 };
-float DFTw[NFFT_MAX >> 1] = { 0 };
+/* Cache of the shared plans, one per power of 2, and a list of the others */
+#define FFT_PLAN_LOG2MAX 30
+static FFT_PLAN *fft_plan_cache[FFT_PLAN_LOG2MAX + 1] = { NULL };
+static FFT_PLAN *fft_plan_list = NULL;
+
+/* Mixed-radix FFT (fft-mr.c) */
+struct fft_mrplan *fft_mr_create (int n);
+void fft_mr_free (struct fft_mrplan *mr);
+int fft_mr_exec (const struct fft_mrplan *mr, int isgn, float *a);
+
+#ifdef FFT_PTHREADS
+static pthread_mutex_t fft_plan_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_once_t fft_isa_once = PTHREAD_ONCE_INIT;
+#endif
 
+/* Default instruction set (fft-simd.c), selected once before the first FFT */
+void fft_isa_init (void);
+#ifdef FFT_PTHREADS
+#define FFT_ISA_INIT() pthread_once (&fft_isa_once, fft_isa_init)
+#else
+#define FFT_ISA_INIT() fft_isa_init ()
+#endif
 
 
 void powSpect (int n, float *x1, float *x2) {
   int i, j;
   float den = (float) (1.0 / (float) n);
-  void actrdft (int n0, int isgn, float *a, int *ip, float *w);
-  actrdft (n, 1, x1, DFTip, DFTw);
+  const FFT_PLAN *plan = fft_plan_get (n);
+
+  if (plan == NULL || fft_plan_exec_real (plan, x1) != 0) {
+    fprintf (stderr, "powSpect: can't compute an FFT of %d points\n", n);
+    exit (-1);
+  }
   x2[0] = (x1[0] * x1[0]) * den;
 
   for (i = 2, j = 1; i < n; i += 2, j++)
@@ -150,9 +188,9 @@ void makect (int nc, int *ip, float *c) {
 /* -------- child routines -------- */
 
 
-void bitrv2 (int n, int *ip, float *a) {
-  int j, j1, k, k1, l, m, m2;
-  float xr, xi, yr, yi;
+/* Bit-reversal table of n in ip[] */
+void bitrv2tab (int n, int *ip) {
+  int j, l, m;
 
   ip[0] = 0;
   l = n;
@@ -164,6 +202,20 @@ void bitrv2 (int n, int *ip, float *a) {
     }
     m <<= 1;
   }
+}
+
+
+/* Bit-reversal permutation of a[], with the table of bitrv2tab() (read only) */
+void bitrv2perm (int n, const int *ip, float *a) {
+  int j, j1, k, k1, l, m, m2;
+  float xr, xi, yr, yi;
+
+  l = n;
+  m = 1;
+  while ((m << 3) < l) {
+    l >>= 1;
+    m <<= 1;
+  }
   m2 = 2 * m;
   if ((m << 3) == l) {
     for (k = 0; k < m; k++) {
@@ -251,9 +303,15 @@ void bitrv2 (int n, int *ip, float *a) {
 
 
 
-void cftfsub (int n, float *a, float *w) {
-  void cft1st (int n, float *a, float *w);
-  void cftmdl (int n, int l, float *a, float *w);
+void bitrv2 (int n, int *ip, float *a) {
+  bitrv2tab (n, ip);
+  bitrv2perm (n, ip, a);
+}
+
+
+void cftfsub (int n, float *a, const float *w) {
+  void cft1st (int n, float *a, const float *w);
+  void cftmdl (int n, int l, float *a, const float *w);
   int j, j1, j2, j3, l;
   float x0r, x0i, x1r, x1i, x2r, x2i, x3r, x3i;
 
@@ -302,9 +360,9 @@ void cftfsub (int n, float *a, float *w) {
 }
 
 
-void cftbsub (int n, float *a, float *w) {
-  void cft1st (int n, float *a, float *w);
-  void cftmdl (int n, int l, float *a, float *w);
+void cftbsub (int n, float *a, const float *w) {
+  void cft1st (int n, float *a, const float *w);
+  void cftmdl (int n, int l, float *a, const float *w);
   int j, j1, j2, j3, l;
   float x0r, x0i, x1r, x1i, x2r, x2i, x3r, x3i;
 
@@ -353,7 +411,7 @@ void cftbsub (int n, float *a, float *w) {
 }
 
 
-void cft1st (int n, float *a, float *w) {
+void cft1st (int n, float *a, const float *w) {
   int j, k1, k2;
   float wk1r, wk1i, wk2r, wk2i, wk3r, wk3i;
   float x0r, x0i, x1r, x1i, x2r, x2i, x3r, x3i;
@@ -457,7 +515,7 @@ void cft1st (int n, float *a, float *w) {
 }
 
 
-void cftmdl (int n, int l, float *a, float *w) {
+void cftmdl (int n, int l, float *a, const float *w) {
   int j, j1, j2, j3, k, k1, k2, m, m2;
   float wk1r, wk1i, wk2r, wk2i, wk3r, wk3i;
   float x0r, x0i, x1r, x1i, x2r, x2i, x3r, x3i;
@@ -583,7 +641,7 @@ void cftmdl (int n, int l, float *a, float *w) {
 }
 
 
-void rftfsub (int n, float *a, int nc, float *c) {
+void rftfsub (int n, float *a, int nc, const float *c) {
   int j, k, kk, ks, m;
   float wkr, wki, xr, xi, yr, yi;
 
@@ -607,7 +665,7 @@ void rftfsub (int n, float *a, int nc, float *c) {
 }
 
 
-void rftbsub (int n, float *a, int nc, float *c) {
+void rftbsub (int n, float *a, int nc, const float *c) {
   int j, k, kk, ks, m;
   float wkr, wki, xr, xi, yr, yi;
 
@@ -632,25 +690,20 @@ void rftbsub (int n, float *a, int nc, float *c) {
   a[m + 1] = -a[m + 1];
 }
 
-void actrdft (int n, int isgn, float *a, int *ip, float *w) {
-  int nw, nc, i;
+/* Real FFT (isgn>=0) or inverse (isgn<0) with complete tables (read only) */
+static void rdftexec (int n, int isgn, float *a, const int *ip, int nw, int nc, const float *w) {
+  void cftfsub_simd (int n, float *a, const float *w);
+  void cftbsub_simd (int n, float *a, const float *w);
+  void rftfsub_simd (int n, float *a, int nc, const float *c);
+  void rftbsub_simd (int n, float *a, int nc, const float *c);
+  int i;
   float xi;
 
-  nw = ip[0];
-  if (n > (nw << 2)) {
-    nw = n >> 2;
-    makewt (nw, ip, w);
-  }
-  nc = ip[1];
-  if (n > (nc << 2)) {
-    nc = n >> 2;
-    makect (nc, ip, w + nw);
-  }
   if (isgn >= 0) {
     if (n > 4) {
-      bitrv2 (n, ip + 2, a);
-      cftfsub (n, a, w);
-      rftfsub (n, a, nc, w + nw);
+      bitrv2perm (n, ip + 2, a);
+      cftfsub_simd (n, a, w);
+      rftfsub_simd (n, a, nc, w + nw);
     } else if (n == 4) {
       cftfsub (n, a, w);
     }
@@ -661,9 +714,9 @@ void actrdft (int n, int isgn, float *a, int *ip, float *w) {
     a[1] = (float) 0.5 *(a[0] - a[1]);
     a[0] -= a[1];
     if (n > 4) {
-      rftbsub (n, a, nc, w + nw);
-      bitrv2 (n, ip + 2, a);
-      cftbsub (n, a, w);
+      rftbsub_simd (n, a, nc, w + nw);
+      bitrv2perm (n, ip + 2, a);
+      cftbsub_simd (n, a, w);
     } else if (n == 4) {
       cftfsub (n, a, w);
     }
@@ -673,6 +726,128 @@ void actrdft (int n, int isgn, float *a, int *ip, float *w) {
       a[i] *= xi;
   }
 }
+
+
+void actrdft (int n, int isgn, float *a, int *ip, float *w) {
+  int nw, nc;
+
+  FFT_ISA_INIT ();
+  nw = ip[0];
+  if (n > (nw << 2)) {
+    nw = n >> 2;
+    makewt (nw, ip, w);
+  }
+  nc = ip[1];
+  if (n > (nc << 2)) {
+    nc = n >> 2;
+    makect (nc, ip, w + nw);
+  }
+  if (n > 4)
+    bitrv2tab (n, ip + 2);
+  rdftexec (n, isgn, a, ip, nw, nc, w);
+}
+
+
+/* -------- FFT plans -------- */
+
+FFT_PLAN *fft_plan_create (int n) {
+  FFT_PLAN *plan;
+  int nip;
+
+  /* Even sizes only */
+  if (n < 2 || n > (1 << FFT_PLAN_LOG2MAX) || n % 2 != 0)
+    return NULL;
+
+  plan = (FFT_PLAN *) calloc (1, sizeof (FFT_PLAN));
+  if (plan == NULL)
+    return NULL;
+  plan->n = n;
+  FFT_ISA_INIT ();
+
+  /* Not a power of 2: mixed-radix tables */
+  if ((n & (n - 1)) != 0) {
+    if ((plan->mr = fft_mr_create (n)) == NULL) {
+      fft_plan_free (plan);
+      return NULL;
+    }
+    return plan;
+  }
+
+  /* Bit-reversal table: 2+sqrt(n/2) ints */
+  nip = 2 + (int) sqrt ((double) (n / 2)) + 1;
+
+  plan->ip = (int *) calloc (nip, sizeof (int));
+  plan->w = (float *) malloc ((n / 2 + 1) * sizeof (float));
+  if (plan->ip == NULL || plan->w == NULL) {
+    fft_plan_free (plan);
+    return NULL;
+  }
+
+  /* Same tables as actrdft() computes at its first call for n */
+  plan->nw = n >> 2;
+  plan->nc = n >> 2;
+  makewt (plan->nw, plan->ip, plan->w);
+  makect (plan->nc, plan->ip, plan->w + plan->nw);
+  if (n > 4)
+    bitrv2tab (n, plan->ip + 2);
+
+  return plan;
+}
+
+
+void fft_plan_free (FFT_PLAN * plan) {
+  if (plan == NULL)
+    return;
+  free (plan->ip);
+  free (plan->w);
+  fft_mr_free (plan->mr);
+  free (plan);
+}
+
+
+const FFT_PLAN *fft_plan_get (int n) {
+  FFT_PLAN *plan;
+  int k;
+
+  if (n < 2 || n > (1 << FFT_PLAN_LOG2MAX) || n % 2 != 0)
+    return NULL;
+  for (k = 0; (1 << k) < n; k++);
+
+#ifdef FFT_PTHREADS
+  pthread_mutex_lock (&fft_plan_lock);
+#endif
+  if ((1 << k) == n) {
+    if ((plan = fft_plan_cache[k]) == NULL)
+      plan = fft_plan_cache[k] = fft_plan_create (n);
+  } else {
+    for (plan = fft_plan_list; plan != NULL && plan->n != n; plan = plan->next);
+    if (plan == NULL && (plan = fft_plan_create (n)) != NULL) {
+      plan->next = fft_plan_list;
+      fft_plan_list = plan;
+    }
+  }
+#ifdef FFT_PTHREADS
+  pthread_mutex_unlock (&fft_plan_lock);
+#endif
+
+  return plan;
+}
+
+
+int fft_plan_exec_real (const FFT_PLAN * plan, float *a) {
+  if (plan->mr)
+    return fft_mr_exec (plan->mr, 1, a);
+  rdftexec (plan->n, 1, a, plan->ip, plan->nw, plan->nc, plan->w);
+  return 0;
+}
+
+
+int fft_plan_exec_inverse (const FFT_PLAN * plan, float *a) {
+  if (plan->mr)
+    return fft_mr_exec (plan->mr, -1, a);
+  rdftexec (plan->n, -1, a, plan->ip, plan->nw, plan->nc, plan->w);
+  return 0;
+}
 #endif
 
 void genHanning (int n, float *hanning) {
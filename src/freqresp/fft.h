@@ -1,4 +1,4 @@
-/*                                                          15.Feb.2010 v1.3 */
+/*                                                          16.Oct.2026 v1.7 */
 /*=============================================================================
 
                           U    U   GGG    SSSS  TTTTT
@@ -32,6 +32,12 @@
                   -nfft : indicates the number of points used in FFT.
   15.Feb.10 v1.3  Modified maximum string length for filename, and
 	                removed some macros (OVERLAP, VAR_NFFT)
+  16.Oct.26 v1.4  Exported actrdft() (FFT convolution in the FIR module)
+  16.Oct.26 v1.5  Reentrant FFT plans (FFT_PLAN): tables computed once per
+                  size, cached, read-only during the transforms
+  16.Oct.26 v1.6  SSE2/AVX butterflies (fft-simd.c), fft_isa()
+  16.Oct.26 v1.7  NFFT_MAX raised to 65536; plans of any even size
+                  (mixed radix 2/3/4/5 or Bluestein, fft-mr.c)
 
   AUTHORS :
 	Cyril Guillaume & Stephane Ragot -- stephane.ragot@francetelecom.com
@@ -43,7 +49,7 @@
 #define TUNED_FFT
 
 /* Number of points of the FFT */
-#define NFFT_MAX 8192
+#define NFFT_MAX 65536
 #define pi 3.141592654
 
 /* This routine generate a hanning window */
@@ -68,5 +74,43 @@ void powSpect (float *real,     /* input buffer containing the real part of the
   );
 
 #else
+/* FFT plan: tables of the real FFT of one size n, read-only once created,
+   so that a plan can be shared between threads. Powers of 2 use the
+   split-radix FFT (ip, w), other even sizes the mixed-radix FFT (mr) */
+typedef struct fft_plan {
+  int n;                        /* FFT size */
+  int nw;                       /* number of cos/sin pairs in w[] (n/4) */
+  int nc;                       /* number of cos values after them (n/4) */
+  int *ip;                      /* ip[0]=nw, ip[1]=nc, ip+2: bit-reversal table of n */
+  float *w;                     /* cos/sin table, n/2 values */
+  struct fft_mrplan *mr;        /* tables of fft-mr.c if n is not a power of 2 */
+  struct fft_plan *next;        /* next plan in the cache of fft_plan_get() */
+} FFT_PLAN;
+
+/* Create/free a plan of size n (even, n>=2); NULL if n is invalid or out of memory */
+FFT_PLAN *fft_plan_create (int n);
+void fft_plan_free (FFT_PLAN * plan);
+
+/* Shared plan of size n, created at the first call and kept until the end of the program */
+const FFT_PLAN *fft_plan_get (int n);
+
+/* Real FFT in place, packed as by actrdft(), and its inverse (scaled by 2/n);
+   0, or -1 if out of memory (work memory of sizes that are not powers of 2) */
+int fft_plan_exec_real (const FFT_PLAN * plan, float *a);
+int fft_plan_exec_inverse (const FFT_PLAN * plan, float *a);
+
+/* Instruction sets of the FFT (fft-simd.c); the results are the same with all of them */
+#define FFT_ISA_AUTO  -1        /* best instruction set of the processor */
+#define FFT_ISA_C      0        /* portable C */
+#define FFT_ISA_SSE2   1
+#define FFT_ISA_AVX    2
+
+/* Select the highest instruction set used by all FFTs; returns the one actually used */
+int fft_isa (int max_isa);
+
+/* Power spectrum x2[0..m/2] of the m samples of x1 (overwritten by their FFT) */
 void powSpect (int m, float *x1, float *x2);
+
+/* Split-radix real FFT (isgn>=0) or its inverse (isgn<0, scaled by 2/n) in place; ip[0]=0 for a new table */
+void actrdft (int n, int isgn, float *a, int *ip, float *w);
 #endif
@@ -1,4 +1,4 @@
-/*                                                          15.Feb.2010 v1.3 */
+/*                                                          16.Oct.2026 v1.6 */
 /*=============================================================================
 
                           U    U   GGG    SSSS  TTTTT
@@ -32,6 +32,16 @@
                   -nfft : indicates the number of points used in FFT.
   15.Feb.10 v1.3  Modified maximum string length for filename, and
 	                removed some macros (OVERLAP, VAR_NFFT)
+  16.Oct.26 v1.4  New option:
+                  -isa  : highest instruction set of the FFT (tests)
+  16.Oct.26 v1.5  -nfft accepts any even size up to NFFT_MAX (65536),
+                  e.g. 960 for 20 ms frames at 48 kHz; buffers of nfft
+                  samples allocated at run time
+  16.Oct.26 v1.6  New option:
+                  -threads : average ranges of frames of both files in
+                             parallel threads (long recordings); the
+                             averages differ from the serial ones by
+                             rounding only (0.01 dB in the ASCII output)
 
   AUTHORS :
 	Cyril Guillaume & Stephane Ragot -- stephane.ragot@francetelecom.com
@@ -46,6 +56,11 @@
 #include <string.h>
 #include <math.h>
 
+#ifdef FREQRESP_PTHREADS
+#include <pthread.h>
+#include <unistd.h>
+#endif
+
 #include "fft.h"
 #include "export.h"
 #include "bmp_utils.h"
@@ -58,6 +73,21 @@
 #define max(a,b)    (((a) > (b)) ? (a) : (b))
 #endif
 
+/* Max.number of threads of the option -threads */
+#define FREQRESP_MAXTHREADS 64
+
+/* A range of frames of one input file, averaged by one thread */
+typedef struct {
+  const char *fname;            /* name of the input file */
+  long first;                   /* index of the 1st frame of the range */
+  long count;                   /* number of frames of the range */
+  int nfft;                     /* number of samples of a frame */
+  int hop;                      /* number of samples between 2 frames */
+  const float *hanning;         /* hanning window (shared) */
+  double *sum;                  /* sum of the power spectra of the frames */
+  int err;                      /* 1 if the range could not be processed */
+} FRAME_RANGE;
+
 static int is_little_endian () {
   /* Hex version of the string ABCD */
   unsigned long tmp = 0x41424344;
@@ -67,7 +97,7 @@ static int is_little_endian () {
 }
 
 static void display_usage () {
-  printf ("FREQRESP.C - Version 1.3 of 15.Feb.2010 \n\n");
+  printf ("FREQRESP.C - Version 1.6 of 16.Oct.2026 \n\n");
 
   printf (" Frequency response measure program\n");
   printf (" This program computes the average power spectrum \n");
@@ -100,18 +130,156 @@ static void display_usage () {
   printf ("                  is 10dB);\n");
   printf ("  -ov    ov ..... ov is the overlap (%c) between two consecutive frames for\n", '%');
   printf ("                  computing the average power spectrum (default is 0%c);\n", '%');
-  printf ("  -nfft  nfft ... nfft is the number of samples in each FFT (default is 2048).\n\n");
+  printf ("  -nfft  nfft ... nfft is the number of samples in each FFT, even, 16 to %d\n", NFFT_MAX);
+  printf ("                  (default is 2048);\n");
+  printf ("  -isa   n ...... highest instruction set of the FFT: 0=C, 1=SSE2, 2=AVX\n");
+  printf ("                  (default is the best available; same results);\n");
+  printf ("  -threads n .... split both files in ranges of frames averaged by up to n\n");
+  printf ("                  threads, 0 for the number of CPUs (default is 1: serial\n");
+  printf ("                  running average); the averages differ from the serial\n");
+  printf ("                  ones by rounding only, i.e. by at most 0.01 dB in the\n");
+  printf ("                  ASCII output.\n\n");
+}
+
+
+/* Sum of the power spectra of a range of frames (thread function) */
+static void *sum_frames (void *arg) {
+  FRAME_RANGE *r = (FRAME_RANGE *) arg;
+  float *frame, *powSp;
+  short *frame_sh;
+  FILE *fp;
+  long f;
+  int i;
+
+  frame = (float *) malloc (r->nfft * sizeof (float));
+  frame_sh = (short *) malloc (r->nfft * sizeof (short));
+  powSp = (float *) malloc ((r->nfft / 2 + 1) * sizeof (float));
+  fp = fopen (r->fname, "rb");
+  r->err = frame == NULL || frame_sh == NULL || powSp == NULL || fp == NULL || fseek (fp, r->first * r->hop * (long) sizeof (short), SEEK_SET) != 0;
+
+  for (f = 0; f < r->count && !r->err; f++) {
+    if (fread (frame_sh, sizeof (short), r->nfft, fp) != (size_t) r->nfft) {
+      r->err = 1;
+      break;
+    }
+
+    /* Same processing as the serial loop of main() */
+    sh2fl (r->nfft, frame_sh, frame, 16, 1);
+    for (i = 0; i < r->nfft; i++)
+      frame[i] = frame[i] * r->hanning[i];
+    powSpect (r->nfft, frame, powSp);
+    for (i = 0; i < r->nfft / 2; i++)
+      r->sum[i] += powSp[i];
+
+    /* Overlap: back to the start of the next frame */
+    fseek (fp, -(long) (r->nfft - r->hop) * (long) sizeof (short), SEEK_CUR);
+  }
+
+  if (fp != NULL)
+    fclose (fp);
+  free (frame);
+  free (frame_sh);
+  free (powSp);
+  return NULL;
+}
+
+
+/* Average power spectra of 2 files, by up to nthreads threads: each file is
+   split in ranges of frames, all the ranges of both files are processed at
+   the same time, and their sums are added at the end. Returns 0, or -1 if
+   out of memory or if a file could not be read. */
+static int average_parallel (char *fname[2], float *avgPowSp[2], int nfft, int hop, const float *hanning, int nthreads) {
+  FRAME_RANGE *range;
+  double *sums, sum;
+  long nframes[2], nbytes;
+  int nrange[2], nt, f, p, q, i, err = 0;
+  FILE *fp;
+#ifdef FREQRESP_PTHREADS
+  pthread_t tid[FREQRESP_MAXTHREADS];
+  char started[FREQRESP_MAXTHREADS];
+
+  if (nthreads <= 0)
+    nthreads = (int) sysconf (_SC_NPROCESSORS_ONLN);
+#endif
+  if (nthreads < 2)
+    nthreads = 2;
+  if (nthreads > FREQRESP_MAXTHREADS)
+    nthreads = FREQRESP_MAXTHREADS;
+
+  /* Number of frames of each file (as many as the serial loop reads), and ranges of frames: half of the threads per file */
+  for (f = 0; f < 2; f++) {
+    if ((fp = fopen (fname[f], "rb")) == NULL) {
+      fprintf (stderr, "Error: Can't open input file %s", fname[f]);
+      exit (-1);
+    }
+    fseek (fp, 0L, SEEK_END);
+    nbytes = ftell (fp);
+    fclose (fp);
+    nframes[f] = (nbytes / (long) sizeof (short) >= nfft) ? (nbytes / (long) sizeof (short) - nfft) / hop + 1 : 0;
+    nt = (f == 0) ? nthreads / 2 : nthreads - nthreads / 2;
+    nrange[f] = (nframes[f] < nt) ? (int) nframes[f] : nt;
+  }
+
+  range = (FRAME_RANGE *) malloc ((nrange[0] + nrange[1] + 1) * sizeof (FRAME_RANGE));
+  sums = (double *) calloc ((nrange[0] + nrange[1] + 1) * (nfft / 2), sizeof (double));
+  if (range == NULL || sums == NULL) {
+    free (range);
+    free (sums);
+    return -1;
+  }
+  for (f = 0, q = 0; f < 2; f++)
+    for (p = 0; p < nrange[f]; p++, q++) {
+      range[q].fname = fname[f];
+      range[q].first = nframes[f] * p / nrange[f];
+      range[q].count = nframes[f] * (p + 1) / nrange[f] - range[q].first;
+      range[q].nfft = nfft;
+      range[q].hop = hop;
+      range[q].hanning = hanning;
+      range[q].sum = sums + q * (nfft / 2);
+      range[q].err = 0;
+    }
+
+  /* Process all the ranges; the calling thread processes the 1st one */
+#ifdef FREQRESP_PTHREADS
+  for (p = 1; p < q; p++)
+    started[p] = pthread_create (&tid[p], NULL, sum_frames, &range[p]) == 0;
+  if (q > 0)
+    sum_frames (&range[0]);
+  for (p = 1; p < q; p++)
+    if (started[p])
+      pthread_join (tid[p], NULL);
+    else
+      sum_frames (&range[p]);
+#else
+  for (p = 0; p < q; p++)
+    sum_frames (&range[p]);
+#endif
+
+  /* Average power spectrum of each file: sum of its ranges divided by its number of frames */
+  for (f = 0, q = 0; f < 2; q += nrange[f], f++) {
+    for (p = 0; p < nrange[f]; p++)
+      err |= range[q + p].err;
+    for (i = 0; i < nfft / 2; i++) {
+      for (sum = 0, p = 0; p < nrange[f]; p++)
+        sum += range[q + p].sum[i];
+      avgPowSp[f][i] = (nframes[f] > 0) ? (float) (sum / nframes[f]) : 0;
+    }
+  }
+
+  free (range);
+  free (sums);
+  return err ? -1 : 0;
 }
 
 int main (int argc, char *argv[]) {
   /* .... DECLARATIONS ..... */
   /* buffers */
-  float frame[NFFT_MAX];        /* Frame of the input signal (float format) */
-  short frame_sh[NFFT_MAX];     /* Frame of the input signal (short format) */
-  float hanning[NFFT_MAX];      /* hanning window */
-  float powSp[NFFT_MAX];        /* Power spectrum of a frame */
-  float avg1PowSp[NFFT_MAX / 2];        /* Average Power spectrum vector for the first input file */
-  float avg2PowSp[NFFT_MAX / 2];        /* Average Power spectrum vector for the second input file */
+  float *frame;                 /* Frame of the input signal (float format) */
+  short *frame_sh;              /* Frame of the input signal (short format) */
+  float *hanning;               /* hanning window */
+  float *powSp;                 /* Power spectrum of a frame */
+  float *avg1PowSp;             /* Average Power spectrum vector for the first input file */
+  float *avg2PowSp;             /* Average Power spectrum vector for the second input file */
 
   /* file variables */
   FILE *fp;                     /* file pointer */
@@ -129,6 +297,8 @@ int main (int argc, char *argv[]) {
   int nbread;
   long nbFrame = 0;
   int bmp_mode = 0;
+  int nthreads = 1;             /* threads of the average power spectra */
+  int max_isa = FFT_ISA_AUTO;   /* highest instruction set of the FFT */
   int border = 40;
   int im_wdth = nfft / 2 + border;
   int im_hght = (int) ((nfft / 2 + border) / 1.25);
@@ -215,6 +385,24 @@ int main (int argc, char *argv[]) {
         fstep = atol (argv[2]);
         bmp_mode = 1;
 
+        /* Move arg{c,v} over the option to the next argument */
+        argc -= 2;
+        argv += 2;
+      } else if (strcmp (argv[1], "-threads") == 0) {
+        /* Average ranges of frames in parallel threads */
+        nthreads = atoi (argv[2]);
+        if (nthreads < 0) {
+          fprintf (stderr, "ERROR! Bad number of threads.\n\n");
+          exit (-1);
+        }
+
+        /* Move arg{c,v} over the option to the next argument */
+        argc -= 2;
+        argv += 2;
+      } else if (strcmp (argv[1], "-isa") == 0) {
+        /* Limit the instruction set of the FFT */
+        max_isa = atoi (argv[2]);
+
         /* Move arg{c,v} over the option to the next argument */
         argc -= 2;
         argv += 2;
@@ -238,9 +426,8 @@ int main (int argc, char *argv[]) {
       } else if (strcmp (argv[1], "-nfft") == 0) {
         /* Get the number of samples involved in each FFT */
         nfft = (int) atof (argv[2]);
-        if ((nfft < 16) || (nfft > NFFT_MAX)
-            || (nfft != 16 && nfft != 32 && nfft != 64 && nfft != 128 && nfft != 256 && nfft != 512 && nfft != 1024 && nfft != 2048 && nfft != 4096 && nfft != 8192)) {
-          fprintf (stderr, "ERROR! Bad nfft parameter (must be a power of 2 inferior to %d).\n\n", NFFT_MAX);
+        if ((nfft < 16) || (nfft > NFFT_MAX) || (nfft % 2 != 0)) {
+          fprintf (stderr, "ERROR! Bad nfft parameter (must be even, from 16 to %d).\n\n", NFFT_MAX);
           exit (-1);
         }
         /* 1064x851 was the original size (with nfft=2048), for lower nfft values, it is better to keep these dimensions for better visual quality. */
@@ -265,6 +452,21 @@ int main (int argc, char *argv[]) {
 
 
   /* ..... INITIALIZATIONS ..... */
+  /* instruction set of the FFT, selected before any thread runs an FFT */
+  fft_isa (max_isa);
+
+  /* allocate the buffers of nfft samples */
+  frame = (float *) malloc (nfft * sizeof (float));
+  frame_sh = (short *) malloc (nfft * sizeof (short));
+  hanning = (float *) malloc (nfft * sizeof (float));
+  powSp = (float *) malloc ((nfft / 2 + 1) * sizeof (float));
+  avg1PowSp = (float *) malloc (nfft / 2 * sizeof (float));
+  avg2PowSp = (float *) malloc (nfft / 2 * sizeof (float));
+  if (frame == NULL || frame_sh == NULL || hanning == NULL || powSp == NULL || avg1PowSp == NULL || avg2PowSp == NULL) {
+    fprintf (stderr, "Error: Can't allocate buffers of %d samples\n", nfft);
+    exit (-1);
+  }
+
   /* initialize the average power spectrum vector */
   for (i = 0; i < nfft / 2; i++) {
     avg1PowSp[i] = 0;
@@ -277,89 +479,104 @@ int main (int argc, char *argv[]) {
 
   /* ..... PROCESSING ..... */
 
-  /* ..... First File ..... */
-  /* open first input file */
-  fp = fopen (in1FileName, "rb");
-  if (fp == NULL) {
-    fprintf (stderr, "Error: Can't open input file %s", in1FileName);
-    exit (-1);
-  }
+  if (nthreads != 1) {
+    /* ..... Both Files, Ranges of Frames in Parallel Threads ..... */
+    char *fname[2];
+    float *avgPowSp[2];
+
+    fname[0] = in1FileName;
+    fname[1] = in2FileName;
+    avgPowSp[0] = avg1PowSp;
+    avgPowSp[1] = avg2PowSp;
+    if (average_parallel (fname, avgPowSp, nfft, nfft - nb_samples_ov, hanning, nthreads) != 0) {
+      fprintf (stderr, "Error: Can't read the input files or allocate the buffers\n");
+      exit (-1);
+    }
+  } else {
+    /* ..... First File ..... */
+    /* open first input file */
+    fp = fopen (in1FileName, "rb");
+    if (fp == NULL) {
+      fprintf (stderr, "Error: Can't open input file %s", in1FileName);
+      exit (-1);
+    }
 
-  /* loop over first input file */
-  while ((nbread = fread (frame_sh, sizeof (short), nfft, fp)) == nfft) {
-    /* increment the number of processed frames */
-    nbFrame++;
+    /* loop over first input file */
+    while ((nbread = fread (frame_sh, sizeof (short), nfft, fp)) == nfft) {
+      /* increment the number of processed frames */
+      nbFrame++;
 
-    /* convert short format input, into 16 bit float */
-    sh2fl (nfft, frame_sh, frame, 16, 1);
+      /* convert short format input, into 16 bit float */
+      sh2fl (nfft, frame_sh, frame, 16, 1);
 
-    /* Hanning Windowing */
-    for (i = 0; i < nfft; i++) {
-      frame[i] = frame[i] * hanning[i];
-    }
+      /* Hanning Windowing */
+      for (i = 0; i < nfft; i++) {
+        frame[i] = frame[i] * hanning[i];
+      }
 
 #ifndef TUNED_FFT
-    /* Real Discret Fourier Transform */
-    rdft (nfft, frame, real, imag);
-    /* Power spectrum computation */
-    powSpect (real, imag, powSp, nfft);
+      /* Real Discret Fourier Transform */
+      rdft (nfft, frame, real, imag);
+      /* Power spectrum computation */
+      powSpect (real, imag, powSp, nfft);
 #else
-    powSpect (nfft, frame, powSp);
+      powSpect (nfft, frame, powSp);
 #endif
 
-    /* average power spectrum computation */
-    for (i = 0; i < nfft / 2; i++) {
-      avg1PowSp[i] = avg1PowSp[i] + (powSp[i] - avg1PowSp[i]) / nbFrame;
-    }
+      /* average power spectrum computation */
+      for (i = 0; i < nfft / 2; i++) {
+        avg1PowSp[i] = avg1PowSp[i] + (powSp[i] - avg1PowSp[i]) / nbFrame;
+      }
 
-    /* For overlapping, reposition the file pointer nb_samples_ov samples before its current position */
-    fseek (fp, -nb_samples_ov * 2, SEEK_CUR);
-  }
-  /* close input file */
-  fclose (fp);
+      /* For overlapping, reposition the file pointer nb_samples_ov samples before its current position */
+      fseek (fp, -nb_samples_ov * 2, SEEK_CUR);
+    }
+    /* close input file */
+    fclose (fp);
 
 
-  /* ..... Second File ..... */
+    /* ..... Second File ..... */
 
-  /* open second input file */
-  fp = fopen (in2FileName, "rb");
-  if (fp == NULL) {
-    fprintf (stderr, "Error: Can't open input file %s", in2FileName);
-    exit (-1);
-  }
+    /* open second input file */
+    fp = fopen (in2FileName, "rb");
+    if (fp == NULL) {
+      fprintf (stderr, "Error: Can't open input file %s", in2FileName);
+      exit (-1);
+    }
 
-  nbFrame = 0;
-  /* loop over first input file */
-  while ((nbread = fread (frame_sh, sizeof (short), nfft, fp)) == nfft) {
-    /* increment the number of processed frames */
-    nbFrame++;
+    nbFrame = 0;
+    /* loop over first input file */
+    while ((nbread = fread (frame_sh, sizeof (short), nfft, fp)) == nfft) {
+      /* increment the number of processed frames */
+      nbFrame++;
 
-    /* convert short format input, into 16 bit float */
-    sh2fl (nfft, frame_sh, frame, 16, 1);
+      /* convert short format input, into 16 bit float */
+      sh2fl (nfft, frame_sh, frame, 16, 1);
 
-    /* Hanning Windowing */
-    for (i = 0; i < nfft; i++) {
-      frame[i] = frame[i] * hanning[i];
-    }
+      /* Hanning Windowing */
+      for (i = 0; i < nfft; i++) {
+        frame[i] = frame[i] * hanning[i];
+      }
 #ifndef TUNED_FFT
-    /* Real Discret Fourier Transform */
-    rdft (nfft, frame, real, imag);
-    /* Power spectrum computation */
-    powSpect (real, imag, powSp, nfft);
+      /* Real Discret Fourier Transform */
+      rdft (nfft, frame, real, imag);
+      /* Power spectrum computation */
+      powSpect (real, imag, powSp, nfft);
 #else
-    powSpect (nfft, frame, powSp);
+      powSpect (nfft, frame, powSp);
 #endif
 
-    /* average power spectrum computation */
-    for (i = 0; i < nfft / 2; i++) {
-      avg2PowSp[i] = avg2PowSp[i] + (powSp[i] - avg2PowSp[i]) / nbFrame;
-    }
+      /* average power spectrum computation */
+      for (i = 0; i < nfft / 2; i++) {
+        avg2PowSp[i] = avg2PowSp[i] + (powSp[i] - avg2PowSp[i]) / nbFrame;
+      }
 
-    /* For overlapping, reposition the file pointer nb_samples_ov samples before its current position */
-    fseek (fp, -nb_samples_ov * 2, SEEK_CUR);
+      /* For overlapping, reposition the file pointer nb_samples_ov samples before its current position */
+      fseek (fp, -nb_samples_ov * 2, SEEK_CUR);
+    }
+    /* close input file */
+    fclose (fp);
   }
-  /* close input file */
-  fclose (fp);
 
 
   /* .... Save Average Power Spectrum .... */
@@ -402,7 +619,12 @@ int main (int argc, char *argv[]) {
     printf (" >> Pstep : %2.2f dB\n", pstep);
   }
 
-
+  free (frame);
+  free (frame_sh);
+  free (hanning);
+  free (powSp);
+  free (avg1PowSp);
+  free (avg2PowSp);
 
   return 0;
 }
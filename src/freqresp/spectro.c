@@ -0,0 +1,237 @@
+/*                                                          16.Oct.2026 v1.0 */
+/*=============================================================================
+
+                          U    U   GGG    SSSS  TTTTT
+                          U    U  G       S       T
+                          U    U  G  GG   SSSS    T
+                          U    U  G   G       S   T
+                           UUU     GG     SSS     T
+
+                   ========================================
+                    ITU-T - USER'S GROUP ON SOFTWARE TOOLS
+                   ========================================
+
+       =============================================================
+       COPYRIGHT NOTE: This source code, and all of its derivations,
+       is subject to the "ITU-T General Public License". Please have
+       it  read  in    the  distribution  disk,   or  in  the  ITU-T
+       Recommendation G.191 on "SOFTWARE TOOLS FOR SPEECH AND  AUDIO
+       CODING STANDARDS".
+       =============================================================
+
+  DESCRIPTION :
+	This file contains a demonstration program of the streaming STFT of
+  stft.h: the power spectrogram of a 16 bit file is written as a binary
+  matrix of floats, one row of nfft/2+1 values per frame (bins 0 to fs/2),
+  without header, in the byte order of the host. The input is read by
+  blocks, so that files of any length can be analysed with bounded memory.
+
+  HISTORY :
+  16.Oct.26 v1.0  Created.
+*/
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "stft.h"
+
+/* UGST modules */
+#include "ugstdemo.h"
+#include "ugst-utl.c"
+
+static void display_usage () {
+  printf ("SPECTRO.C - Version 1.0 of 16.Oct.2026 \n\n");
+
+  printf (" Spectrogram program\n");
+  printf (" This program computes the power spectra of the successive frames\n");
+  printf (" of a file and saves them as a binary matrix of floats.\n");
+  printf ("\n");
+  printf (" Usage:\n");
+  printf (" $ spectro   [-options] FileIn FileOut\n");
+  printf (" where:\n");
+  printf ("  FileIn         is the input file (16 bit samples);\n");
+  printf ("  FileOut        is the output file: one row of nfft/2+1 floats per frame;\n");
+  printf ("\n");
+  printf (" Options:\n");
+  printf ("  -nfft  nfft ... nfft is the number of samples in each FFT, even, 16 to %d\n", NFFT_MAX);
+  printf ("                  (default is 2048);\n");
+  printf ("  -hop   hop .... hop is the number of samples between 2 frames (default is\n");
+  printf ("                  nfft/2);\n");
+  printf ("  -rect ......... rectangular window instead of the Hanning window;\n");
+  printf ("  -db ........... power in dB (10*log10) instead of linear power;\n");
+  printf ("  -blk   blk .... blk is the number of samples read at a time (default is\n");
+  printf ("                  16384; same results for any value);\n");
+  printf ("  -q ............ quiet operation.\n\n");
+}
+
+int main (int argc, char *argv[]) {
+  /* .... DECLARATIONS ..... */
+  /* buffers */
+  short *blk_sh;                /* Block of the input signal (short format) */
+  float *blk;                   /* Block of the input signal (float format) */
+  float *win = NULL;            /* Window, if not Hanning */
+  float *pow;                   /* Power spectra of the frames of a block */
+
+  /* file variables */
+  FILE *fpin, *fpout;
+  char inFileName[MAX_STRLEN];  /* name of the input file */
+  char outFileName[MAX_STRLEN]; /* name of the output file */
+
+  /* algorithm variables */
+  STFT_STATE *st;
+  int nfft = 2048;
+  int hop = 0;
+  long lblk = 16384;
+  int rect = 0, db = 0, quiet = 0;
+  long nbread, nfr, i;
+  long nbFrame = 0;
+
+
+  /* ......... GET PARAMETERS ......... */
+
+  /* Check options */
+  if (argc < 3)
+    display_usage ();
+  else {
+    while (argc > 1 && argv[1][0] == '-')
+      if (strcmp (argv[1], "-nfft") == 0) {
+        /* Get the number of samples involved in each FFT */
+        nfft = atoi (argv[2]);
+        if ((nfft < 16) || (nfft > NFFT_MAX) || (nfft % 2 != 0)) {
+          fprintf (stderr, "ERROR! Bad nfft parameter (must be even, from 16 to %d).\n\n", NFFT_MAX);
+          exit (-1);
+        }
+
+        /* Move arg{c,v} over the option to the next argument */
+        argc -= 2;
+        argv += 2;
+      } else if (strcmp (argv[1], "-hop") == 0) {
+        /* Get the number of samples between 2 frames */
+        hop = atoi (argv[2]);
+        if (hop < 1) {
+          fprintf (stderr, "ERROR! Bad hop parameter.\n\n");
+          exit (-1);
+        }
+
+        /* Move arg{c,v} over the option to the next argument */
+        argc -= 2;
+        argv += 2;
+      } else if (strcmp (argv[1], "-blk") == 0) {
+        /* Get the number of samples read at a time */
+        lblk = atol (argv[2]);
+        if (lblk < 1) {
+          fprintf (stderr, "ERROR! Bad block size.\n\n");
+          exit (-1);
+        }
+
+        /* Move arg{c,v} over the option to the next argument */
+        argc -= 2;
+        argv += 2;
+      } else if (strcmp (argv[1], "-rect") == 0) {
+        /* Rectangular window */
+        rect = 1;
+
+        /* Move arg{c,v} over the option to the next argument */
+        argc--;
+        argv++;
+      } else if (strcmp (argv[1], "-db") == 0) {
+        /* Power in dB */
+        db = 1;
+
+        /* Move arg{c,v} over the option to the next argument */
+        argc--;
+        argv++;
+      } else if (strcmp (argv[1], "-q") == 0) {
+        /* Quiet operation */
+        quiet = 1;
+
+        /* Move arg{c,v} over the option to the next argument */
+        argc--;
+        argv++;
+      } else if (strcmp (argv[1], "-h") == 0 || strcmp (argv[1], "-?") == 0) {
+        /* Display help message */
+        display_usage ();
+        exit (2);
+      } else {
+        fprintf (stderr, "ERROR! Invalid option \"%s\" in command line\n\n", argv[1]);
+        display_usage ();
+        exit (-1);
+      }
+  }
+
+  /* Read parameters for processing */
+  GET_PAR_S (1, "_Input File: ...................... ", inFileName);
+  GET_PAR_S (2, "_Output File: ..................... ", outFileName);
+  if (hop == 0)
+    hop = nfft / 2;
+
+
+  /* ..... INITIALIZATIONS ..... */
+  if (rect) {
+    if ((win = (float *) malloc (nfft * sizeof (float))) == NULL) {
+      fprintf (stderr, "Error: Can't allocate the window\n");
+      exit (-1);
+    }
+    for (i = 0; i < nfft; i++)
+      win[i] = 1;
+  }
+  st = stft_init (nfft, hop, win);
+  free (win);
+
+  /* block buffers, and power spectra of the frames of a block */
+  blk_sh = (short *) malloc (lblk * sizeof (short));
+  blk = (float *) malloc (lblk * sizeof (float));
+  pow = (st == NULL) ? NULL : (float *) malloc ((lblk / hop + 1) * st->nbins * sizeof (float));
+  if (st == NULL || blk_sh == NULL || blk == NULL || pow == NULL) {
+    fprintf (stderr, "Error: Can't allocate the STFT of %d points\n", nfft);
+    exit (-1);
+  }
+
+  if ((fpin = fopen (inFileName, "rb")) == NULL) {
+    fprintf (stderr, "Error: Can't open input file %s\n", inFileName);
+    exit (-1);
+  }
+  if ((fpout = fopen (outFileName, "wb")) == NULL) {
+    fprintf (stderr, "Error: Can't open output file %s\n", outFileName);
+    exit (-1);
+  }
+
+
+  /* ..... PROCESSING ..... */
+  while ((nbread = (long) fread (blk_sh, sizeof (short), lblk, fpin)) > 0) {
+    /* convert short format input, into 16 bit float */
+    sh2fl (nbread, blk_sh, blk, 16, 1);
+
+    /* power spectra of the frames that end in this block */
+    if ((nfr = stft_kernel (nbread, blk, st, pow)) < 0) {
+      fprintf (stderr, "Error: Out of memory in the FFT\n");
+      exit (-1);
+    }
+    if (db)
+      for (i = 0; i < nfr * st->nbins; i++)
+        pow[i] = (float) (10 * log10 (pow[i]));
+
+    if ((long) fwrite (pow, sizeof (float) * st->nbins, nfr, fpout) != nfr) {
+      fprintf (stderr, "Error: Can't write to output file %s\n", outFileName);
+      exit (-1);
+    }
+    nbFrame += nfr;
+  }
+
+  /* close files */
+  fclose (fpin);
+  fclose (fpout);
+
+  if (!quiet)
+    printf (" >> %ld frames of %d bins (nfft %d, hop %d)\n", nbFrame, st->nbins, nfft, hop);
+
+  stft_free (st);
+  free (blk_sh);
+  free (blk);
+  free (pow);
+
+  return 0;
+}
@@ -0,0 +1,294 @@
+/*                                                            16.Oct.2026 v1.0
+  =============================================================================
+
+                          U    U   GGG    SSSS  TTTTT
+                          U    U  G       S       T
+                          U    U  G  GG   SSSS    T
+                          U    U  G   G       S   T
+                           UUU     GG     SSS     T
+
+                   ========================================
+                    ITU-T - USER'S GROUP ON SOFTWARE TOOLS
+                   ========================================
+
+       =============================================================
+       COPYRIGHT NOTE: This source code, and all of its derivations,
+       is subject to the "ITU-T General Public License". Please have
+       it  read  in    the  distribution  disk,   or  in  the  ITU-T
+       Recommendation G.191 on "SOFTWARE TOOLS FOR SPEECH AND  AUDIO
+       CODING STANDARDS".
+       =============================================================
+
+MODULE:         STFT, STREAMING SHORT-TIME FOURIER TRANSFORM
+                Sub-unit: Power spectrogram of a signal of any length
+
+DESCRIPTION:
+        The frame f of the input covers the samples f*hop ... f*hop+nfft-1;
+        it is windowed and transformed by the FFT plans of fft.c, and its
+        power spectrum is computed as by powSpect(), with the Nyquist bin.
+
+        The input is given by blocks of any size: the samples of the next
+        frame are kept in the state between calls (nfft samples at most),
+        so that the memory does not depend on the length of the signal,
+        and the frames do not depend on the block size.
+
+FUNCTIONS:
+  Global (have prototype in stft.h)
+         = stft_init(...)      : allocate and initialize a STFT
+         = stft_reset(...)     : restart at the 1st frame
+         = stft_free(...)      : release a STFT
+         = stft_maxframes(...) : frames output for n more samples
+         = stft_kernel(...)    : power spectra of the frames of a block
+
+HISTORY:
+    16.Oct.2026 v1.0 Created.
+
+  =============================================================================
+*/
+
+
+/*
+ * ......... INCLUDES .........
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "stft.h"
+
+
+/*
+ * ...................... BEGIN OF FUNCTIONS .........................
+ */
+
+/*
+  ============================================================================
+
+        STFT_STATE *stft_init (int nfft, int hop, const float *win);
+        ~~~~~~~~~~~~~~~~~~~~~
+
+        Description:
+        ~~~~~~~~~~~~
+
+        Allocate the state of a STFT of frames of nfft samples (even,
+        4..NFFT_MAX) every hop samples (hop >= 1; frames overlap if
+        hop < nfft, samples are dropped between them if hop > nfft).
+
+        Parameters:
+        ~~~~~~~~~~~
+        nfft: ... frame length and FFT size.
+        hop: .... number of samples between the starts of 2 frames.
+        win: .... analysis window of nfft values, copied in the state;
+                  NULL for the Hanning window of genHanning().
+
+        Return value:
+        ~~~~~~~~~~~~~
+        Pointer to the state, NULL if invalid parameters or out of memory.
+
+        History:
+        ~~~~~~~~
+        16.Oct.2026 v1.0 Created.
+
+ ============================================================================
+*/
+STFT_STATE *stft_init (int nfft, int hop, const float *win) {
+  STFT_STATE *st;
+
+  if (nfft < 4 || nfft > NFFT_MAX || nfft % 2 != 0 || hop < 1)
+    return NULL;
+
+  if ((st = (STFT_STATE *) calloc (1, sizeof (STFT_STATE))) == NULL)
+    return NULL;
+  st->nfft = nfft;
+  st->hop = hop;
+  st->nbins = nfft / 2 + 1;
+  st->plan = fft_plan_get (nfft);
+  st->win = (float *) malloc (nfft * sizeof (float));
+  st->buf = (float *) malloc (nfft * sizeof (float));
+  st->frame = (float *) malloc (nfft * sizeof (float));
+  if (st->plan == NULL || st->win == NULL || st->buf == NULL || st->frame == NULL) {
+    stft_free (st);
+    return NULL;
+  }
+
+  if (win == NULL)
+    genHanning (nfft, st->win);
+  else
+    memcpy (st->win, win, nfft * sizeof (float));
+
+  stft_reset (st);
+  return st;
+}
+
+/* ....................... End of stft_init() ....................... */
+
+
+/*
+  ============================================================================
+
+        void stft_reset (STFT_STATE *st);
+        ~~~~~~~~~~~~~~~
+
+        Description:
+        ~~~~~~~~~~~~
+
+        Drop the samples received so far: the next sample given to
+        stft_kernel() is the 1st one of frame 0.
+
+        History:
+        ~~~~~~~~
+        16.Oct.2026 v1.0 Created.
+
+ ============================================================================
+*/
+void stft_reset (STFT_STATE * st) {
+  st->fill = 0;
+  st->skip = 0;
+  st->nframes = 0;
+}
+
+/* ....................... End of stft_reset() ....................... */
+
+
+/*
+  ============================================================================
+
+        void stft_free (STFT_STATE *st);
+        ~~~~~~~~~~~~~~
+
+        Description:
+        ~~~~~~~~~~~~
+
+        Release the state (the FFT plan is shared, and is not freed).
+
+        History:
+        ~~~~~~~~
+        16.Oct.2026 v1.0 Created.
+
+ ============================================================================
+*/
+void stft_free (STFT_STATE * st) {
+  if (st == NULL)
+    return;
+  free (st->win);
+  free (st->buf);
+  free (st->frame);
+  free (st);
+}
+
+/* ....................... End of stft_free() ....................... */
+
+
+/*
+  ============================================================================
+
+        long stft_maxframes (const STFT_STATE *st, long n);
+        ~~~~~~~~~~~~~~~~~~~
+
+        Description:
+        ~~~~~~~~~~~~
+
+        Number of frames completed by n more input samples, i.e. the
+        number of power spectra that stft_kernel() outputs for them.
+
+        History:
+        ~~~~~~~~
+        16.Oct.2026 v1.0 Created.
+
+ ============================================================================
+*/
+long stft_maxframes (const STFT_STATE * st, long n) {
+  long total;
+
+  /* Samples from the start of the next frame */
+  total = st->fill + n - st->skip;
+  return (total >= st->nfft) ? (total - st->nfft) / st->hop + 1 : 0;
+}
+
+/* ..................... End of stft_maxframes() ..................... */
+
+
+/*
+  ============================================================================
+
+        long stft_kernel (long n, const float *x, STFT_STATE *st,
+        ~~~~~~~~~~~~~~~~  float *pow);
+
+        Description:
+        ~~~~~~~~~~~~
+
+        Feed n input samples to the STFT. For each frame whose last
+        sample is in x[], the nfft/2+1 values |X(k)|^2/nfft of its
+        windowed FFT are written to pow[], frame after frame.
+
+        Parameters:
+        ~~~~~~~~~~~
+        n: ...... number of input samples.
+        x: ...... input samples.
+        st: ..... STFT state.
+        pow: .... output power spectra, stft_maxframes(st,n)*nbins values.
+
+        Return value:
+        ~~~~~~~~~~~~~
+        Number of frames output, -1 if out of memory (FFT work memory
+        of the sizes that are not powers of 2).
+
+        History:
+        ~~~~~~~~
+        16.Oct.2026 v1.0 Created.
+
+ ============================================================================
+*/
+long stft_kernel (long n, const float *x, STFT_STATE * st, float *pow) {
+  float den = (float) (1.0 / (float) st->nfft);
+  float *a = st->frame;
+  long k, m, nfr;
+  int i, j;
+
+  for (k = 0, nfr = 0; k < n;) {
+    /* Samples between 2 frames (hop > nfft) */
+    if (st->skip > 0) {
+      m = (st->skip < n - k) ? st->skip : n - k;
+      st->skip -= m;
+      k += m;
+      continue;
+    }
+
+    /* Samples of the next frame */
+    m = (st->nfft - st->fill < n - k) ? st->nfft - st->fill : n - k;
+    memcpy (st->buf + st->fill, x + k, m * sizeof (float));
+    st->fill += (int) m;
+    k += m;
+    if (st->fill < st->nfft)
+      break;
+
+    /* Complete frame: windowing, FFT and power spectrum as powSpect() */
+    for (i = 0; i < st->nfft; i++)
+      a[i] = st->buf[i] * st->win[i];
+    if (fft_plan_exec_real (st->plan, a) != 0)
+      return -1;
+    pow[0] = (a[0] * a[0]) * den;
+    for (i = 2, j = 1; i < st->nfft; i += 2, j++)
+      pow[j] = (a[i] * a[i] + a[i + 1] * a[i + 1]) * den;
+    pow[j] = (a[1] * a[1]) * den;
+    pow += st->nbins;
+    nfr++;
+
+    /* Keep the samples of the next frame */
+    if (st->hop < st->nfft) {
+      memmove (st->buf, st->buf + st->hop, (st->nfft - st->hop) * sizeof (float));
+      st->fill = st->nfft - st->hop;
+    } else {
+      st->fill = 0;
+      st->skip = st->hop - st->nfft;
+    }
+  }
+
+  st->nframes += nfr;
+  return nfr;
+}
+
+/* ....................... End of stft_kernel() ....................... */
+
+
+/* **************************** END OF STFT.C **************************** */
@@ -0,0 +1,71 @@
+/*                                                          16.Oct.2026 v1.0 */
+/*=============================================================================
+
+                          U    U   GGG    SSSS  TTTTT
+                          U    U  G       S       T
+                          U    U  G  GG   SSSS    T
+                          U    U  G   G       S   T
+                           UUU     GG     SSS     T
+
+                   ========================================
+                    ITU-T - USER'S GROUP ON SOFTWARE TOOLS
+                   ========================================
+
+       =============================================================
+       COPYRIGHT NOTE: This source code, and all of its derivations,
+       is subject to the "ITU-T General Public License". Please have
+       it  read  in    the  distribution  disk,   or  in  the  ITU-T
+       Recommendation G.191 on "SOFTWARE TOOLS FOR SPEECH AND  AUDIO
+       CODING STANDARDS".
+       =============================================================
+
+  DESCRIPTION :
+	Prototypes and state of the streaming short-time Fourier transform
+  (spectrogram) of stft.c, using the FFT plans of fft.h
+
+  HISTORY :
+  16.Oct.26 v1.0  Created.
+*/
+
+#ifndef STFT_defined
+#define STFT_defined 100
+
+#include "fft.h"
+
+/* State of a streaming STFT: the input is given in blocks of any size, and
+   the power spectrum of each complete frame is output as soon as its last
+   sample is in; the memory does not depend on the length of the input */
+typedef struct {
+  int nfft;                     /* frame length = FFT size (even) */
+  int hop;                      /* number of samples between 2 frames */
+  int nbins;                    /* bins of a power spectrum, nfft/2+1 */
+  const FFT_PLAN *plan;         /* shared FFT plan of nfft points */
+  float *win;                   /* analysis window, nfft values */
+  float *buf;                   /* samples of the next frame received so far */
+  float *frame;                 /* work: windowed frame and its spectrum */
+  int fill;                     /* number of samples in buf[] */
+  long skip;                    /* input samples to drop before the next frame (hop > nfft) */
+  long nframes;                 /* number of frames output since stft_init/reset */
+} STFT_STATE;
+
+/* Allocate a STFT of frames of nfft samples every hop samples, with the
+   window win[nfft] (copied; NULL for the Hanning window of genHanning());
+   NULL if the parameters are invalid or out of memory */
+STFT_STATE *stft_init (int nfft, int hop, const float *win);
+
+/* Restart at the 1st frame, same parameters */
+void stft_reset (STFT_STATE * st);
+
+/* Release the state */
+void stft_free (STFT_STATE * st);
+
+/* Number of frames that stft_kernel() will output for n more samples */
+long stft_maxframes (const STFT_STATE * st, long n);
+
+/* Feed n samples; the power spectra |X(k)|^2/nfft (k=0..nfft/2, as
+   powSpect() plus the Nyquist bin) of the completed frames are written
+   one after the other to pow[], which must hold stft_maxframes(st,n)*nbins
+   values. Returns the number of frames, -1 if out of memory */
+long stft_kernel (long n, const float *x, STFT_STATE * st, float *pow);
+
+#endif /* STFT_defined */
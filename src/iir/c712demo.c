@@ -1,4 +1,4 @@
-/*                                                            02.Feb.2010 v1.1
+/*                                                            16.Oct.2026 v1.2
   ============================================================================
 
   C712DEMO.C
@@ -25,6 +25,12 @@
   ~~~~~~~~
   -skip no ... skips saving to file the fG.712t `no' processed samples
   -lseg l .... defines as `l' the number of samples per processing block
+  -fast ...... uses the fast kernel (transposed direct form II, stages
+               pipelined); the output is not bit-exact with the default
+               kernel
+  -nchan n ... number of interleaved channels in the files (filtered
+               with the fast kernel); lseg and skip are counted in
+               samples per channel. Default is 1.
 
   Compilation:
   ~~~~~~~~~~~
@@ -93,6 +99,7 @@
   ~~~~~~~~
   22.Sep.1994 v1.0 Created
   02.Feb.2010 v1.1 Modified maximum string length (y.hiwasaki)
+  16.Oct.2026 v1.2 Added options -fast and -nchan.
 
   ============================================================================
 */
@@ -141,7 +148,7 @@
  ============================================================================
 */
 void display_usage () {
-  printf ("C712DEMO.C - Version 1.1 of 02.Feb.2010 \n\n");
+  printf ("C712DEMO.C - Version 1.2 of 16.Oct.2026 \n\n");
 
   printf (" Example program for testing the correct implementation of theIIR\n");
   printf (" G.712 filtering without rate change using the IIR-G.712 module.\n");
@@ -162,6 +169,10 @@ void display_usage () {
   printf (" ~~~~~~~~\n");
   printf (" -skip no ... don't save to file the 1st `no' processed samples \n");
   printf (" -lseg l .... set as `l' the number of samples per processing block\n");
+  printf (" -fast ...... use the fast kernel (transposed direct form II, stages\n");
+  printf ("              pipelined); not bit-exact with the default kernel\n");
+  printf (" -nchan n ... number of interleaved channels in the files (fast\n");
+  printf ("              kernel); lseg and skip are counted per channel\n");
 
   /* Quit program */
   exit (-128);
@@ -206,6 +217,8 @@ int main (int argc, char *argv[]) {
   long noverflows1 = 0;
   long nsam = 0;
   long skip = 0;
+  long nchan = 1;
+  int fast = 0;
 
   /* ......... PRINT INFOS ......... */
 
@@ -236,6 +249,22 @@ int main (int argc, char *argv[]) {
           fprintf (stderr, "Warning! lseg limited to max of %ld\n", lseg);
         }
 
+        /* Update argc/argv to next valid option/argument */
+        argv += 2;
+        argc -= 2;
+      } else if (strcmp (argv[1], "-fast") == 0) {
+        /* Fast kernel */
+        fast = 1;
+
+        /* Update argc/argv to next valid option/argument */
+        argv++;
+        argc--;
+      } else if (strcmp (argv[1], "-nchan") == 0) {
+        /* Number of interleaved channels */
+        nchan = atol (argv[2]);
+        if (nchan < 1 || nchan > LSEGMAX)
+          error_terminate ("Invalid number of channels", 1);
+
         /* Update argc/argv to next valid option/argument */
         argv += 2;
         argc -= 2;
@@ -269,6 +298,13 @@ int main (int argc, char *argv[]) {
     fprintf (stderr, "Warning! lseg limited to max of %ld\n", lseg);
   }
 
+  /* All the channels of a segment in the buffers */
+  if (lseg * nchan > LSEGMAX) {
+    lseg = LSEGMAX / nchan;
+    fprintf (stderr, "Warning! lseg limited to max of %ld for %ld channels\n", lseg, nchan);
+  }
+  skip *= nchan;
+
 
 /*
    * ... INITIALIZE SELECTED IIR-STRUCTURE FOR UP-/DOWNSAMPLING ...
@@ -276,6 +312,8 @@ int main (int argc, char *argv[]) {
 
   if ((typ1_ptr = iir_G712_8khz_init ()) == 0)
     error_terminate ("Filter 1: initialization failure iir_G712_8khz()", 1);
+  if (fast && cascade_iir_mode (typ1_ptr, IIR_FAST) < 0)
+    error_terminate ("Filter 1: can't select the fast kernel", 1);
 
 
 /*
@@ -285,23 +323,28 @@ int main (int argc, char *argv[]) {
   /* measure CPU-time */
   t1 = clock ();
 
-  lsegx = lseg;
-  while (lsegx == lseg) {
+  lsegx = lseg * nchan;
+  while (lsegx == lseg * nchan) {
     /* Read input buffer */
-    lsegx = fread (sh_buff, sizeof (short), lseg, inpfilptr);
+    lsegx = fread (sh_buff, sizeof (short), lseg * nchan, inpfilptr);
 
     /* convert short data to float in normalized range */
     sh2fl_16bit (lsegx, sh_buff, fl_buff, 1);
 
 
     /* IIR filtering */
-    lseg1 =                     /* Returned: number of output samples */
-      cascade_iir_kernel (      /* cascade form IIR filter */
-                           lsegx,       /* In : number of input samples */
-                           fl_buff,     /* In : array with input samples */
-                           typ1_ptr,    /* InOut: pointer to IIR struct */
-                           buff1        /* Out : array with output samples */
-      );
+    if (nchan > 1) {
+      if ((lseg1 = cascade_iir_kernel_multi (nchan, lsegx / nchan, fl_buff, typ1_ptr, buff1)) < 0)
+        error_terminate ("Filter 1: can't allocate the state of the channels", 1);
+      lseg1 *= nchan;
+    } else
+      lseg1 =                   /* Returned: number of output samples */
+        cascade_iir_kernel (    /* cascade form IIR filter */
+                             lsegx,     /* In : number of input samples */
+                             fl_buff,   /* In : array with input samples */
+                             typ1_ptr,  /* InOut: pointer to IIR struct */
+                             buff1      /* Out : array with output samples */
+        );
 
     /* Convert to integer for testing overflows -- do not save! */
     noverflows1 += fl2sh_16bit (lseg1, buff1, sh_buff, (int) 0);
@@ -0,0 +1,589 @@
+/*                                                            16.Oct.2026 v1.0
+  =============================================================================
+
+                          U    U   GGG    SSSS  TTTTT
+                          U    U  G       S       T
+                          U    U  G  GG   SSSS    T
+                          U    U  G   G       S   T
+                           UUU     GG     SSS     T
+
+                   ========================================
+                    ITU-T - USER'S GROUP ON SOFTWARE TOOLS
+                   ========================================
+
+       =============================================================
+       COPYRIGHT NOTE: This source code, and all of its derivations,
+       is subject to the "ITU-T General Public License". Please have
+       it  read  in    the  distribution  disk,   or  in  the  ITU-T
+       Recommendation G.191 on "SOFTWARE TOOLS FOR SPEECH AND  AUDIO
+       CODING STANDARDS".
+       =============================================================
+
+MODULE:         IIR-CASC.C, IIR FILTER MODULE
+                Sub-unit with the fast cascade-form kernels
+
+DESCRIPTION:
+
+        This file contains the fast kernels of the cascade-form (bi-quad)
+        IIR filters. The stages are computed in transposed direct form
+        II, in double precision, with two state variables per stage:
+
+          y  = x + s1
+          s1 = a0*x - b0*y + s2
+          s2 = a1*x - b1*y
+
+        (numerator 1 + a0 z^-1 + a1 z^-2 and denominator 1 + b0 z^-1 +
+        b1 z^-2, as in the original kernels of iir-lib.c, which use the
+        direct form I with float state). The output differs from the
+        original kernels by rounding only.
+
+        Several interleaved channels (cascade_iir_kernel_multi()) are
+        computed in parallel, one channel per SIMD lane. A single
+        channel (fast mode of cascade_iir_kernel()) is pipelined over
+        the stages: at step t, stage n filters sample t-n, so that all
+        the stages are computed in parallel, one stage per SIMD lane.
+        Both ways give the same rounding, hence every channel of
+        cascade_iir_kernel_multi() is bit-exact with the fast filtering
+        of that channel alone.
+
+        The AVX2 versions are selected at run time when the processor
+        supports them; they do not use fused multiply-add.
+
+FUNCTIONS:
+  Global (have prototype in iirflt.h)
+         = cascade_iir_mode(...)         : select strict or fast kernel
+         = cascade_iir_kernel_multi(...) : fast kernel for interleaved
+                                           channels
+
+  Local (should be used only here -- prototypes only in this file)
+         = iir_casc_state(...)           : allocate the fast-kernel state
+         = iir_casc_avx2(...)            : find if AVX2 may be used
+         = iir_casc_multi_c(...), iir_casc_multi_avx2(...)
+         = iir_casc_pipe_c(...), iir_casc_pipe_avx2(...)
+
+HISTORY:
+    16.Oct.2026 v1.0 Created.
+
+  =============================================================================
+*/
+
+
+/*
+ * ......... INCLUDES .........
+ */
+#include <stdlib.h>             /* General utility definitions */
+#include <string.h>             /* memset() */
+
+#include "iirflt.h"             /* Definitions for IIR filters */
+
+/* Instruction-set specific code is only compiled for x86 processors; the target attribute allows to compile it without changing the compiler options */
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define IIR_X86
+#define IIR_TARGET(isa) __attribute__ ((target (isa)))
+#include <immintrin.h>
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#define IIR_X86
+#define IIR_TARGET(isa)
+#include <intrin.h>
+#include <immintrin.h>
+#endif
+
+
+/*
+ * ......... Local definitions .........
+ */
+
+/* Stages are padded to a multiple of IIR_LANES (doubles in an AVX2 vector) */
+#define IIR_LANES 4
+
+/* Max.number of vectors of stages kept in registers by iir_casc_pipe_avx2() */
+#define IIR_MAXVEC 8
+
+
+/*
+ * ......... Local function prototypes .........
+ */
+static int iir_casc_state ARGS ((CASCADE_IIR * iir, long nchan));
+extern void *iir_malloc_aligned ARGS ((long size));
+static int iir_casc_avx2 ARGS ((void));
+static long iir_casc_multi_c ARGS ((CASCADE_IIR * iir, long nchan, long c0, long c1, long nx, float *x, long iup, long idown, float *y));
+static long iir_casc_pipe_c ARGS ((CASCADE_IIR * iir, long s0, long s1, long nu, float *x, long iup, long idown, long *k, float *y));
+#ifdef IIR_X86
+IIR_TARGET ("avx2") static long iir_casc_multi_avx2 ARGS ((CASCADE_IIR * iir, long nchan, long nx, float *x, long iup, long idown, float *y));
+IIR_TARGET ("avx2") static long iir_casc_pipe_avx2 ARGS ((CASCADE_IIR * iir, long s0, long s1, float *x, long iup, long idown, long *k, float *y));
+#endif
+
+
+/*
+ * ...................... BEGIN OF FUNCTIONS .........................
+ */
+
+/*
+  ============================================================================
+
+        int cascade_iir_mode (CASCADE_IIR *iir_ptr, int mode);
+        ~~~~~~~~~~~~~~~~~~~~
+
+        Description:
+        ~~~~~~~~~~~~
+
+        Select the kernel used by cascade_iir_kernel(): IIR_STRICT (the
+        original direct form I kernels, default after initialization)
+        or IIR_FAST (transposed direct form II, stages pipelined). The
+        state of the filter is cleared, as by cascade_iir_reset().
+
+        Parameters:
+        ~~~~~~~~~~~
+        iir_ptr: .. (InOut) pointer to struct CASCADE_IIR;
+        mode: ..... (In)    IIR_STRICT or IIR_FAST.
+
+        Return value:
+        ~~~~~~~~~~~~~
+        0 on success, -1 if out of memory (the mode is not changed).
+
+        History:
+        ~~~~~~~~
+        16.Oct.2026 v1.0 Created.
+
+ ============================================================================
+*/
+int cascade_iir_mode (CASCADE_IIR * iir_ptr, int mode) {
+  if (mode == IIR_FAST && iir_casc_state (iir_ptr, 1) < 0)
+    return -1;
+  iir_ptr->mode = (char) mode;
+  cascade_iir_reset (iir_ptr);
+  return 0;
+}
+
+/* ...................... End of cascade_iir_mode() ...................... */
+
+
+/*
+  ============================================================================
+
+        long cascade_iir_kernel_multi (int nchan, long lseg, float *x_ptr,
+        ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~  CASCADE_IIR *iir_ptr,
+                                       float *y_ptr);
+
+        Description:
+        ~~~~~~~~~~~~
+
+        Cascade-form IIR filtering of `nchan' interleaved channels (e.g.
+        stereo material, or a batch of files), for both up- and
+        down-sampling, with the fast kernel (transposed direct form II)
+        whatever the mode selected by cascade_iir_mode(). All the
+        channels are filtered with the coefficients of iir_ptr, each
+        one with its own state.
+
+        The state holds the variables of `nchan' channels. When the
+        number of channels differs from the previous call, the state is
+        re-allocated and cleared (as by cascade_iir_reset()).
+
+        Parameters:
+        ~~~~~~~~~~~
+        nchan: ... (In)    number of interleaved channels
+        lseg: .... (In)    number of input samples per channel
+        x_ptr: ... (In)    array with lseg*nchan input samples
+        iir_ptr .. (InOut) pointer to IIR-struct (CASCADE_IIR *)
+        y_ptr .... (Out)   array with output samples (interleaved)
+
+        Return value:
+        ~~~~~~~~~~~~~
+        Returns the number of output samples per channel, or -1 if
+        nchan is less than 1 or out of memory.
+
+        History:
+        ~~~~~~~~
+        16.Oct.2026 v1.0 Created.
+
+ ============================================================================
+*/
+long cascade_iir_kernel_multi (int nchan, long lseg, float *x_ptr, CASCADE_IIR * iir_ptr, float *y_ptr) {
+  static int avx2 = -1;         /* cached result of CPUID */
+  long iup, idown, ky = 0, k, nu, s;
+
+  if (nchan < 1 || (iir_ptr->nchan != nchan && iir_casc_state (iir_ptr, nchan) < 0))
+    return -1;
+  if (avx2 < 0)
+    avx2 = iir_casc_avx2 ();
+
+  /* Up-sampling inserts iup-1 zeros after each input sample, down-sampling keeps one output in idown */
+  iup = (iir_ptr->hswitch == 'U') ? iir_ptr->idown : 1;
+  idown = (iir_ptr->hswitch == 'U') ? 1 : iir_ptr->idown;
+  k = (iir_ptr->hswitch == 'U') ? 0 : iir_ptr->k0;
+
+  if (nchan > 1) {
+    /* Channels in lanes: all the groups of channels give the same number of outputs */
+#ifdef IIR_X86
+    if (avx2 && nchan >= IIR_LANES)
+      ky = iir_casc_multi_avx2 (iir_ptr, nchan, lseg, x_ptr, iup, idown, y_ptr);
+#endif
+    if (nchan % IIR_LANES != 0 || !avx2)
+      ky = iir_casc_multi_c (iir_ptr, nchan, avx2 ? nchan - nchan % IIR_LANES : 0, nchan, lseg, x_ptr, iup, idown, y_ptr);
+    k += lseg * iup;
+  } else {
+    /* Stages in lanes: step s filters sample s-n in stage n, for s = 0 ... nu+nblocks-2;
+     * all the stages are active from step nblocks-1 to nu-1 */
+    nu = lseg * iup;
+    for (s = 0; s < nu + iir_ptr->nblocks - 1;) {
+      if (s >= iir_ptr->nblocks - 1 && s < nu) {
+#ifdef IIR_X86
+        if (avx2 && iir_ptr->nbpad <= IIR_MAXVEC * IIR_LANES)
+          ky += iir_casc_pipe_avx2 (iir_ptr, s, nu, x_ptr, iup, idown, &k, y_ptr + ky);
+        else
+#endif
+          ky += iir_casc_pipe_c (iir_ptr, s, nu, nu, x_ptr, iup, idown, &k, y_ptr + ky);
+        s = nu;
+      } else {
+        ky += iir_casc_pipe_c (iir_ptr, s, s + 1, nu, x_ptr, iup, idown, &k, y_ptr + ky);
+        s++;
+      }
+    }
+  }
+
+  if (iir_ptr->hswitch != 'U')
+    iir_ptr->k0 = k % idown;    /* avoid overflow */
+  return ky;
+}
+
+/* ................. End of cascade_iir_kernel_multi() ................. */
+
+
+/*
+  ============================================================================
+
+        static int iir_casc_state (CASCADE_IIR *iir, long nchan);
+        ~~~~~~~~~~~~~~~~~~~~~~~~~
+
+        Description:
+        ~~~~~~~~~~~~
+
+        Allocate (at first use) the coefficients of the fast kernels,
+        converted to double and padded with pass-through stages to a
+        multiple of IIR_LANES, and (re-)allocate the cleared state for
+        `nchan' channels.
+
+        Return value:
+        ~~~~~~~~~~~~~
+        0 on success, -1 if out of memory.
+
+        History:
+        ~~~~~~~~
+        16.Oct.2026 v1.0 Created.
+
+ ============================================================================
+*/
+static int iir_casc_state (CASCADE_IIR * iir, long nchan) {
+  long nbpad = (iir->nblocks + IIR_LANES - 1) / IIR_LANES * IIR_LANES;
+  double *S;
+  long n;
+
+  if (iir->C == NULL) {
+    if ((iir->C = (double *) iir_malloc_aligned (4 * nbpad * sizeof (double))) == NULL)
+      return -1;
+    memset (iir->C, 0, 4 * nbpad * sizeof (double));
+    iir->nbpad = nbpad;
+    for (n = 0; n < iir->nblocks; n++) {
+      iir->C[n] = iir->a[n][0];
+      iir->C[nbpad + n] = iir->a[n][1];
+      iir->C[2 * nbpad + n] = iir->b[n][0];
+      iir->C[3 * nbpad + n] = iir->b[n][1];
+    }
+  }
+
+  if (iir->S == NULL || iir->nchan != nchan) {
+    if ((S = (double *) calloc ((2 * nchan + 1) * nbpad, sizeof (double))) == NULL)
+      return -1;
+    free (iir->S);
+    iir->S = S;
+    iir->nchan = nchan;
+    iir->k0 = iir->idown;
+  }
+  return 0;
+}
+
+/* ...................... End of iir_casc_state() ...................... */
+
+
+/*
+  ============================================================================
+
+        static int iir_casc_avx2 (void);
+        ~~~~~~~~~~~~~~~~~~~~~~~~
+
+        Description:
+        ~~~~~~~~~~~~
+
+        Find if the processor and the operating system (saving of the
+        YMM registers) support AVX2.
+
+        History:
+        ~~~~~~~~
+        16.Oct.2026 v1.0 Created.
+
+ ============================================================================
+*/
+static int iir_casc_avx2 () {
+#if defined(IIR_X86) && defined(__GNUC__)
+  __builtin_cpu_init ();
+  return __builtin_cpu_supports ("avx2");
+#elif defined(IIR_X86)
+  int r[4];
+
+  __cpuid (r, 1);
+  if (!(r[2] & (1 << 27)) || !(r[2] & (1 << 28)) || (_xgetbv (0) & 0x06) != 0x06)
+    return 0;                   /* no OSXSAVE, AVX or YMM state */
+  __cpuidex (r, 7, 0);
+  return (r[1] & (1 << 5)) != 0;
+#else
+  return 0;
+#endif
+}
+
+/* ....................... End of iir_casc_avx2() ....................... */
+
+
+/*
+  ============================================================================
+
+        static long iir_casc_multi_c (CASCADE_IIR *iir, long nchan,
+        ~~~~~~~~~~~~~~~~~~~~~~~~~~~~  long c0, long c1, long nx,
+                                      float *x, long iup, long idown,
+                                      float *y);
+
+        Description:
+        ~~~~~~~~~~~~
+
+        Portable kernel for channels c0 ... c1-1 of `nchan' interleaved
+        channels: nx input samples per channel, each one followed by
+        iup-1 zeros, filtered through all the stages; one output in
+        idown is kept, starting from the modulo counter iir->k0.
+
+        Return value:
+        ~~~~~~~~~~~~~
+        Number of output samples per channel.
+
+        History:
+        ~~~~~~~~
+        16.Oct.2026 v1.0 Created.
+
+ ============================================================================
+*/
+static long iir_casc_multi_c (CASCADE_IIR * iir, long nchan, long c0, long c1, long nx, float *x, long iup, long idown, float *y) {
+  long nbpad = iir->nbpad, nb = iir->nblocks;
+  double *a0 = iir->C, *a1 = a0 + nbpad, *b0 = a1 + nbpad, *b1 = b0 + nbpad;
+  double *S1 = iir->S, *S2 = S1 + nbpad * nchan;
+  double u, yj;
+  long t, n, c, k, ky = 0;
+
+  for (c = c0; c < c1; c++) {
+    k = (iup > 1) ? 0 : iir->k0;
+    for (t = 0, ky = 0; t < nx * iup; t++, k++) {
+      u = (t % iup == 0) ? x[t / iup * nchan + c] : 0.;
+      for (n = 0; n < nb; n++) {
+        yj = u + S1[n * nchan + c];
+        S1[n * nchan + c] = a0[n] * u - b0[n] * yj + S2[n * nchan + c];
+        S2[n * nchan + c] = a1[n] * u - b1[n] * yj;
+        u = yj;
+      }
+      if (k % idown == 0)
+        y[ky++ * nchan + c] = u * iir->gain;
+    }
+  }
+  return ky;
+}
+
+/* ..................... End of iir_casc_multi_c() ..................... */
+
+
+/*
+  ============================================================================
+
+        static long iir_casc_pipe_c (CASCADE_IIR *iir, long s0, long s1,
+        ~~~~~~~~~~~~~~~~~~~~~~~~~~~  long nu, float *x, long iup,
+                                     long idown, long *k, float *y);
+
+        Description:
+        ~~~~~~~~~~~~
+
+        Portable pipelined kernel for one channel: steps s0 ... s1-1 of
+        a segment of nu samples (nx=nu/iup input samples, each one
+        followed by iup-1 zeros). At step s, stage n filters sample s-n
+        if it belongs to the segment; its input is the output of stage
+        n-1 at the previous step (kept in S after the state). The
+        outputs of the last stage are decimated by idown with the
+        modulo counter *k.
+
+        Return value:
+        ~~~~~~~~~~~~~
+        Number of output samples.
+
+        History:
+        ~~~~~~~~
+        16.Oct.2026 v1.0 Created.
+
+ ============================================================================
+*/
+static long iir_casc_pipe_c (CASCADE_IIR * iir, long s0, long s1, long nu, float *x, long iup, long idown, long *k, float *y) {
+  long nbpad = iir->nbpad, nb = iir->nblocks;
+  double *a0 = iir->C, *a1 = a0 + nbpad, *b0 = a1 + nbpad, *b1 = b0 + nbpad;
+  double *S1 = iir->S, *S2 = S1 + nbpad, *O = S2 + nbpad;
+  double u, yj;
+  long s, n, ky = 0;
+
+  for (s = s0; s < s1; s++) {
+    /* Last stage first: its input is the previous output of the stage before */
+    for (n = nb - 1; n >= 0; n--) {
+      if (s - n < 0 || s - n >= nu)
+        continue;
+      u = (n > 0) ? O[n - 1] : ((s % iup == 0) ? x[s / iup] : 0.);
+      yj = u + S1[n];
+      S1[n] = a0[n] * u - b0[n] * yj + S2[n];
+      S2[n] = a1[n] * u - b1[n] * yj;
+      O[n] = yj;
+    }
+
+    /* Sample s-nb+1 leaves the last stage */
+    if (s - nb + 1 >= 0 && s - nb + 1 < nu) {
+      if (*k % idown == 0)
+        y[ky++] = O[nb - 1] * iir->gain;
+      (*k)++;
+    }
+  }
+  return ky;
+}
+
+/* ...................... End of iir_casc_pipe_c() ...................... */
+
+
+#ifdef IIR_X86
+/*
+  ============================================================================
+
+        static long iir_casc_multi_avx2 (CASCADE_IIR *iir, long nchan,
+        ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~  long nx, float *x, long iup,
+                                         long idown, float *y);
+
+        Description:
+        ~~~~~~~~~~~~
+
+        Same as iir_casc_multi_c() for the channels 0 ... nchan-1 in
+        groups of four, one channel per lane; the channels left over
+        are not filtered.
+
+        History:
+        ~~~~~~~~
+        16.Oct.2026 v1.0 Created.
+
+ ============================================================================
+*/
+IIR_TARGET ("avx2")
+static long iir_casc_multi_avx2 (CASCADE_IIR * iir, long nchan, long nx, float *x, long iup, long idown, float *y) {
+  long nbpad = iir->nbpad, nb = iir->nblocks;
+  double *a0 = iir->C, *a1 = a0 + nbpad, *b0 = a1 + nbpad, *b1 = b0 + nbpad;
+  double *S1 = iir->S, *S2 = S1 + nbpad * nchan;
+  __m256d u, yj, s1, s2, gain = _mm256_set1_pd (iir->gain);
+  long t, n, c, k, ky = 0;
+
+  for (c = 0; c + IIR_LANES <= nchan; c += IIR_LANES) {
+    k = (iup > 1) ? 0 : iir->k0;
+    for (t = 0, ky = 0; t < nx * iup; t++, k++) {
+      u = (t % iup == 0) ? _mm256_cvtps_pd (_mm_loadu_ps (x + t / iup * nchan + c)) : _mm256_setzero_pd ();
+      for (n = 0; n < nb; n++) {
+        s1 = _mm256_loadu_pd (S1 + n * nchan + c);
+        s2 = _mm256_loadu_pd (S2 + n * nchan + c);
+        yj = _mm256_add_pd (u, s1);
+        s1 = _mm256_add_pd (_mm256_sub_pd (_mm256_mul_pd (_mm256_set1_pd (a0[n]), u), _mm256_mul_pd (_mm256_set1_pd (b0[n]), yj)), s2);
+        s2 = _mm256_sub_pd (_mm256_mul_pd (_mm256_set1_pd (a1[n]), u), _mm256_mul_pd (_mm256_set1_pd (b1[n]), yj));
+        _mm256_storeu_pd (S1 + n * nchan + c, s1);
+        _mm256_storeu_pd (S2 + n * nchan + c, s2);
+        u = yj;
+      }
+      if (k % idown == 0)
+        _mm_storeu_ps (y + ky++ * nchan + c, _mm256_cvtpd_ps (_mm256_mul_pd (u, gain)));
+    }
+  }
+  return ky;
+}
+
+/* .................... End of iir_casc_multi_avx2() .................... */
+
+
+/*
+  ============================================================================
+
+        static long iir_casc_pipe_avx2 (CASCADE_IIR *iir, long s0,
+        ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~  long s1, float *x,
+                                        long iup, long idown, long *k,
+                                        float *y);
+
+        Description:
+        ~~~~~~~~~~~~
+
+        Same as iir_casc_pipe_c() for steps where all the stages are
+        active (nblocks-1 <= s0, s1 <= nu), four stages per vector. The
+        state and the stage outputs stay in registers during the steps;
+        the input of each vector is the output vector of the previous
+        step shifted by one lane, the first lane taken from the vector
+        before (or the input sample). The padding stages pass their
+        input through with zero state.
+
+        History:
+        ~~~~~~~~
+        16.Oct.2026 v1.0 Created.
+
+ ============================================================================
+*/
+IIR_TARGET ("avx2")
+static long iir_casc_pipe_avx2 (CASCADE_IIR * iir, long s0, long s1, float *x, long iup, long idown, long *k, float *y) {
+  long nbpad = iir->nbpad, nv = iir->nbpad / IIR_LANES, nb = iir->nblocks;
+  double *C = iir->C, *S1 = iir->S, *S2 = S1 + nbpad, *O = S2 + nbpad;
+  __m256d a0[IIR_MAXVEC], a1[IIR_MAXVEC], b0[IIR_MAXVEC], b1[IIR_MAXVEC];
+  __m256d st1[IIR_MAXVEC], st2[IIR_MAXVEC], o[IIR_MAXVEC];
+  __m256d u, yj, first;
+  double last[IIR_LANES], xs;
+  long s, v, ky = 0;
+
+  for (v = 0; v < nv; v++) {
+    a0[v] = _mm256_load_pd (C + v * IIR_LANES);
+    a1[v] = _mm256_load_pd (C + nbpad + v * IIR_LANES);
+    b0[v] = _mm256_load_pd (C + 2 * nbpad + v * IIR_LANES);
+    b1[v] = _mm256_load_pd (C + 3 * nbpad + v * IIR_LANES);
+    st1[v] = _mm256_loadu_pd (S1 + v * IIR_LANES);
+    st2[v] = _mm256_loadu_pd (S2 + v * IIR_LANES);
+    o[v] = _mm256_loadu_pd (O + v * IIR_LANES);
+  }
+
+  for (s = s0; s < s1; s++) {
+    xs = (s % iup == 0) ? x[s / iup] : 0.;
+
+    /* Last vector first: its first lane is the last lane of the previous vector */
+    for (v = nv - 1; v >= 0; v--) {
+      first = (v > 0) ? _mm256_permute4x64_pd (o[v - 1], 0xFF) : _mm256_set1_pd (xs);
+      u = _mm256_blend_pd (_mm256_permute4x64_pd (o[v], 0x90), first, 0x1);
+      yj = _mm256_add_pd (u, st1[v]);
+      st1[v] = _mm256_add_pd (_mm256_sub_pd (_mm256_mul_pd (a0[v], u), _mm256_mul_pd (b0[v], yj)), st2[v]);
+      st2[v] = _mm256_sub_pd (_mm256_mul_pd (a1[v], u), _mm256_mul_pd (b1[v], yj));
+      o[v] = yj;
+    }
+
+    /* Sample s-nb+1 leaves the last stage */
+    _mm256_storeu_pd (last, o[(nb - 1) / IIR_LANES]);
+    if (*k % idown == 0)
+      y[ky++] = last[(nb - 1) % IIR_LANES] * iir->gain;
+    (*k)++;
+  }
+
+  for (v = 0; v < nv; v++) {
+    _mm256_storeu_pd (S1 + v * IIR_LANES, st1[v]);
+    _mm256_storeu_pd (S2 + v * IIR_LANES, st2[v]);
+    _mm256_storeu_pd (O + v * IIR_LANES, o[v]);
+  }
+  return ky;
+}
+
+/* .................... End of iir_casc_pipe_avx2() .................... */
+#endif
+
+
+/* **************************** END OF IIR-CASC.C **************************** */
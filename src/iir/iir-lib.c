@@ -1,4 +1,4 @@
-/*                                                           v3.1 - 22/Feb/1996
+/*                                                           v3.2 - 16/Oct/2026
   =============================================================================
 
                           U    U   GGG    SSSS  TTTTT
@@ -61,6 +61,11 @@ HISTORY:
     22.Feb.96 v3.1 Changed inclusion of stdlib.h to inconditional, as
                    suggested by Kirchherr (FI/DBP Telekom) to run under
 		   OpenVMS/AXP <simao@ctd.comsat.com>
+    16.Oct.26 v3.2 cascade_iir_kernel() runs the fast kernel of iir-casc.c
+                   when selected by cascade_iir_mode().
+    16.Oct.26 v3.3 Packed, aligned coefficients of the parallel form and
+                   kernel without rate change or with down-sampling that
+                   runs the feed-forward part only for the kept samples.
 
   =============================================================================
 */
@@ -71,6 +76,7 @@ HISTORY:
  */
 
 #include <stdlib.h>             /* General utility definitions */
+#include <string.h>             /* memset() */
 #include <math.h>               /* RTL Math Function Declarations */
 
 /* Definitions for IIR filters */
@@ -78,10 +84,27 @@ HISTORY:
 
 
 
+/*
+ * ......... Local definitions .........
+ */
+
+/* Packed coefficients are aligned to IIR_ALIGN bytes, sets padded to a multiple of IIR_PAD blocks (one SSE vector) */
+#define IIR_ALIGN 32
+#define IIR_PAD 4
+
+/* Max.number of (padded) blocks of scd_parallel_form_iir_decim_kernel() */
+#define IIR_MAXPAD 32
+
+
 /*
  * ......... Local function *smart* prototypes .........
  */
+/* Aligned memory, also for the coefficients of iir-casc.c */
+void *iir_malloc_aligned ARGS ((long size));
+void iir_free_aligned ARGS ((void *ptr));
+
 /* Parallel-form filtering basic function prototypes */
+static long scd_parallel_form_iir_decim_kernel ARGS ((long lenx, float *x, float *y, long *k0, long idown, long nblocks, long nbpad, double direct_cof, double gain, float *P, float (*T)[2]));
 static long scd_parallel_form_iir_down_kernel ARGS ((long lenx, float *x, float *y, long *k0, long idown, long nblocks, double direct_cof, double gain, float (*b)[3], float (*c)[2], float (*T)[2]));
 static long scd_parallel_form_iir_up_kernel ARGS ((long lenx, float *x, float *y, long iup, long nblocks, double direct_cof, double gain, float (*b)[3], float (*c)[2], float (*T)[2]));
 
@@ -144,6 +167,7 @@ DIRECT_IIR *direct_iir_init ARGS ((long zno, long pno, float *a, float *b, doubl
  ============================================================================
 */
 void stdpcm_free (SCD_IIR * iir_ptr) {
+  iir_free_aligned (iir_ptr->P);        /* free packed coefficients */
   free (iir_ptr->T);            /* free state variables */
   free (iir_ptr);               /* free allocated struct */
 }
@@ -266,6 +290,23 @@ SCD_IIR *scd_stdpcm_init (long nblocks, float (*b)[3], float (*c)[2], double dir
   ptrIIR->c = c;
 
 
+  /* Packed coefficients: c0, c1, b0, b1, b2 of all the blocks, one after the other */
+  ptrIIR->nbpad = (nblocks + IIR_PAD - 1) / IIR_PAD * IIR_PAD;
+  if ((ptrIIR->P = (float *) iir_malloc_aligned (5 * ptrIIR->nbpad * sizeof (fak))) == (float *) 0) {
+    free (ptrIIR->T);
+    free (ptrIIR);
+    return 0;
+  }
+  memset (ptrIIR->P, 0, 5 * ptrIIR->nbpad * sizeof (fak));
+  for (n = 0; n < nblocks; n++) {
+    ptrIIR->P[n] = c[n][0];
+    ptrIIR->P[ptrIIR->nbpad + n] = c[n][1];
+    ptrIIR->P[2 * ptrIIR->nbpad + n] = b[n][0];
+    ptrIIR->P[3 * ptrIIR->nbpad + n] = b[n][1];
+    ptrIIR->P[4 * ptrIIR->nbpad + n] = b[n][2];
+  }
+
+
   /* store down-sampling factor/gain/direct-path coefficient */
   ptrIIR->idown = idown;
   ptrIIR->gain = gain;
@@ -301,7 +342,9 @@ SCD_IIR *scd_stdpcm_init (long nblocks, float (*b)[3], float (*c)[2], double dir
         Description:
         ~~~~~~~~~~~~
 
-        Standard PCM-filter.
+        Standard PCM-filter. Without rate change and for down-sampling,
+        the packed coefficients are used (bit-exact with the original
+        kernel).
 
         Parameters:
         ~~~~~~~~~~~
@@ -320,11 +363,15 @@ SCD_IIR *scd_stdpcm_init (long nblocks, float (*b)[3], float (*c)[2], double dir
         History:
         ~~~~~~~~
         28.Feb.92 v1.0 Release of 1st version <hf@pkinbg.uucp>
+        16.Oct.26 v1.1 Packed coefficients, see
+                       scd_parallel_form_iir_decim_kernel().
 
  ============================================================================
 */
 long stdpcm_kernel (long lseg, float *x_ptr, SCD_IIR * iir_ptr, float *y_ptr) {
-  if (iir_ptr->hswitch == 'U')
+  if (iir_ptr->hswitch != 'U' && iir_ptr->nbpad <= IIR_MAXPAD)
+    return scd_parallel_form_iir_decim_kernel (lseg, x_ptr, y_ptr, &(iir_ptr->k0), iir_ptr->idown, iir_ptr->nblocks, iir_ptr->nbpad, iir_ptr->direct_cof, iir_ptr->gain, iir_ptr->P, iir_ptr->T);
+  else if (iir_ptr->hswitch == 'U')
     return scd_parallel_form_iir_up_kernel (    /* returns number of output samples */
                                              lseg,      /* In : length of input signal */
                                              x_ptr,     /* In : array with input samples */
@@ -434,6 +481,110 @@ static long scd_parallel_form_iir_down_kernel (long lenx, float *x, float *y, lo
 
 
 
+/*
+  ============================================================================
+
+        long scd_parallel_form_iir_decim_kernel(long lenx, float *x,
+        ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ float *y, long *k0,
+                                                long idown, long nblocks,
+                                                long nbpad,
+                                                double direct_cof,
+                                                double gain, float *P,
+                                                float (*T)[2]);
+
+        Description:
+        ~~~~~~~~~~~~
+
+        Same as scd_parallel_form_iir_down_kernel(), with the
+        coefficients packed by scd_stdpcm_init() (c0, c1, b0, b1 and b2
+        of the nbpad blocks, one after the other). The samples are
+        taken by groups: the idown-1 dropped samples only run the
+        recursive part, and the kept sample the recursive and the
+        feed-forward parts, without test of the modulo counter. The
+        blocks are independent, and are computed in loops over the
+        packed coefficients and a local copy of the state variables,
+        which the compiler may vectorise. The operations and the order
+        of the sum of the blocks are those of the original kernel,
+        which gives bit-exact results.
+
+        Parameters:
+        ~~~~~~~~~~~
+        lenx: ........ (In) length of input array x[]
+        x: ........... (In) array with input samples
+        y: ........... (Out) array with output samples
+        k0: .......... (In/Out) pointer to modulo counter
+        idown: ....... (In) down-sampling factor
+        nblocks: ..... (In) number of coeff. sets
+        nbpad: ....... (In) number of packed coeff. sets (<= IIR_MAXPAD)
+        direct_cof: .. (In) direct path coefficient
+        gain: ........ (In) gain factor
+        P: ........... (In) packed coefficients
+        T: ........... (In/Out) state variables
+
+        Return value:
+        ~~~~~~~~~~~~~
+        Returns the number of samples filtered.
+
+        History:
+        ~~~~~~~~
+        16.Oct.26 v1.0 Created.
+
+ ============================================================================
+*/
+static long scd_parallel_form_iir_decim_kernel (long lenx, float *x, float *y, long *k0, long idown, long nblocks, long nbpad, double direct_cof, double gain, float *P, float (*T)[2]) {
+  float *c0 = P, *c1 = P + nbpad, *b0 = P + 2 * nbpad, *b1 = P + 3 * nbpad, *b2 = P + 4 * nbpad;
+  float T0[IIR_MAXPAD], T1[IIR_MAXPAD], Ttmp[IIR_MAXPAD], F[IIR_MAXPAD];
+  float xj, yj;
+  long kx, ky, n, ndrop;
+
+
+  /* Local copy of the state variables (those of the padding blocks are not used) */
+  for (n = 0; n < nbpad; n++) {
+    T0[n] = (n < nblocks) ? T[n][0] : 0;
+    T1[n] = (n < nblocks) ? T[n][1] : 0;
+  }
+
+  /* Number of samples dropped before the next output */
+  ndrop = (idown - *k0 % idown) % idown;
+
+  ky = 0;                       /* starting index in output array (y) */
+  for (kx = 0; kx < lenx; kx++) {       /* loop over all input samples */
+    xj = x[kx];
+    if (ndrop > 0) {            /* recursive part only */
+      for (n = 0; n < nbpad; n++) {
+        Ttmp[n] = 2. * (xj - c0[n] * T0[n] - c1[n] * T1[n]);
+        T0[n] = T1[n];
+        T1[n] = Ttmp[n];
+      }
+      ndrop--;
+    } else {                    /* recursive and feed-forward parts */
+      for (n = 0; n < nbpad; n++) {
+        Ttmp[n] = 2. * (xj - c0[n] * T0[n] - c1[n] * T1[n]);
+        F[n] = b2[n] * Ttmp[n] + b1[n] * T1[n] + b0[n] * T0[n];
+        T0[n] = T1[n];
+        T1[n] = Ttmp[n];
+      }
+      yj = direct_cof * xj;     /* direct path */
+      for (n = 0; n < nblocks; n++)     /* sum of the blocks, in order */
+        yj += F[n];
+      y[ky++] = yj * gain;
+      ndrop = idown - 1;
+    }
+  }
+  *k0 = (*k0 + lenx) % idown;
+
+  /* Store state variables */
+  for (n = 0; n < nblocks; n++) {
+    T[n][0] = T0[n];
+    T[n][1] = T1[n];
+  }
+  return ky;
+}
+
+/* ............. End of scd_parallel_form_iir_decim_kernel() ............. */
+
+
+
 /*
   ============================================================================
 
@@ -511,6 +662,52 @@ static long scd_parallel_form_iir_up_kernel (long lenx, float *x, float *y, long
 
 
 
+/*
+  ============================================================================
+
+        void *iir_malloc_aligned (long size);
+        ~~~~~~~~~~~~~~~~~~~~~~~~
+        void iir_free_aligned (void *ptr);
+        ~~~~~~~~~~~~~~~~~~~~~
+
+        Description:
+        ~~~~~~~~~~~~
+
+        Allocate a memory block of `size' bytes starting at a multiple
+        of IIR_ALIGN bytes, for the packed coefficients, and release it.
+        The pointer returned by malloc() is kept just before the aligned
+        block. iir_free_aligned() accepts NULL.
+
+        Return value:
+        ~~~~~~~~~~~~~
+        Pointer to the aligned block, or NULL if out of memory.
+
+        History:
+        ~~~~~~~~
+        16.Oct.26 v1.0 Created.
+
+ ============================================================================
+*/
+void *iir_malloc_aligned (long size) {
+  char *raw, *ptr;
+
+  if ((raw = (char *) malloc (size + IIR_ALIGN + sizeof (void *))) == (char *) NULL)
+    return NULL;
+  ptr = raw + sizeof (void *);
+  ptr += (IIR_ALIGN - (size_t) ptr % IIR_ALIGN) % IIR_ALIGN;
+  ((void **) ptr)[-1] = raw;
+  return ptr;
+}
+
+void iir_free_aligned (void *ptr) {
+  if (ptr != NULL)
+    free (((void **) ptr)[-1]);
+}
+
+/* ................. End of iir_{malloc,free}_aligned() ................. */
+
+
+
 /* *************************************************************************
    ******** THE ROUTINES TO FOLLOW HAVE BEEN ADDED AFTER THE STL92 *********
  * ************************************************************************* */
@@ -559,6 +756,10 @@ void cascade_iir_reset (CASCADE_IIR * iir_ptr) {
     T_ptr[n][3] = 0.0;
   }
 
+  /* State of the fast kernels, if allocated */
+  if (iir_ptr->S != NULL)
+    memset (iir_ptr->S, 0, (2 * iir_ptr->nchan + 1) * iir_ptr->nbpad * sizeof (double));
+
   iir_ptr->k0 = iir_ptr->idown; /* modulo counter for down-sampling */
 }
 
@@ -575,7 +776,8 @@ void cascade_iir_reset (CASCADE_IIR * iir_ptr) {
   ~~~~~~~~~~~~
 
   Basic cascade-form IIR filtering routine, for both up- and
-  down-sampling.
+  down-sampling. In fast mode (see cascade_iir_mode()), the filtering
+  is done by cascade_iir_kernel_multi() with one channel.
 
   Parameters:
   ~~~~~~~~~~~
@@ -594,11 +796,14 @@ void cascade_iir_reset (CASCADE_IIR * iir_ptr) {
   History:
   ~~~~~~~~
   30.Oct.94 v1.0 Release of 1st version <simao@ctd.comsat.com>
+  16.Oct.26 v1.1 Fast mode.
 
  ============================================================================
 */
 long cascade_iir_kernel (long lseg, float *x_ptr, CASCADE_IIR * iir_ptr, float *y_ptr) {
-  if (iir_ptr->hswitch == 'U')
+  if (iir_ptr->mode == IIR_FAST)
+    return cascade_iir_kernel_multi (1, lseg, x_ptr, iir_ptr, y_ptr);
+  else if (iir_ptr->hswitch == 'U')
     return cascade_form_iir_up_kernel ( /* returns number of output samples */
                                         lseg,   /* In : input signal leng. */
                                         x_ptr,  /* In : input sample array */
@@ -852,6 +1057,11 @@ CASCADE_IIR *cascade_iir_init (long nblocks, float (*a)[2], float (*b)[2], doubl
   /* Store switch to IIR-kernel procedure */
   ptrIIR->hswitch = hswitch;
 
+  /* Strict kernel; the fast kernels allocate their state when selected */
+  ptrIIR->mode = IIR_STRICT;
+  ptrIIR->nbpad = ptrIIR->nchan = 0;
+  ptrIIR->C = ptrIIR->S = NULL;
+
   /* Clear state variables */
   T_ptr = ptrIIR->T;
   for (n = 0; n < nblocks; n++) {
@@ -903,6 +1113,8 @@ CASCADE_IIR *cascade_iir_init (long nblocks, float (*a)[2], float (*b)[2], doubl
  ============================================================================
 */
 void cascade_iir_free (CASCADE_IIR * iir_ptr) {
+  iir_free_aligned (iir_ptr->C);        /* free fast-kernel coefficients */
+  free (iir_ptr->S);            /* free fast-kernel state */
   free (iir_ptr->T);            /* free state variables */
   free (iir_ptr);               /* free allocated struct */
 }
@@ -0,0 +1,594 @@
+/*                                                            16.Oct.2026 v1.0
+  =============================================================================
+
+                          U    U   GGG    SSSS  TTTTT
+                          U    U  G       S       T
+                          U    U  G  GG   SSSS    T
+                          U    U  G   G       S   T
+                           UUU     GG     SSS     T
+
+                   ========================================
+                    ITU-T - USER'S GROUP ON SOFTWARE TOOLS
+                   ========================================
+
+       =============================================================
+       COPYRIGHT NOTE: This source code, and all of its derivations,
+       is subject to the "ITU-T General Public License". Please have
+       it  read  in    the  distribution  disk,   or  in  the  ITU-T
+       Recommendation G.191 on "SOFTWARE TOOLS FOR SPEECH AND  AUDIO
+       CODING STANDARDS".
+       =============================================================
+
+MODULE:         IIR-PAR.C, IIR FILTER MODULE
+                Sub-unit with the multi-threaded kernels for long segments
+
+DESCRIPTION:
+
+        This file contains multi-threaded versions of stdpcm_kernel()
+        and direct_iir_kernel(), meant for the off-line filtering of
+        long files in large segments. The filters are linear, hence the
+        output of a segment is the sum of the zero-state response (the
+        segment filtered from a null state) and of the zero-input
+        response (the state at the start of the segment, filtered with
+        a null input). The segment is split into chunks:
+
+          1. all the chunks are filtered in parallel, the first one from
+             the state of the filter and the other ones from a null
+             state, with the original kernels of iir-lib.c;
+          2. chunk by chunk, the zero-input response of the state at the
+             end of the previous chunk is added to the output, and to
+             the final (zero-state) state of the chunk, which gives the
+             state at the start of the next chunk.
+
+        The zero-input response of a stable filter decays, and step 2
+        stops as soon as the state has fallen below IIR_PAR_EPS times
+        its initial value; the serial part of the work is hence short
+        compared to the chunks. The output differs from the serial
+        kernels by rounding only (float state variables).
+
+        Threads are created with POSIX threads when IIR_PTHREADS is
+        defined (see CMakeLists.txt); otherwise the chunks are filtered
+        one after the other, with the same result.
+
+FUNCTIONS:
+  Global (have prototype in iirflt.h)
+         = stdpcm_kernel_parallel(...)     : multi-threaded stdpcm_kernel()
+         = direct_iir_kernel_parallel(...) : multi-threaded
+                                             direct_iir_kernel()
+
+  Local (should be used only here -- prototypes only in this file)
+         = iir_par_kernel(...)     : split, run and fix-up of the chunks
+         = iir_par_run(...)        : filter one chunk (thread body)
+         = iir_par_zir_scd(...)    : zero-input response, parallel form
+         = iir_par_zir_direct(...) : zero-input response, direct form
+         = iir_par_max(...)        : largest state variable
+
+HISTORY:
+    16.Oct.2026 v1.0 Created.
+
+  =============================================================================
+*/
+
+
+/*
+ * ......... INCLUDES .........
+ */
+#include <stdlib.h>             /* General utility definitions */
+#include <string.h>             /* memcpy() */
+#include <math.h>               /* fabs() */
+
+#include "iirflt.h"             /* Definitions for IIR filters */
+
+#ifdef IIR_PTHREADS
+#include <pthread.h>
+#include <unistd.h>             /* sysconf() */
+#endif
+
+
+/*
+ * ......... Local definitions .........
+ */
+
+/* Min.number of input samples per chunk; shorter segments are filtered serially */
+#define IIR_PAR_MINLEN 1024
+
+/* Max.number of chunks (threads) */
+#define IIR_PAR_MAXTHREADS 64
+
+/* Relative level under which the zero-input response is neglected */
+#define IIR_PAR_EPS 1e-9
+
+/* Forms of the filters */
+#define IIR_PAR_SCD    0        /* parallel form, SCD_IIR */
+#define IIR_PAR_DIRECT 1        /* direct form, DIRECT_IIR */
+
+/* One chunk of the segment */
+typedef struct {
+  int form;                     /* IIR_PAR_SCD or IIR_PAR_DIRECT */
+  SCD_IIR scd;                  /* copy of the filter (own state) */
+  DIRECT_IIR dir;               /* copy of the filter (own state) */
+  long lenx;                    /* number of input samples */
+  float *x;                     /* input samples */
+  float *y;                     /* output samples */
+  long ny;                      /* number of output samples */
+} IIR_PAR_CHUNK;
+
+
+/*
+ * ......... Local function prototypes .........
+ */
+static long iir_par_kernel ARGS ((int form, long lseg, float *x_ptr, void *iir_ptr, float *y_ptr, int nthreads));
+static void *iir_par_run ARGS ((void *arg));
+static void iir_par_zir_scd ARGS ((SCD_IIR * iir, double (*s)[2], long k0, long lenx, float *y));
+static void iir_par_zir_direct ARGS ((DIRECT_IIR * iir, double (*s)[2], long k0, long lenx, float *y));
+static double iir_par_max ARGS ((double (*s)[2], long n0, long nblocks));
+
+
+/*
+ * ...................... BEGIN OF FUNCTIONS .........................
+ */
+
+/*
+  ============================================================================
+
+        long stdpcm_kernel_parallel (long lseg, float *x_ptr,
+        ~~~~~~~~~~~~~~~~~~~~~~~~~~~  SCD_IIR *iir_ptr, float *y_ptr,
+                                     int nthreads);
+
+        Description:
+        ~~~~~~~~~~~~
+
+        Same as stdpcm_kernel(), with the segment split in up to
+        `nthreads' chunks filtered in parallel. Segments shorter than
+        2*IIR_PAR_MINLEN samples are filtered by stdpcm_kernel().
+
+        Parameters:
+        ~~~~~~~~~~~
+        lseg: ...... number of input samples
+        x_ptr: ..... array with input samples
+        iir_ptr: ... pointer to IIR-struct (SCD_IIR *)
+        y_ptr: ..... output samples
+        nthreads: .. max.number of threads; 0 for the number of
+                     processors
+
+        Return value:
+        ~~~~~~~~~~~~~
+        Returns the number of output samples.
+
+        History:
+        ~~~~~~~~
+        16.Oct.2026 v1.0 Created.
+
+ ============================================================================
+*/
+long stdpcm_kernel_parallel (long lseg, float *x_ptr, SCD_IIR * iir_ptr, float *y_ptr, int nthreads) {
+  return iir_par_kernel (IIR_PAR_SCD, lseg, x_ptr, iir_ptr, y_ptr, nthreads);
+}
+
+/* ................... End of stdpcm_kernel_parallel() ................... */
+
+
+/*
+  ============================================================================
+
+        long direct_iir_kernel_parallel (long lseg, float *x_ptr,
+        ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~  DIRECT_IIR *iir_ptr,
+                                         float *y_ptr, int nthreads);
+
+        Description:
+        ~~~~~~~~~~~~
+
+        Same as direct_iir_kernel(), with the segment split in up to
+        `nthreads' chunks filtered in parallel. Segments shorter than
+        2*IIR_PAR_MINLEN samples are filtered by direct_iir_kernel().
+
+        Parameters:
+        ~~~~~~~~~~~
+        lseg: ...... number of input samples
+        x_ptr: ..... array with input samples
+        iir_ptr: ... pointer to IIR-struct (DIRECT_IIR *)
+        y_ptr: ..... output samples
+        nthreads: .. max.number of threads; 0 for the number of
+                     processors
+
+        Return value:
+        ~~~~~~~~~~~~~
+        Returns the number of output samples.
+
+        History:
+        ~~~~~~~~
+        16.Oct.2026 v1.0 Created.
+
+ ============================================================================
+*/
+long direct_iir_kernel_parallel (long lseg, float *x_ptr, DIRECT_IIR * iir_ptr, float *y_ptr, int nthreads) {
+  return iir_par_kernel (IIR_PAR_DIRECT, lseg, x_ptr, iir_ptr, y_ptr, nthreads);
+}
+
+/* ................. End of direct_iir_kernel_parallel() ................. */
+
+
+/*
+  ============================================================================
+
+        static long iir_par_kernel (int form, long lseg, float *x_ptr,
+        ~~~~~~~~~~~~~~~~~~~~~~~~~~  void *iir_ptr, float *y_ptr,
+                                    int nthreads);
+
+        Description:
+        ~~~~~~~~~~~~
+
+        Split the segment in chunks, filter them in parallel, and add
+        the zero-input responses carried over from one chunk to the
+        next. On return, the state of the filter is the one at the end
+        of the segment, as after the serial kernel.
+
+        Falls back to the serial kernel when the segment is too short,
+        or when out of memory.
+
+        Parameters:
+        ~~~~~~~~~~~
+        form: ...... IIR_PAR_SCD or IIR_PAR_DIRECT
+        lseg: ...... number of input samples
+        x_ptr: ..... array with input samples
+        iir_ptr: ... pointer to the SCD_IIR or DIRECT_IIR struct
+        y_ptr: ..... output samples
+        nthreads: .. max.number of threads; 0 for the number of
+                     processors
+
+        Return value:
+        ~~~~~~~~~~~~~
+        Returns the number of output samples.
+
+        History:
+        ~~~~~~~~
+        16.Oct.2026 v1.0 Created.
+
+ ============================================================================
+*/
+static long iir_par_kernel (int form, long lseg, float *x_ptr, void *iir_ptr, float *y_ptr, int nthreads) {
+  SCD_IIR *scd = (SCD_IIR *) iir_ptr;
+  DIRECT_IIR *dir = (DIRECT_IIR *) iir_ptr;
+  IIR_PAR_CHUNK *chunk;
+  float (*T)[2], (*T0)[2];
+  double (*s)[2];
+  long nstate, idown, k0, iup, start, ny, n, p;
+  int nchunk;
+  char hswitch;
+#ifdef IIR_PTHREADS
+  pthread_t tid[IIR_PAR_MAXTHREADS];
+  char started[IIR_PAR_MAXTHREADS];
+#endif
+
+  /* Parameters of the filter */
+  if (form == IIR_PAR_SCD) {
+    nstate = scd->nblocks;
+    idown = scd->idown;
+    k0 = scd->k0;
+    hswitch = scd->hswitch;
+    T0 = scd->T;
+  } else {
+    nstate = (dir->poleno > dir->zerono) ? dir->poleno : dir->zerono;
+    idown = dir->idown;
+    k0 = dir->k0;
+    hswitch = dir->hswitch;
+    T0 = dir->T;
+  }
+  iup = (hswitch == 'U') ? idown : 1;
+  if (hswitch == 'U')
+    idown = 1;
+
+  /* Number of chunks */
+#ifdef IIR_PTHREADS
+  if (nthreads <= 0)
+    nthreads = (int) sysconf (_SC_NPROCESSORS_ONLN);
+#endif
+  if (nthreads > IIR_PAR_MAXTHREADS)
+    nthreads = IIR_PAR_MAXTHREADS;
+  nchunk = (lseg / IIR_PAR_MINLEN < nthreads) ? (int) (lseg / IIR_PAR_MINLEN) : nthreads;
+
+  /* Allocate the chunks, their state variables and the zero-input state */
+  chunk = NULL;
+  T = NULL;
+  s = NULL;
+  if (nchunk > 1) {
+    chunk = (IIR_PAR_CHUNK *) malloc (nchunk * sizeof (IIR_PAR_CHUNK));
+    T = (float (*)[2]) calloc (nchunk * nstate, sizeof (*T));
+    s = (double (*)[2]) malloc (nstate * sizeof (*s));
+  }
+  if (chunk == NULL || T == NULL || s == NULL) {
+    free (chunk);
+    free (T);
+    free (s);
+    return (form == IIR_PAR_SCD) ? stdpcm_kernel (lseg, x_ptr, scd, y_ptr) : direct_iir_kernel (lseg, x_ptr, dir, y_ptr);
+  }
+
+  /* Chunks, each with its own copy of the filter; the 1st one starts from the state of the filter, the other ones from a null state */
+  for (ny = 0, p = 0; p < nchunk; p++) {
+    start = lseg * p / nchunk;
+    chunk[p].form = form;
+    chunk[p].lenx = lseg * (p + 1) / nchunk - start;
+    chunk[p].x = x_ptr + start;
+    chunk[p].y = y_ptr + ny;
+    if (p == 0)
+      memcpy (T, T0, nstate * sizeof (*T));
+    if (form == IIR_PAR_SCD) {
+      chunk[p].scd = *scd;
+      chunk[p].scd.T = T + p * nstate;
+      chunk[p].scd.k0 = (k0 + start) % idown;
+    } else {
+      chunk[p].dir = *dir;
+      chunk[p].dir.T = T + p * nstate;
+      chunk[p].dir.k0 = (k0 + start) % idown;
+    }
+
+    /* Output samples of the chunk: one every idown input samples (at k0 % idown == 0), or iup per input sample */
+    ny += (hswitch == 'U') ? chunk[p].lenx * iup : (k0 + start + chunk[p].lenx + idown - 1) / idown - (k0 + start + idown - 1) / idown;
+  }
+
+  /* Filter all the chunks; the calling thread filters the 1st one */
+#ifdef IIR_PTHREADS
+  for (p = 1; p < nchunk; p++)
+    started[p] = pthread_create (&tid[p], NULL, iir_par_run, &chunk[p]) == 0;
+  iir_par_run (&chunk[0]);
+  for (p = 1; p < nchunk; p++)
+    if (started[p])
+      pthread_join (tid[p], NULL);
+    else
+      iir_par_run (&chunk[p]);
+#else
+  for (p = 0; p < nchunk; p++)
+    iir_par_run (&chunk[p]);
+#endif
+
+  /* Add the zero-input response of the state at the end of the previous chunk */
+  for (p = 1; p < nchunk; p++) {
+    for (n = 0; n < nstate; n++) {
+      s[n][0] = T[(p - 1) * nstate + n][0];
+      s[n][1] = T[(p - 1) * nstate + n][1];
+    }
+    start = chunk[p].x - x_ptr;
+    if (form == IIR_PAR_SCD)
+      iir_par_zir_scd (scd, s, (k0 + start) % idown, chunk[p].lenx, chunk[p].y);
+    else
+      iir_par_zir_direct (dir, s, (k0 + start) % idown, chunk[p].lenx, chunk[p].y);
+    for (n = 0; n < nstate; n++) {
+      T[p * nstate + n][0] += s[n][0];
+      T[p * nstate + n][1] += s[n][1];
+    }
+  }
+
+  /* State at the end of the segment */
+  memcpy (T0, T + (nchunk - 1) * nstate, nstate * sizeof (*T));
+  if (form == IIR_PAR_SCD && hswitch != 'U')
+    scd->k0 = (k0 + lseg) % idown;
+  else if (form == IIR_PAR_DIRECT && hswitch != 'U')
+    dir->k0 = (k0 + lseg) % idown;
+
+  free (chunk);
+  free (T);
+  free (s);
+  return ny;
+}
+
+/* ....................... End of iir_par_kernel() ....................... */
+
+
+/*
+  ============================================================================
+
+        static void *iir_par_run (void *arg);
+        ~~~~~~~~~~~~~~~~~~~~~~~~
+
+        Description:
+        ~~~~~~~~~~~~
+
+        Filter one chunk with the serial kernel (thread body).
+
+        Parameters:
+        ~~~~~~~~~~~
+        arg: ... (InOut) pointer to the IIR_PAR_CHUNK
+
+        Return value:
+        ~~~~~~~~~~~~~
+        NULL.
+
+        History:
+        ~~~~~~~~
+        16.Oct.2026 v1.0 Created.
+
+ ============================================================================
+*/
+static void *iir_par_run (void *arg) {
+  IIR_PAR_CHUNK *chunk = (IIR_PAR_CHUNK *) arg;
+
+  if (chunk->form == IIR_PAR_SCD)
+    chunk->ny = stdpcm_kernel (chunk->lenx, chunk->x, &chunk->scd, chunk->y);
+  else
+    chunk->ny = direct_iir_kernel (chunk->lenx, chunk->x, &chunk->dir, chunk->y);
+  return NULL;
+}
+
+/* ......................... End of iir_par_run() ......................... */
+
+
+/*
+  ============================================================================
+
+        static void iir_par_zir_scd (SCD_IIR *iir, double (*s)[2],
+        ~~~~~~~~~~~~~~~~~~~~~~~~~~~  long k0, long lenx, float *y);
+
+        Description:
+        ~~~~~~~~~~~~
+
+        Add to the output of a chunk the zero-input response of the
+        parallel-form filter from state s (same recursion as in
+        scd_parallel_form_iir_{down,up}_kernel() of iir-lib.c, with a
+        null input). The response is computed until it decays under
+        IIR_PAR_EPS times the initial state, or up to the end of the
+        chunk. On return, s is the state at the end of the chunk.
+
+        Parameters:
+        ~~~~~~~~~~~
+        iir: ... (In)    filter (coefficients)
+        s: ..... (InOut) state variables, as the T of the filter
+        k0: .... (In)    modulo counter at the start of the chunk
+        lenx: .. (In)    number of input samples of the chunk
+        y: ..... (InOut) output samples of the chunk
+
+        Return value:
+        ~~~~~~~~~~~~~
+        None.
+
+        History:
+        ~~~~~~~~
+        16.Oct.2026 v1.0 Created.
+
+ ============================================================================
+*/
+static void iir_par_zir_scd (SCD_IIR * iir, double (*s)[2], long k0, long lenx, float *y) {
+  long nblocks = iir->nblocks, n, kx, ky, nstep, iup, idown;
+  double smax, lim, yj, t;
+
+  /* Output phases */
+  iup = (iir->hswitch == 'U') ? iir->idown : 1;
+  idown = (iir->hswitch == 'U') ? 1 : iir->idown;
+  nstep = lenx * iup;
+
+  /* Level under which the response is neglected */
+  smax = iir_par_max (s, 0, nblocks);
+  lim = smax * IIR_PAR_EPS;
+
+  for (ky = 0, kx = 0; kx < nstep && smax > lim; kx++) {
+    yj = 0;
+    for (n = 0; n < nblocks; n++) {
+      t = 2. * (-iir->c[n][0] * s[n][0] - iir->c[n][1] * s[n][1]);
+      yj += iir->b[n][2] * t + iir->b[n][1] * s[n][1] + iir->b[n][0] * s[n][0];
+      s[n][0] = s[n][1];
+      s[n][1] = t;
+    }
+    smax = iir_par_max (s, 0, nblocks);
+    if ((k0 + kx) % idown == 0)
+      y[ky++] += yj * iir->gain;
+  }
+
+  /* Neglected response: the state is null at the end of the chunk */
+  if (kx < nstep)
+    memset (s, 0, nblocks * sizeof (*s));
+}
+
+/* ..................... End of iir_par_zir_scd() ..................... */
+
+
+/*
+  ============================================================================
+
+        static void iir_par_zir_direct (DIRECT_IIR *iir, double (*s)[2],
+        ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~  long k0, long lenx, float *y);
+
+        Description:
+        ~~~~~~~~~~~~
+
+        Same as iir_par_zir_scd() for the direct-form filter (recursion
+        of direct_form_iir_{down,up}_kernel() of iir-lib.c).
+
+        Parameters:
+        ~~~~~~~~~~~
+        iir: ... (In)    filter (coefficients)
+        s: ..... (InOut) past samples, as the T of the filter
+        k0: .... (In)    modulo counter at the start of the chunk
+        lenx: .. (In)    number of input samples of the chunk
+        y: ..... (InOut) output samples of the chunk
+
+        Return value:
+        ~~~~~~~~~~~~~
+        None.
+
+        History:
+        ~~~~~~~~
+        16.Oct.2026 v1.0 Created.
+
+ ============================================================================
+*/
+static void iir_par_zir_direct (DIRECT_IIR * iir, double (*s)[2], long k0, long lenx, float *y) {
+  long zerono = iir->zerono, poleno = iir->poleno, nblocks, n, kx, ky, nstep, iup, idown;
+  double smax, lim, yj;
+
+  /* Output phases */
+  nblocks = (poleno > zerono) ? poleno : zerono;
+  iup = (iir->hswitch == 'U') ? iir->idown : 1;
+  idown = (iir->hswitch == 'U') ? 1 : iir->idown;
+  nstep = lenx * iup;
+
+  /* Level under which the response is neglected (s[0][0] is overwritten by the next input sample) */
+  smax = iir_par_max (s, 1, nblocks);
+  lim = smax * IIR_PAR_EPS;
+
+  for (ky = 0, kx = 0; kx < nstep && smax > lim; kx++) {
+    s[0][0] = 0;
+    for (yj = 0, n = 0; n < zerono; n++)
+      yj += iir->a[n] * s[n][0];
+    for (n = 1; n < poleno; n++)
+      yj -= iir->b[n] * s[n - 1][1];
+    for (n = zerono - 1; n > 0; n--)
+      s[n][0] = s[n - 1][0];
+    for (n = poleno - 1; n > 0; n--)
+      s[n][1] = s[n - 1][1];
+    s[0][1] = yj;
+
+    smax = iir_par_max (s, 1, nblocks);
+    if ((k0 + kx) % idown == 0)
+      y[ky++] += yj * iir->gain;
+  }
+
+  /* Neglected response: the state is null at the end of the chunk */
+  if (kx < nstep)
+    memset (s, 0, nblocks * sizeof (*s));
+}
+
+/* .................... End of iir_par_zir_direct() .................... */
+
+/*
+  ============================================================================
+
+        static double iir_par_max (double (*s)[2], long n0, long nblocks);
+        ~~~~~~~~~~~~~~~~~~~~~~~~~
+
+        Description:
+        ~~~~~~~~~~~~
+
+        Largest magnitude of the state variables s[n0..nblocks-1][0] and
+        s[0..nblocks-1][1].
+
+        Parameters:
+        ~~~~~~~~~~~
+        s: ......... (In) state variables
+        n0: ........ (In) first of the s[][0] to consider
+        nblocks: ... (In) number of pairs of state variables
+
+        Return value:
+        ~~~~~~~~~~~~~
+        The largest magnitude.
+
+        History:
+        ~~~~~~~~
+        16.Oct.2026 v1.0 Created.
+
+ ============================================================================
+*/
+static double iir_par_max (double (*s)[2], long n0, long nblocks) {
+  double smax = 0;
+  long n;
+
+  for (n = 0; n < nblocks; n++) {
+    if (n >= n0 && fabs (s[n][0]) > smax)
+      smax = fabs (s[n][0]);
+    if (fabs (s[n][1]) > smax)
+      smax = fabs (s[n][1]);
+  }
+  return smax;
+}
+
+/* ........................ End of iir_par_max() ........................ */
+
+/* ............................ End of IIR-PAR.C ........................... */
@@ -1,6 +1,6 @@
 /*
   ============================================================================
-   File: IIRFLT.H                                     Version: 3.0 - 31.JUL.95
+   File: IIRFLT.H                                     Version: 3.1 - 16.OCT.26
   ============================================================================
 
                             UGST/ITU-T IIR FILTERS
@@ -12,12 +12,17 @@
    30.Oct.94	v2.0	Name changed to iirflt.h/included cascade-form 
                         IIR filters <simao@ctd.comsat.com>
    31.Jul.95	v3.0	Added direct-form IIR filters <simao@ctd.comsat.com>
+   16.Oct.26	v3.1	Added fast (transposed direct-form II) cascade-form
+                        kernels for one or several interleaved channels
+                        Added multi-threaded parallel- and direct-form
+                        kernels for long segments (iir-par.c)
+                        Packed coefficients of the parallel form
 
   ============================================================================
 */
 
 #ifndef IIRFLT_IIRstruct_defined
-#define IIRFLT_IIRstruct_defined  300
+#define IIRFLT_IIRstruct_defined  310
 
 
 /* DEFINITION FOR SMART PROTOTYPES */
@@ -43,6 +48,8 @@ typedef struct {
   float (*c)[2];                /* In : denominator coefficients */
   float (*T)[2];                /* In/Out : state variables */
   char hswitch;                 /* "U": upsampling; else downsampling */
+  long nbpad;                   /* nblocks rounded up for the packed coefficients */
+  float *P;                     /* packed coefficients c0,c1,b0,b1,b2 (5 x nbpad) */
 } SCD_IIR;
 
 
@@ -58,8 +65,17 @@ typedef struct {
   float (*b)[2];                /* In : denominator coefficients */
   float (*T)[4];                /* In/Out : state variables, 1 for each stage */
   char hswitch;                 /* "U": upsampling; else downsampling */
+  char mode;                    /* kernel mode: IIR_STRICT or IIR_FAST */
+  long nbpad;                   /* nblocks rounded up to the SIMD width */
+  long nchan;                   /* number of channels of the state S */
+  double *C;                    /* TDF-II coefficients a0,a1,b0,b1 (4 x nbpad) */
+  double *S;                    /* TDF-II state: s1 and s2 (2 x nbpad x nchan) and stage outputs (nbpad) */
 } CASCADE_IIR;
 
+/* Kernel modes for cascade_iir_mode() */
+#define IIR_STRICT      0       /* direct form I, float state: original STL kernels (bit-exact) */
+#define IIR_FAST        1       /* transposed direct form II, double state, stages pipelined */
+
 
 /*
  * ..... State variable structure for IIR filtering, direct form  .....
@@ -86,6 +102,7 @@ typedef struct {
 long stdpcm_kernel ARGS ((long lseg, float *x_ptr, SCD_IIR * iir_ptr, float *y_ptr));
 void stdpcm_free ARGS ((SCD_IIR * iir_ptr));
 void stdpcm_reset ARGS ((SCD_IIR * iir_ptr));
+long stdpcm_kernel_parallel ARGS ((long lseg, float *x_ptr, SCD_IIR * iir_ptr, float *y_ptr, int nthreads));
 
 /* Originals of the STL92: parallel IIR filter initialization */
 SCD_IIR *stdpcm_16khz_init ARGS ((void));
@@ -97,6 +114,8 @@ SCD_IIR *stdpcm_1_to_2_init ARGS ((void));
 long cascade_iir_kernel ARGS ((long lseg, float *x_ptr, CASCADE_IIR * iir_ptr, float *y_ptr));
 void cascade_iir_reset ARGS ((CASCADE_IIR * iir_ptr));
 void cascade_iir_free ARGS ((CASCADE_IIR * iir_ptr));
+int cascade_iir_mode ARGS ((CASCADE_IIR * iir_ptr, int mode));
+long cascade_iir_kernel_multi ARGS ((int nchan, long lseg, float *x_ptr, CASCADE_IIR * iir_ptr, float *y_ptr));
 
 /* Additions to the STL92: cascade IIR filter initialization */
 CASCADE_IIR *iir_G712_8khz_init ARGS ((void));
@@ -109,6 +128,7 @@ CASCADE_IIR *iir_casc_lp_1_to_3_init ARGS ((void));
 long direct_iir_kernel ARGS ((long lseg, float *x_ptr, DIRECT_IIR * iir_ptr, float *y_ptr));
 void direct_reset ARGS ((DIRECT_IIR * iir_ptr));
 void direct_iir_free ARGS ((DIRECT_IIR * iir_ptr));
+long direct_iir_kernel_parallel ARGS ((long lseg, float *x_ptr, DIRECT_IIR * iir_ptr, float *y_ptr, int nthreads));
 
 /* Additions to the STL92: direct IIR filter initialization */
 DIRECT_IIR *iir_dir_dc_removal_init ARGS ((void));
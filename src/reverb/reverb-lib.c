@@ -26,11 +26,35 @@
   FUNCTIONS :
 	Global (have prototype in reverb-lib.h)
 		shift(...)		:		Shift coefficients of the input buffer for next block filtering
+		ring_init(...)	:		Mirrored ring buffer of the input history of conv()
+		ring_push(...)	:		Append a block to the ring, window of conv() without copy
+		ring_free(...)	:		Release the ring buffer
 		conv(...)		:		Convolves the impulse response of a room with the input file
+		conv_fft_init(...)	:		Spectra of the partitions of the impulse response
+		conv_fft(...)	:		Same as conv(), by uniformly partitioned FFT convolution
+		conv_fft_free(...)	:		Release the state of conv_fft()
+		conv_nu_init(...)	:		Non-uniform partitions of the impulse response
+		conv_nu(...)	:		Same as conv(), low-latency non-uniform partitioned convolution
+		conv_nu_free(...)	:		Release the state of conv_nu()
+		conv_mc_init(...)	:		Partition spectra of a matrix of impulse responses
+		conv_mc(...)	:		Multichannel convolution, nin inputs to nout outputs
+		conv_mc_free(...)	:		Release the state of conv_mc()
 
   HISTORY :
 	02.Feb.05	v1.0	First Beta version
     10.jul.08   v1.01   Added 16 bit saturation and saturation warning
+    16.Oct.26   v1.02   Added uniformly partitioned FFT convolution (conv_fft):
+                        overlap-save with FFTs of 2B points, the spectra of the
+                        IR partitions computed once; same output as conv() up
+                        to float rounding, same saturation and alignFact
+                        Added non-uniform partitioned convolution (conv_nu):
+                        short partitions at the head of the IR for calls of
+                        a few ms, longer ones in the tail
+                        Added the mirrored input ring buffer (ring_*): O(L)
+                        per block of L samples instead of the O(N) shift()
+                        Added multichannel convolution (conv_mc): matrix of
+                        nin x nout impulse responses, the spectrum of each
+                        input block shared by all the outputs
 
   AUTHORS :
 	v1.0 Cyril Guillaume & Stephane Ragot -- stephane.ragot@francetelecom.com
@@ -38,6 +62,15 @@
 
 */
 
+#include <stdlib.h>
+#include <string.h>
+
+#include "fft.h"
+#include "reverb-lib.h"
+
+#define CONV_FFT_BLK 4096       /* max. default partition length */
+#define CONV_FFT_MINBLK 16      /* min. partition length */
+#define CONV_FFT_MAXBLK (1L << 20)      /* max. partition length */
 
 
 /* this routine replaces the first N-1 samples of a buffer by the last N-1 samples */
@@ -50,6 +83,56 @@ void shift (short *buff, long N) {
 }
 
 
+/* this routine allocates a ring for an impulse response of N taps and blocks of at most L samples */
+IN_RING *ring_init (long N, long L) {
+  IN_RING *ring;
+
+  if ((ring = (IN_RING *) calloc (1, sizeof (IN_RING))) == NULL)
+    return NULL;
+  ring->N = (N > 0) ? N : 1;
+  ring->R = ring->N - 1 + ((L > 0) ? L : 1);
+  ring->pos = 0;
+  if ((ring->buf = (short *) calloc (2 * ring->R, sizeof (short))) == NULL) {
+    free (ring);
+    return NULL;
+  }
+  return ring;
+}
+
+
+/* this routine appends a block of L samples to the ring, and returns the window of the N-1 past samples and the block */
+/* the window starts at pos < R and is at most R long, so it is contiguous in buf[0..2R-1] */
+short *ring_push (IN_RING * ring, short *block, long L) {
+  short *window = ring->buf + ring->pos;
+  long i, q;
+
+  /* New samples after the N-1 past ones, written twice */
+  q = ring->pos + ring->N - 1;
+  if (q >= ring->R)
+    q -= ring->R;
+  for (i = 0; i < L; i++) {
+    ring->buf[q] = ring->buf[q + ring->R] = block[i];
+    if (++q == ring->R)
+      q = 0;
+  }
+
+  /* The oldest past sample of the next block */
+  ring->pos += L;
+  if (ring->pos >= ring->R)
+    ring->pos -= ring->R;
+  return window;
+}
+
+
+/* this routine releases the ring buffer */
+void ring_free (IN_RING * ring) {
+  if (ring == NULL)
+    return;
+  free (ring->buf);
+  free (ring);
+}
+
+
 /* this routine convolves buffIn with IR and stores the processed data into buffRvb */
 /* alignFact is used to align the energy of the input file with an other file */
 /* the ouput sat_warning is used to provide a warning of there is 16 bit saturation, 
@@ -97,3 +180,431 @@ void conv_old (float *IR, short *buffIn, short *buffRvb, float alignFact, long N
     buffRvb[k] = (short) (alignFact * tmpRvb + 0.5);    /* +0.5 : rounding during the 'short' truncation */
   }
 }
+
+
+/* this routine accumulates the product of 2 real spectra of n points packed as by fft_plan_exec_real(): y += x * h */
+static void spec_mac (float *y, const float *x, const float *h, long n) {
+  long k;
+
+  y[0] += x[0] * h[0];          /* DC */
+  y[1] += x[1] * h[1];          /* Nyquist */
+  for (k = 2; k < n; k += 2) {
+    y[k] += x[k] * h[k] - x[k + 1] * h[k + 1];
+    y[k + 1] += x[k] * h[k + 1] + x[k + 1] * h[k];
+  }
+}
+
+
+/* this routine releases the state of conv_fft() */
+void conv_fft_free (CONV_FFT * cf) {
+  if (cf == NULL)
+    return;
+  free (cf->H);
+  free (cf->X);
+  free (cf->xb);
+  free (cf->Xc);
+  free (cf->Yt);
+  free (cf->y);
+  free (cf);
+}
+
+
+/* this routine returns the partition length of conv_fft_init() for an IR of N taps and the requested length B */
+static long conv_fft_blklen (long N, long B) {
+  long b;
+
+  if (B <= 0)
+    for (B = CONV_FFT_BLK; B > CONV_FFT_MINBLK && 4 * B > N; B /= 2);
+  if (B > CONV_FFT_MAXBLK)
+    B = CONV_FFT_MAXBLK;
+  for (b = CONV_FFT_MINBLK; b < B; b <<= 1);
+  return b;
+}
+
+
+/* this routine allocates the state of conv_fft(), and computes the spectra of the partitions of IR */
+/* B is the partition length: rounded up to a power of 2, 0 for the default (about N/4, at most CONV_FFT_BLK: */
+/* longer partitions need less operations per sample, but a call that ends inside a partition costs 2 FFTs of 2B) */
+CONV_FFT *conv_fft_init (float *IR, long N, long B) {
+  CONV_FFT *cf;
+  long n2, p, k;
+
+  /* Partition length and number of partitions */
+  B = conv_fft_blklen (N, B);
+  n2 = 2 * B;
+
+  if ((cf = (CONV_FFT *) calloc (1, sizeof (CONV_FFT))) == NULL)
+    return NULL;
+  cf->N = N;
+  cf->B = B;
+  cf->P = (N > B) ? (N + B - 1) / B : 1;
+  cf->plan = fft_plan_get ((int) n2);
+  cf->H = (float *) calloc (cf->P * n2, sizeof (float));
+  cf->X = (float *) calloc (cf->P * n2, sizeof (float));
+  cf->xb = (float *) calloc (n2, sizeof (float));
+  cf->Xc = (float *) malloc (n2 * sizeof (float));
+  cf->Yt = (float *) malloc (n2 * sizeof (float));
+  cf->y = (float *) malloc (n2 * sizeof (float));
+  if (cf->plan == NULL || cf->H == NULL || cf->X == NULL || cf->xb == NULL || cf->Xc == NULL || cf->Yt == NULL || cf->y == NULL) {
+    conv_fft_free (cf);
+    return NULL;
+  }
+
+  /* Spectra of the partitions: B taps followed by B zeros */
+  for (p = 0; p < cf->P; p++) {
+    for (k = 0; k < B && p * B + k < N; k++)
+      cf->H[p * n2 + k] = IR[p * B + k];
+    fft_plan_exec_real (cf->plan, cf->H + p * n2);
+  }
+
+  cf->nblk = 0;
+  cf->fill = 0;
+  cf->ytblk = -1;
+  return cf;
+}
+
+
+/* this routine appends m samples (at most B-fill) to the current block of cf */
+static void conv_fft_push (CONV_FFT * cf, short *x, long m) {
+  long i;
+
+  for (i = 0; i < m; i++)
+    cf->xb[cf->B + cf->fill + i] = x[i];
+  cf->fill += m;
+}
+
+
+/* this routine computes in y[B..2B-1] the output of the current block of cf (zeros for its samples not received yet) */
+static void conv_fft_output (CONV_FFT * cf) {
+  long n2 = 2 * cf->B;
+  long p;
+
+  /* Once per block: output spectrum of the partitions 1..P-1 with the previous blocks */
+  if (cf->ytblk != cf->nblk) {
+    memset (cf->Yt, 0, n2 * sizeof (float));
+    for (p = 1; p < cf->P && p <= cf->nblk; p++)
+      spec_mac (cf->Yt, cf->X + ((cf->nblk - p) % cf->P) * n2, cf->H + p * n2, n2);
+    cf->ytblk = cf->nblk;
+  }
+
+  /* Spectrum of the current block after the previous one, output spectrum with partition 0 */
+  memcpy (cf->Xc, cf->xb, n2 * sizeof (float));
+  fft_plan_exec_real (cf->plan, cf->Xc);
+  memcpy (cf->y, cf->Yt, n2 * sizeof (float));
+  spec_mac (cf->y, cf->Xc, cf->H, n2);
+  fft_plan_exec_inverse (cf->plan, cf->y);
+}
+
+
+/* this routine moves cf to the next block, once the current one is complete and its output computed */
+static void conv_fft_next (CONV_FFT * cf) {
+  long B = cf->B;
+
+  /* Spectrum of the block to the delay line, and the block becomes the previous one */
+  memcpy (cf->X + (cf->nblk % cf->P) * 2 * B, cf->Xc, 2 * B * sizeof (float));
+  memcpy (cf->xb, cf->xb + B, B * sizeof (float));
+  memset (cf->xb + B, 0, B * sizeof (float));
+  cf->nblk++;
+  cf->fill = 0;
+}
+
+
+/* this routine convolves the next L input samples with the impulse response, as conv() */
+/* overlap-save by blocks of B samples; when a call ends inside a block, the output of its */
+/* first samples is computed with zeros for the next ones (the filter is causal), and the */
+/* block is computed again when its next samples are received */
+/* the ouput sat_warning is used to provide a warning of there is 16 bit saturation, 
+  a positive value indicates position of overflow */
+long conv_fft (CONV_FFT * cf, short *buffIn, short *buffRvb, float alignFact, long L) {
+  long k, m, i, first;
+  float tmpRvb;
+  long sat_warning;
+
+  sat_warning = -1;
+  for (k = 0; k < L; k += m) {
+    /* New samples of the current block, and output of the block */
+    m = (cf->B - cf->fill < L - k) ? cf->B - cf->fill : L - k;
+    first = cf->fill;
+    conv_fft_push (cf, buffIn + k, m);
+    conv_fft_output (cf);
+
+    for (i = 0; i < m; i++) {
+      tmpRvb = (float) (alignFact * cf->y[cf->B + first + i] + 0.5);    /* +0.5 : rounding for the 'short' truncation */
+
+      /* perform 16 bit saturation */
+      if (tmpRvb < -32768.0) {
+        buffRvb[k + i] = -32768;
+        sat_warning = k + i;
+      } else {
+        if (tmpRvb > 32767.0) {
+          buffRvb[k + i] = 32767;
+          sat_warning = k + i;
+        } else {
+          buffRvb[k + i] = (short) tmpRvb;
+        }
+      }
+    }
+
+    if (cf->fill == cf->B)
+      conv_fft_next (cf);
+  }
+  return sat_warning;
+}
+
+
+/* this routine releases the state of conv_nu() */
+void conv_nu_free (CONV_NU * cn) {
+  int s;
+
+  if (cn == NULL)
+    return;
+  for (s = 0; s < cn->nseg; s++)
+    conv_fft_free (cn->seg[s]);
+  free (cn->ring);
+  free (cn);
+}
+
+
+/* this routine allocates the state of conv_nu() for calls of L samples: the IR is cut in segments of */
+/* uniform partitions (conv_fft states), 2 partitions of B0 (power of 2 <= L) at the head, then 2 of */
+/* 2*B0, 2 of 4*B0, ... up to the tail, in partitions of Bmax (about N/4, at most CONV_FFT_BLK); */
+/* the offset of each segment in the IR is at least its partition length */
+CONV_NU *conv_nu_init (float *IR, long N, long L) {
+  CONV_NU *cn;
+  long B, Bmax, off, len;
+
+  if ((cn = (CONV_NU *) calloc (1, sizeof (CONV_NU))) == NULL)
+    return NULL;
+  cn->N = N;
+
+  /* Partition lengths */
+  for (cn->B0 = CONV_FFT_MINBLK; 2 * cn->B0 <= L && cn->B0 < CONV_FFT_MAXBLK; cn->B0 <<= 1);
+  for (Bmax = CONV_FFT_BLK; Bmax > cn->B0 && 4 * Bmax > N; Bmax /= 2);
+  if (Bmax < cn->B0)
+    Bmax = cn->B0;
+
+  /* Segments */
+  for (B = cn->B0, off = 0; off < N || cn->nseg == 0; B = (B < Bmax) ? 2 * B : B) {
+    len = (B < Bmax && cn->nseg < CONV_NU_MAXSEG - 1 && N - off > 2 * B) ? 2 * B : N - off;
+    cn->off[cn->nseg] = off;
+    if ((cn->seg[cn->nseg++] = conv_fft_init (IR + off, len, B)) == NULL) {
+      conv_nu_free (cn);
+      return NULL;
+    }
+    off += len;
+  }
+
+  /* Output ring: the segments after the head add their blocks up to off+B-1 samples ahead */
+  for (cn->R = 1; cn->R < off + Bmax + cn->B0; cn->R <<= 1);
+  if ((cn->ring = (float *) calloc (cn->R, sizeof (float))) == NULL) {
+    conv_nu_free (cn);
+    return NULL;
+  }
+  cn->rpos = 0;
+  return cn;
+}
+
+
+/* this routine convolves the next L input samples with the impulse response, as conv(), without latency: */
+/* the head segment computes its output for each call as conv_fft(); the output of the next segments, */
+/* computed when one of their blocks is complete, is added in a ring buffer of the future output samples */
+/* the ouput sat_warning is used to provide a warning of there is 16 bit saturation, 
+  a positive value indicates position of overflow */
+long conv_nu (CONV_NU * cn, short *buffIn, short *buffRvb, float alignFact, long L) {
+  CONV_FFT *head = cn->seg[0], *cf;
+  long mask = cn->R - 1;
+  long k, m, i, j, first;
+  int s;
+  float tmpRvb;
+  long sat_warning;
+
+  sat_warning = -1;
+  for (k = 0; k < L; k += m) {
+    /* New samples: up to the end of a block of the head, which is also the end of a block of the other segments or inside one */
+    m = (head->B - head->fill < L - k) ? head->B - head->fill : L - k;
+    first = head->fill;
+    for (s = 0; s < cn->nseg; s++)
+      conv_fft_push (cn->seg[s], buffIn + k, m);
+    conv_fft_output (head);
+
+    /* Output: head + the other segments (ring) */
+    for (i = 0; i < m; i++) {
+      j = (cn->rpos + i) & mask;
+      tmpRvb = (float) (alignFact * (head->y[head->B + first + i] + cn->ring[j]) + 0.5);        /* +0.5 : rounding for the 'short' truncation */
+      cn->ring[j] = 0;
+
+      /* perform 16 bit saturation */
+      if (tmpRvb < -32768.0) {
+        buffRvb[k + i] = -32768;
+        sat_warning = k + i;
+      } else {
+        if (tmpRvb > 32767.0) {
+          buffRvb[k + i] = 32767;
+          sat_warning = k + i;
+        } else {
+          buffRvb[k + i] = (short) tmpRvb;
+        }
+      }
+    }
+    cn->rpos = (cn->rpos + m) & mask;
+    if (head->fill == head->B)
+      conv_fft_next (head);
+
+    /* Complete blocks of the other segments: output samples n-B+off ... n+off-1 (n: next input sample) */
+    for (s = 1; s < cn->nseg; s++) {
+      cf = cn->seg[s];
+      if (cf->fill == cf->B) {
+        conv_fft_output (cf);
+        for (i = 0, j = cn->rpos + cn->off[s] - cf->B; i < cf->B; i++, j++)
+          cn->ring[j & mask] += cf->y[cf->B + i];
+        conv_fft_next (cf);
+      }
+    }
+  }
+  return sat_warning;
+}
+
+
+/* this routine releases the state of conv_mc() */
+void conv_mc_free (CONV_MC * cm) {
+  if (cm == NULL)
+    return;
+  free (cm->H);
+  free (cm->X);
+  free (cm->xb);
+  free (cm->Xc);
+  free (cm->Yt);
+  free (cm->y);
+  free (cm);
+}
+
+
+/* this routine allocates the state of conv_mc(), and computes the spectra of the partitions of the */
+/* nin x nout impulse responses, IR[m*nin+n] of N[m*nin+n] taps from the input n to the output m */
+/* (NULL or 0 taps if not connected); all are cut in partitions of the same length B (as conv_fft_init(), */
+/* for the longest one) so that the spectrum of each input block is shared by all the outputs */
+CONV_MC *conv_mc_init (float **IR, long *N, int nin, int nout, long B) {
+  CONV_MC *cm;
+  long n2, p, k, i;
+  int c;
+
+  if (nin < 1 || nout < 1)
+    return NULL;
+  if ((cm = (CONV_MC *) calloc (1, sizeof (CONV_MC))) == NULL)
+    return NULL;
+  cm->nin = nin;
+  cm->nout = nout;
+  for (c = 0; c < nin * nout; c++)
+    if (IR[c] != NULL && N[c] > cm->N)
+      cm->N = N[c];
+
+  /* Partition length and number of partitions */
+  cm->B = conv_fft_blklen (cm->N, B);
+  n2 = 2 * cm->B;
+  cm->P = (cm->N > cm->B) ? (cm->N + cm->B - 1) / cm->B : 1;
+  cm->plan = fft_plan_get ((int) n2);
+  cm->H = (float *) calloc (nout * nin * cm->P * n2, sizeof (float));
+  cm->X = (float *) calloc (nin * cm->P * n2, sizeof (float));
+  cm->xb = (float *) calloc (nin * n2, sizeof (float));
+  cm->Xc = (float *) malloc (nin * n2 * sizeof (float));
+  cm->Yt = (float *) malloc (nout * n2 * sizeof (float));
+  cm->y = (float *) malloc (n2 * sizeof (float));
+  if (cm->plan == NULL || cm->H == NULL || cm->X == NULL || cm->xb == NULL || cm->Xc == NULL || cm->Yt == NULL || cm->y == NULL) {
+    conv_mc_free (cm);
+    return NULL;
+  }
+
+  /* Spectra of the partitions of each impulse response: B taps followed by B zeros */
+  for (c = 0; c < nin * nout; c++)
+    for (p = 0; p < cm->P; p++) {
+      i = (c * cm->P + p) * n2;
+      for (k = 0; IR[c] != NULL && k < cm->B && p * cm->B + k < N[c]; k++)
+        cm->H[i + k] = IR[c][p * cm->B + k];
+      fft_plan_exec_real (cm->plan, cm->H + i);
+    }
+
+  cm->nblk = 0;
+  cm->fill = 0;
+  cm->ytblk = -1;
+  return cm;
+}
+
+
+/* this routine convolves the next L input frames (nin interleaved samples) with the impulse responses, */
+/* and stores L output frames (nout interleaved samples) in buffRvb; the output m is the sum over the */
+/* inputs n of conv() with IR[m*nin+n]; as conv_fft(), without latency, but each input block is */
+/* transformed once for all the outputs, and each output costs 1 inverse FFT per block */
+/* the ouput sat_warning is used to provide a warning of there is 16 bit saturation, 
+  a positive value indicates the frame of overflow */
+long conv_mc (CONV_MC * cm, short *buffIn, short *buffRvb, float alignFact, long L) {
+  int nin = cm->nin, nout = cm->nout;
+  long B = cm->B, n2 = 2 * cm->B, P = cm->P;
+  long k, m, i, p, first;
+  int c, o;
+  float tmpRvb;
+  long sat_warning;
+
+  sat_warning = -1;
+  for (k = 0; k < L; k += m) {
+    /* New samples of the current block of each input */
+    m = (B - cm->fill < L - k) ? B - cm->fill : L - k;
+    first = cm->fill;
+    for (c = 0; c < nin; c++)
+      for (i = 0; i < m; i++)
+        cm->xb[c * n2 + B + first + i] = buffIn[(k + i) * nin + c];
+    cm->fill += m;
+
+    /* Once per block: output spectra of the partitions 1..P-1 with the previous blocks */
+    if (cm->ytblk != cm->nblk) {
+      memset (cm->Yt, 0, nout * n2 * sizeof (float));
+      for (o = 0; o < nout; o++)
+        for (c = 0; c < nin; c++)
+          for (p = 1; p < P && p <= cm->nblk; p++)
+            spec_mac (cm->Yt + o * n2, cm->X + (c * P + (cm->nblk - p) % P) * n2, cm->H + ((o * nin + c) * P + p) * n2, n2);
+      cm->ytblk = cm->nblk;
+    }
+
+    /* Spectrum of the current block of each input, shared by all the outputs */
+    for (c = 0; c < nin; c++) {
+      memcpy (cm->Xc + c * n2, cm->xb + c * n2, n2 * sizeof (float));
+      fft_plan_exec_real (cm->plan, cm->Xc + c * n2);
+    }
+
+    /* Each output: partitions 0 of its impulse responses, and 1 inverse FFT */
+    for (o = 0; o < nout; o++) {
+      memcpy (cm->y, cm->Yt + o * n2, n2 * sizeof (float));
+      for (c = 0; c < nin; c++)
+        spec_mac (cm->y, cm->Xc + c * n2, cm->H + (o * nin + c) * P * n2, n2);
+      fft_plan_exec_inverse (cm->plan, cm->y);
+
+      for (i = 0; i < m; i++) {
+        tmpRvb = (float) (alignFact * cm->y[B + first + i] + 0.5);      /* +0.5 : rounding for the 'short' truncation */
+
+        /* perform 16 bit saturation */
+        if (tmpRvb < -32768.0) {
+          buffRvb[(k + i) * nout + o] = -32768;
+          sat_warning = k + i;
+        } else {
+          if (tmpRvb > 32767.0) {
+            buffRvb[(k + i) * nout + o] = 32767;
+            sat_warning = k + i;
+          } else {
+            buffRvb[(k + i) * nout + o] = (short) tmpRvb;
+          }
+        }
+      }
+    }
+
+    /* Complete block: spectra to the delay lines, and the blocks become the previous ones */
+    if (cm->fill == B) {
+      for (c = 0; c < nin; c++) {
+        memcpy (cm->X + (c * P + cm->nblk % P) * n2, cm->Xc + c * n2, n2 * sizeof (float));
+        memcpy (cm->xb + c * n2, cm->xb + c * n2 + B, B * sizeof (float));
+        memset (cm->xb + c * n2 + B, 0, B * sizeof (float));
+      }
+      cm->nblk++;
+      cm->fill = 0;
+    }
+  }
+  return sat_warning;
+}
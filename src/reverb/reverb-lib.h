@@ -27,11 +27,28 @@
   FUNCTIONS :
 	Global (have prototype in reverb-lib.h)
 		shift(...)		:		Shift coefficients of the input buffer for next block filtering
+		ring_init(...)	:		Mirrored ring buffer of the input history of conv()
+		ring_push(...)	:		Append a block to the ring, window of conv() without copy
+		ring_free(...)	:		Release the ring buffer
 		conv(...)		:		Convolves the impulse response of a room with the input file
+		conv_fft_init(...)	:		Spectra of the partitions of the impulse response
+		conv_fft(...)	:		Same as conv(), by uniformly partitioned FFT convolution
+		conv_fft_free(...)	:		Release the state of conv_fft()
+		conv_nu_init(...)	:		Non-uniform partitions of the impulse response
+		conv_nu(...)	:		Same as conv(), low-latency non-uniform partitioned convolution
+		conv_nu_free(...)	:		Release the state of conv_nu()
+		conv_mc_init(...)	:		Partition spectra of a matrix of impulse responses
+		conv_mc(...)	:		Multichannel convolution, nin inputs to nout outputs
+		conv_mc_free(...)	:		Release the state of conv_mc()
 
   HISTORY :
 	02.Feb.05	v1.0	First Beta version
 	10.jul.08   v1.01   Added 16 bit saturation and saturation warning
+	16.Oct.26   v1.02   Added uniformly partitioned FFT convolution (conv_fft)
+	                    and non-uniform partitioned convolution (conv_nu)
+	                    Added the mirrored input ring buffer (ring_*), instead
+	                    of shift()
+	                    Added multichannel convolution (conv_mc)
 
 
   AUTHORS :
@@ -41,9 +58,39 @@
 
 
 /* this routine replaces the first N-1 samples of a buffer by the last N-1 samples */
+/* (buffer of 2N-1 samples, blocks of N samples; see ring_push() for other block lengths) */
 void shift (short *buff, long N);
 
 
+/* Mirrored ring buffer of the input of conv(): each sample is written at i and i+R, so that
+   the N-1 past samples and the new block are always contiguous, without shift() */
+typedef struct {
+  short *buf;                   /* 2R samples, buf[i] == buf[i+R] */
+  long R;                       /* length of the ring, N-1 + max. block length */
+  long N;                       /* length of the impulse response */
+  long pos;                     /* position of the oldest of the N-1 past samples */
+} IN_RING;
+
+
+/* this routine allocates a ring for an impulse response of N taps and blocks of at most L samples */
+/* the past samples are initialized to 0; NULL if out of memory */
+IN_RING *ring_init (long N,     /* length of the impulse response */
+                    long L      /* max. length of a block */
+  );
+
+
+/* this routine appends a block of L samples to the ring, and returns the window of N-1+L samples */
+/* (the N-1 past samples followed by the block), to be given as buffIn to conv() */
+short *ring_push (IN_RING * ring,       /* ring buffer */
+                  short *block, /* new samples */
+                  long L        /* number of new samples, at most the max. of ring_init() */
+  );
+
+
+/* this routine releases the ring buffer */
+void ring_free (IN_RING * ring);
+
+
 /* this routine convolves buffIn with IR and stores the processed data into buffRvb */
 /* alignFact is used to align the energy of the input file with an other file */
 /* the ouput is an overflow  flag, if non_zero it indicates overflow with saturation at that sample position*/
@@ -54,3 +101,136 @@ long conv (float *IR,           /* impulse response buffer */
            long N,              /* length of the impulse response */
            long L               /* length of the input buffer to process */
   );
+
+
+/* State of the uniformly partitioned overlap-save convolution: the impulse
+   response is cut in P partitions of B taps, whose spectra (FFT of 2B points)
+   are computed once; the spectra of the last P input blocks are kept in a
+   frequency-domain delay line */
+typedef struct {
+  long N;                       /* length of the impulse response */
+  long B;                       /* partition and block length */
+  long P;                       /* number of partitions */
+  const struct fft_plan *plan;  /* FFT plan of 2B points (fft.h) */
+  float *H;                     /* spectra of the partitions, P x 2B */
+  float *X;                     /* spectra of the last P input blocks, P x 2B */
+  float *xb;                    /* previous and current input blocks, 2B */
+  float *Xc;                    /* spectrum of the current block, 2B */
+  float *Yt;                    /* output spectrum of the previous blocks, 2B */
+  float *y;                     /* work: output spectrum and samples, 2B */
+  long nblk;                    /* index of the current block */
+  long fill;                    /* samples of the current block received */
+  long ytblk;                   /* block for which Yt[] was computed */
+} CONV_FFT;
+
+
+/* this routine allocates the state of conv_fft() for the impulse response IR of N taps */
+/* B is the partition length (rounded up to a power of 2; 0: default); NULL if out of memory */
+CONV_FFT *conv_fft_init (float *IR,     /* impulse response buffer */
+                         long N,        /* length of the impulse response */
+                         long B         /* partition length, 0 for the default */
+  );
+
+
+/* this routine convolves the next L input samples with the impulse response, as conv() */
+/* the N-1 past samples are kept in the state, buffIn holds the L new samples only */
+/* the ouput is the saturation flag of conv() */
+long conv_fft (CONV_FFT * cf,   /* state of the convolution */
+               short *buffIn,   /* input buffer, L new samples */
+               short *buffRvb,  /* reverberated data */
+               float alignFact, /* energy alignment factor */
+               long L           /* length of the input buffer to process */
+  );
+
+
+/* this routine releases the state of conv_fft() */
+void conv_fft_free (CONV_FFT * cf);
+
+
+/* State of the non-uniform partitioned convolution: the impulse response is
+   cut in segments of uniform partitions, short at the head and longer in the
+   tail; the head gives the output without latency, the segments after it
+   (whose offset is at least their partition length) add the output of their
+   complete blocks in a ring buffer of the future output samples */
+#define CONV_NU_MAXSEG 32       /* max. number of segments */
+typedef struct {
+  long N;                       /* length of the impulse response */
+  long B0;                      /* partition length of the head */
+  int nseg;                     /* number of segments */
+  long off[CONV_NU_MAXSEG];     /* offset of each segment in the impulse response */
+  CONV_FFT *seg[CONV_NU_MAXSEG];        /* uniform partitioned convolution of each segment */
+  float *ring;                  /* ring buffer of the future output of the segments 1..nseg-1 */
+  long R;                       /* length of the ring buffer (power of 2) */
+  long rpos;                    /* position of the next output sample in the ring buffer */
+} CONV_NU;
+
+
+/* this routine allocates the state of conv_nu() for the impulse response IR of N taps, */
+/* for calls of about L samples (codec frames); NULL if out of memory */
+CONV_NU *conv_nu_init (float *IR,       /* impulse response buffer */
+                       long N,  /* length of the impulse response */
+                       long L   /* number of samples of a call */
+  );
+
+
+/* this routine convolves the next L input samples with the impulse response, as conv(), */
+/* L reverberated samples out for L samples in; the past samples are kept in the state */
+/* the ouput is the saturation flag of conv() */
+long conv_nu (CONV_NU * cn,     /* state of the convolution */
+              short *buffIn,    /* input buffer, L new samples */
+              short *buffRvb,   /* reverberated data */
+              float alignFact,  /* energy alignment factor */
+              long L            /* length of the input buffer to process */
+  );
+
+
+/* this routine releases the state of conv_nu() */
+void conv_nu_free (CONV_NU * cn);
+
+
+/* State of the multichannel convolution: nin inputs, nout outputs, and an
+   impulse response from each input to each output, all cut in P partitions
+   of B taps as in CONV_FFT; the spectrum of each input block is computed
+   once, and each output is the sum of its products with the partitions */
+typedef struct {
+  int nin;                      /* number of input channels */
+  int nout;                     /* number of output channels */
+  long N;                       /* length of the longest impulse response */
+  long B;                       /* partition and block length */
+  long P;                       /* number of partitions */
+  const struct fft_plan *plan;  /* FFT plan of 2B points (fft.h) */
+  float *H;                     /* spectra of the partitions, nout x nin x P x 2B */
+  float *X;                     /* spectra of the last P blocks of each input, nin x P x 2B */
+  float *xb;                    /* previous and current blocks of each input, nin x 2B */
+  float *Xc;                    /* spectra of the current blocks, nin x 2B */
+  float *Yt;                    /* output spectra of the previous blocks, nout x 2B */
+  float *y;                     /* work: output spectrum and samples, 2B */
+  long nblk;                    /* index of the current block */
+  long fill;                    /* samples of the current block received */
+  long ytblk;                   /* block for which Yt[] was computed */
+} CONV_MC;
+
+
+/* this routine allocates the state of conv_mc() for the impulse responses IR[m*nin+n] of N[m*nin+n] taps */
+/* from the input n to the output m (NULL if not connected); B as conv_fft_init(); NULL if out of memory */
+CONV_MC *conv_mc_init (float **IR,      /* impulse response buffers, nout x nin */
+                       long *N, /* lengths of the impulse responses */
+                       int nin, /* number of input channels */
+                       int nout,        /* number of output channels */
+                       long B   /* partition length, 0 for the default */
+  );
+
+
+/* this routine convolves the next L input frames with the impulse responses: buffIn holds L frames of */
+/* nin interleaved samples, buffRvb receives L frames of nout samples, the output m being the sum of */
+/* conv() of each input n with IR[m*nin+n]; the ouput is the saturation flag of conv() (frame index) */
+long conv_mc (CONV_MC * cm,     /* state of the convolution */
+              short *buffIn,    /* input buffer, L new frames */
+              short *buffRvb,   /* reverberated data, L frames */
+              float alignFact,  /* energy alignment factor */
+              long L            /* number of frames to process */
+  );
+
+
+/* this routine releases the state of conv_mc() */
+void conv_mc_free (CONV_MC * cm);
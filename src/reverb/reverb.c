@@ -1,4 +1,4 @@
-/*                                                         02/Feb/2010 v1.02 */
+/*                                                         16/Oct/2026 v1.03 */
 /*=============================================================================
 
                           U    U   GGG    SSSS  TTTTT
@@ -26,6 +26,16 @@
 	02.Feb.05	v1.0	First Beta version
 	10.Jul.08 v1.01 Added 16 bit saturation and saturation warning
 	02.Feb.10 v1.02 Modified maximum string length to avoid buffer overrun
+	16.Oct.26 v1.03 New options -fft and -part: uniformly partitioned FFT
+	                convolution (conv_fft), for long impulse responses
+	                New option -frame: frame-based streaming by blocks of
+	                L samples, non-uniform partitioned convolution (conv_nu)
+	                New option -blk: block length of the direct and FFT
+	                convolutions (default: length of the impulse response);
+	                the input history of conv() is a mirrored ring buffer
+	                (ring_push) instead of shift()
+	                New option -ch: multichannel files, matrix of impulse
+	                responses (conv_mc)
 
   AUTHORS :
 	v1.0  Cyril Guillaume & Stephane Ragot -- stephane.ragot@francetelecom.com
@@ -43,7 +53,7 @@
 #include "reverb-lib.h"
 
 static void display_usage () {
-  printf ("REVERB.C - Version 1.02 of 02.Feb.2010 \n\n");
+  printf ("REVERB.C - Version 1.03 of 16.Oct.2026 \n\n");
 
   printf (" Program to add reverberation to a signal\n");
   printf (" This program convolves a signal with the impulse response of a room\n");
@@ -53,39 +63,94 @@ static void display_usage () {
   printf ("\n");
   printf (" Usage:\n");
   printf (" $ reverb   [-options] FileIn FileIR FileOut\n");
+  printf (" $ reverb   -ch nin nout [-options] FileIn FileIR_1 ... FileIR_nin*nout FileOut\n");
   printf (" where:\n");
   printf ("  FileIn       is the file to be processed;\n");
   printf ("  FileIR       is the file containing the impulse response;\n");
   printf ("  FileOut      is the file with the processed data;\n");
+  printf ("  FileIR_i     are the impulse responses from each input channel to\n");
+  printf ("               the 1st output channel, then to the 2nd one, etc.\n");
   printf ("\n");
   printf (" Options:\n");
   printf ("  -align A...... multiplicative factor to apply to the reverberated sound\n");
   printf ("				   in order to align its energy level with a second file\n");
+  printf ("  -fft ......... partitioned FFT convolution instead of the direct\n");
+  printf ("				   convolution (same output up to rounding, much faster\n");
+  printf ("				   for long impulse responses)\n");
+  printf ("  -part B ...... partition length of -fft, power of 2 (default about 1/4\n");
+  printf ("				   of the impulse response, at most 4096)\n");
+  printf ("  -blk L ....... process the input by blocks of L samples (default: length\n");
+  printf ("				   of the impulse response)\n");
+  printf ("  -frame L ..... process the input by frames of L samples (e.g. 10-20 ms\n");
+  printf ("				   codec frames), with short FFT partitions at the head of\n");
+  printf ("				   the impulse response and longer ones in its tail\n");
+  printf ("  -ch nin nout . FileIn has nin interleaved channels, FileOut has nout\n");
+  printf ("				   channels (e.g. 1 2: mono to stereo, 2 2: stereo to\n");
+  printf ("				   stereo); each output channel is the sum of the inputs\n");
+  printf ("				   convolved with their impulse responses, by partitioned\n");
+  printf ("				   FFT convolution (-part and -blk apply, in frames)\n");
   printf ("\n");
 }
 
 #define tmpIRlength	512
+#define MAXCH	8               /* max. number of channels of -ch */
+
+/* this routine loads the impulse response of FileIR, and returns its length in N */
+static float *read_IR (char *FileIR, long *N) {
+  FILE *ptr_fileIR;
+  float tmpIR[tmpIRlength];     /* temporary buffer for the impulse response reading */
+  float *IR;
+
+  ptr_fileIR = fopen (FileIR, "rb");
+  if (ptr_fileIR == NULL) {
+    fprintf (stderr, "\nUnable to open Input file\n");
+    exit (-1);
+  }
+  /* determine the length of the impulse response */
+  *N = 0;
+  while (!feof (ptr_fileIR)) {
+    *N += fread (tmpIR, sizeof (float), tmpIRlength, ptr_fileIR);
+  }
+  /* allocate memory for the impulse response buffer */
+  IR = (float *) calloc (*N, sizeof (float));
+  rewind (ptr_fileIR);
+  /* read the impulse response */
+  fread (IR, sizeof (float), *N, ptr_fileIR);
+  /* close file */
+  fclose (ptr_fileIR);
+  return IR;
+}
 
 int main (int argc, char *argv[]) {
   /* File variables */
   FILE *ptr_fileIn;
   FILE *ptr_fileOut;
-  FILE *ptr_fileIR;
   char FileIn[MAX_STRLEN];
-  char FileIR[MAX_STRLEN];
+  char FileIR[MAXCH * MAXCH][MAX_STRLEN];
   char FileOut[MAX_STRLEN];
 
   /* buffers */
   float *IR;                    /* buffer for the impulse response */
   short *buffRvb;               /* buffer for the reverberated Sound */
-  short *buffIn;                /* buffer for the input sound file */
-  float tmpIR[tmpIRlength];     /* temporary buffer for the impulse response reading */
+  short *buffIn;                /* buffer for a block of the input sound file */
+  IN_RING *ring = NULL;         /* past and new input samples of conv() */
 
   /* Algorithm variables */
   float alignFact = 1.0;        /* multiplicative factor for the reverberated sound (energy alignment with another file to compare) */
   long N;                       /* length of the impulse response */
   long count, global_count;
   long local_sat_pos;
+  int use_fft = 0;              /* partitioned FFT convolution */
+  long part = 0;                /* partition length of the FFT convolution, 0 for the default */
+  CONV_FFT *cf = NULL;
+  long frame = 0;               /* frame length of the streaming mode, 0 if not used */
+  long blk = 0;                 /* number of samples read at a time, 0 for N */
+  CONV_NU *cn = NULL;
+  int nin = 0, nout = 0;        /* number of channels of -ch, 0 if not used */
+  float *IRmc[MAXCH * MAXCH];   /* impulse responses of -ch */
+  long Nmc[MAXCH * MAXCH];
+  CONV_MC *cm = NULL;
+  int c;
 
   global_count = 0;
   local_sat_pos = -1;           /* local position of last saturation */
@@ -105,6 +170,55 @@ int main (int argc, char *argv[]) {
         /* Move arg{c,v} over the option to the next argument */
         argc -= 2;
         argv += 2;
+      } else if (strcmp (argv[1], "-fft") == 0) {
+        /* Partitioned FFT convolution */
+        use_fft = 1;
+
+        /* Move arg{c,v} over the option to the next argument */
+        argc--;
+        argv++;
+      } else if (strcmp (argv[1], "-part") == 0) {
+        /* Partition length of the FFT convolution */
+        use_fft = 1;
+        part = atol (argv[2]);
+
+        /* Move arg{c,v} over the option to the next argument */
+        argc -= 2;
+        argv += 2;
+      } else if (strcmp (argv[1], "-blk") == 0) {
+        /* Block length */
+        blk = atol (argv[2]);
+        if (blk < 1) {
+          fprintf (stderr, "ERROR! Invalid block length\n\n");
+          exit (-1);
+        }
+
+        /* Move arg{c,v} over the option to the next argument */
+        argc -= 2;
+        argv += 2;
+      } else if (strcmp (argv[1], "-frame") == 0) {
+        /* Frame-based streaming, non-uniform partitions */
+        frame = atol (argv[2]);
+        if (frame < 1) {
+          fprintf (stderr, "ERROR! Invalid frame length\n\n");
+          exit (-1);
+        }
+
+        /* Move arg{c,v} over the option to the next argument */
+        argc -= 2;
+        argv += 2;
+      } else if (strcmp (argv[1], "-ch") == 0) {
+        /* Multichannel files */
+        nin = atoi (argv[2]);
+        nout = atoi (argv[3]);
+        if (nin < 1 || nin > MAXCH || nout < 1 || nout > MAXCH) {
+          fprintf (stderr, "ERROR! Invalid number of channels (1 to %d)\n\n", MAXCH);
+          exit (-1);
+        }
+
+        /* Move arg{c,v} over the option to the next argument */
+        argc -= 3;
+        argv += 3;
       } else if (strcmp (argv[1], "-h") == 0 || strcmp (argv[1], "-?") == 0) {
         /* Display help message */
         display_usage ();
@@ -118,8 +232,14 @@ int main (int argc, char *argv[]) {
 
   /* Read parameters for processing */
   GET_PAR_S (1, "_Input File: .................. ", FileIn);
-  GET_PAR_S (2, "_Impulse Response File: ....... ", FileIR);
-  GET_PAR_S (3, "_Output File: ................. ", FileOut);
+  if (nin > 0) {
+    for (c = 0; c < nin * nout; c++)
+      GET_PAR_S (2 + c, "_Impulse Response File: ....... ", FileIR[c]);
+    GET_PAR_S (2 + nin * nout, "_Output File: ................. ", FileOut);
+  } else {
+    GET_PAR_S (2, "_Impulse Response File: ....... ", FileIR[0]);
+    GET_PAR_S (3, "_Output File: ................. ", FileOut);
+  }
 
 
 
@@ -129,24 +249,18 @@ int main (int argc, char *argv[]) {
 
   /* ......... PREPARING FILES ......... */
 
-  /* Load the Impulse Response */
-  ptr_fileIR = fopen (FileIR, "rb");
-  if (ptr_fileIR == NULL) {
-    fprintf (stderr, "\nUnable to open Input file\n");
-    exit (-1);
-  }
-  /* determine the length of the impulse response */
-  N = 0;
-  while (!feof (ptr_fileIR)) {
-    N += fread (tmpIR, sizeof (float), tmpIRlength, ptr_fileIR);
+  /* Load the Impulse Response(s); N is the longest one */
+  if (nin > 0) {
+    for (c = 0, N = 0; c < nin * nout; c++) {
+      IRmc[c] = read_IR (FileIR[c], &Nmc[c]);
+      if (Nmc[c] > N)
+        N = Nmc[c];
+    }
+    IR = NULL;
+  } else {
+    nin = nout = 1;
+    IR = read_IR (FileIR[0], &N);
   }
-  /* allocate memory for the impulse response buffer */
-  IR = (float *) calloc (N, sizeof (float));
-  rewind (ptr_fileIR);
-  /* read the impulse response */
-  fread (IR, sizeof (float), N, ptr_fileIR);
-  /* close file */
-  fclose (ptr_fileIR);
 
   /* open the input file */
   ptr_fileIn = fopen (FileIn, "rb");
@@ -162,11 +276,25 @@ int main (int argc, char *argv[]) {
     exit (-1);
   }
   /* allocate memory for the buffers */
-  buffIn = (short *) calloc (2 * N - 1, sizeof (short));        /* allocate memory for a block of the input file */
-  buffRvb = (short *) malloc (N * sizeof (short));      /* allocate memory for the processed block */
+  if (frame > 0)
+    blk = frame;
+  else if (blk == 0)
+    blk = (N > 0) ? N : 1;
+  buffIn = (short *) malloc (blk * nin * sizeof (short));       /* allocate memory for a block of the input file */
+  buffRvb = (short *) malloc (blk * nout * sizeof (short));     /* allocate memory for the processed block */
+
+  /* partition spectra of the impulse response(s), or input history of the direct convolution */
+  if (IR == NULL)
+    cm = conv_mc_init (IRmc, Nmc, nin, nout, part);
+  else if (frame > 0)
+    cn = conv_nu_init (IR, N, frame);
+  else if (use_fft)
+    cf = conv_fft_init (IR, N, part);
+  else
+    ring = ring_init (N, blk);
 
   /* check consistency */
-  if ((buffIn == NULL) || (buffRvb == NULL)) {
+  if ((buffIn == NULL) || (buffRvb == NULL) || (cn == NULL && cf == NULL && ring == NULL && cm == NULL)) {
     fprintf (stderr, "\nUnable to allocate enough memory\n");
     exit (-1);
   }
@@ -179,15 +307,21 @@ int main (int argc, char *argv[]) {
 
   /* Filter the sound File */
   while (!feof (ptr_fileIn)) {
-    count = (long) fread (buffIn + N - 1, sizeof (short), N, ptr_fileIn);       /* read a block of the input file */
-
-    local_sat_pos = conv (IR, buffIn, buffRvb, alignFact, N, count);    /* convolves a block of the input file with the impulse response */
+    count = (long) fread (buffIn, sizeof (short) * nin, blk, ptr_fileIn);       /* read a block of the input file (frames of nin samples) */
+
+    if (cm != NULL)
+      local_sat_pos = conv_mc (cm, buffIn, buffRvb, alignFact, count);  /* convolves each input with the impulse responses to each output */
+    else if (frame > 0)
+      local_sat_pos = conv_nu (cn, buffIn, buffRvb, alignFact, count);  /* same, by frames, the past samples are kept in cn */
+    else if (use_fft)
+      local_sat_pos = conv_fft (cf, buffIn, buffRvb, alignFact, count); /* same, the past samples are kept in cf */
+    else                        /* convolves a block of the input file, after the N-1 last samples, with the impulse response */
+      local_sat_pos = conv (IR, ring_push (ring, buffIn, count), buffRvb, alignFact, N, count);
     if (local_sat_pos >= 0) {
       fprintf (stderr, "\nWarning warning!! Saturation(s) in output file.  In  sample %ld\n", local_sat_pos + global_count);
     }
     global_count += count;
-    fwrite (buffRvb, sizeof (short), count, ptr_fileOut);       /* output the processed block */
-    shift (buffIn, N);          /* shift a part of the input buffer (to keep the N-1 last samples of the input file for the next processing) */
+    fwrite (buffRvb, sizeof (short) * nout, count, ptr_fileOut);        /* output the processed block */
   }
 
 
@@ -200,6 +334,13 @@ int main (int argc, char *argv[]) {
   free (buffIn);
   free (buffRvb);
   free (IR);
+  if (cm != NULL)
+    for (c = 0; c < nin * nout; c++)
+      free (IRmc[c]);
+  conv_mc_free (cm);
+  conv_fft_free (cf);
+  conv_nu_free (cn);
+  ring_free (ring);
   /* close the opened files */
   fclose (ptr_fileIn);
   fclose (ptr_fileOut);
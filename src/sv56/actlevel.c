@@ -61,6 +61,12 @@
                applied to the input file(s) to normalizes to the long
                term level, instead of the active speech level.
   -log file .. print the statistics log into file rather than stdout
+  -threads n . measure groups of blocks with speech_voltmeter_parallel(),
+               by up to n threads, 0 for the number of CPUs [default: 1,
+               serial measurement]. The levels may differ from the
+               serial measurement by rounding, the activity only in
+               rare cases, when an envelope value is within a few units
+               of the last place of a threshold
   -q ......... quiet operation; don't print progress flag, results are
                printed all in one line.
 
@@ -69,8 +75,9 @@
   ~~~~~~~~~~~~~
   > sv-P56.c:   contains the functions related to active speech
 	        level measurement according to P.56,
-	        init_speech_voltmeter(), speech_voltmeter() and
-	        bin_interp(). Their prototypesare in `sv-p56.h'.
+	        init_speech_voltmeter(), speech_voltmeter_update(),
+	        speech_voltmeter_parallel(), speech_voltmeter_result()
+	        and bin_interp(). Their prototypes are in `sv-p56.h'.
   > ugst-utl.c: utility functions; here are used the gain/loss
 	        (scaling) algorithm of scale() and the data type
 		conversion functions sh2fl() and fl2sh(). Prototypes
@@ -85,6 +92,7 @@
   4      error moving pointer to desired start of conversion;
   5      error reading input file;
   6      error writing to file;
+  7      error allocating memory (-threads);
 
   Compilation:
   ~~~~~~~~~~~~
@@ -125,6 +133,13 @@
                            characters and changing strcpy() to
                            strncpy() in the filename copy process.
                            <simao>
+  16.Oct.26     2.4        The blocks only accumulate the statistics
+                           (speech_voltmeter_update()); the levels are
+                           computed once per file, after the last block
+                           (speech_voltmeter_result()).
+  16.Oct.26     2.5        Option -threads: groups of blocks (about 1M
+                           samples) are measured by parallel threads
+                           with speech_voltmeter_parallel().
   ============================================================================
 */
 
@@ -159,6 +174,7 @@
 /* ... Local definitions ... */
 #define DEF_BLK_LEN 256         /* samples per block */
 #define MIN_LOG_OFFSET 1.0e-20  /* To avoid sigularity with log(0.0) */
+#define GRP_LEN 1048576         /* samples per group of blocks, -threads */
 
 
 /*
@@ -189,7 +205,7 @@
   ============================================================================
 */
 void display_usage () {
-  printf ("ACTLEVEL.C - Version 2.0 of 01/Feb/1995 \n");
+  printf ("ACTLEVEL.C - Version 2.5 of 16/Oct/2026 \n");
   printf (" Calculate the active speech level of a file, relative to the\n");
   printf (" system overload point [dBov], using the P.56 algorithm.\n");
   printf (" Reports positive and negative peaks, RMS and active level, \n");
@@ -219,6 +235,12 @@ void display_usage () {
   printf ("               to normalizes to the long term level, instead of the\n");
   printf ("               active speech level. Does NOT change the file(s).\n");
   printf ("  -log file ... log statistics into file rather than stdout\n");
+  printf ("  -threads n . measure groups of blocks by up to n parallel threads,\n");
+  printf ("               0 for the number of CPUs [default: 1, serial]. The\n");
+  printf ("               levels may differ from the serial measurement by\n");
+  printf ("               rounding, the activity only in rare cases, when an\n");
+  printf ("               envelope value is within a few units of the last\n");
+  printf ("               place of a threshold.\n");
   printf ("  -q ......... quiet operation; don't print progress flag, results\n");
   printf ("               are printed all in one line.\n");
 
@@ -432,6 +454,10 @@ int main (int argc, char *argv[]) {
   /* Other variables */
   short buffer[4096];
   float Buf[4096];
+  short *grp_sh = NULL;         /* group of blocks, -threads */
+  float *grp = NULL;
+  long grp_blk = 1, k;
+  int nthreads = 1;
   long start_byte, bitno = 16;
   double sf = 16000;            /* Hz */
   double ActiveLeveldB, level = 0, gain = 0;
@@ -511,6 +537,17 @@ int main (int argc, char *argv[]) {
         else
           fprintf (stderr, "Statistics will be logged in %s\n", argv[2]);
 
+        /* Update argc/argv to next valid option/argument */
+        argv += 2;
+        argc -= 2;
+      } else if (strcmp (argv[1], "-threads") == 0) {
+        /* Measure groups of blocks in parallel threads */
+        nthreads = atoi (argv[2]);
+        if (nthreads < 0) {
+          fprintf (stderr, "ERROR! Bad number of threads.\n\n");
+          exit (-1);
+        }
+
         /* Update argc/argv to next valid option/argument */
         argv += 2;
         argc -= 2;
@@ -546,6 +583,17 @@ int main (int argc, char *argv[]) {
   /* Overflow (saturation) point */
   Overflow = pow ((double) 2.0, (double) (bitno - 1));
 
+  /* Buffers for groups of blocks */
+  if (nthreads != 1) {
+    grp_blk = (GRP_LEN > N) ? GRP_LEN / N : 1;
+    grp_sh = (short *) malloc (grp_blk * N * sizeof (short));
+    grp = (float *) malloc (grp_blk * N * sizeof (float));
+    if (grp_sh == NULL || grp == NULL) {
+      fprintf (stderr, "Can't allocate memory for the groups of blocks\n");
+      exit (7);
+    }
+  }
+
 
   /* REPEAT FOR ALL FILES IN THE COMMAND LINE */
   while (argc > 1) {
@@ -586,13 +634,30 @@ int main (int argc, char *argv[]) {
     /* Read samples ... */
     if (!quiet)
       fprintf (stderr, "  Processing \r");
-    for (i = 0; i < N2; i++) {
+    for (i = 0; nthreads != 1 && i < N2; i += k) {
+      /* Read up to grp_blk blocks; abort, as below, at the 1st empty block */
+      k = (grp_blk < N2 - i) ? grp_blk : N2 - i;
+      if ((l = fread (grp_sh, sizeof (short), k * N, Fi)) > 0) {
+        /* ... Convert samples to float */
+        sh2fl ((long) l, grp_sh, grp, bitno, 1);
+
+        /* ... Accumulate the statistics of the active level */
+        speech_voltmeter_parallel (grp, (long) l, &state, nthreads);
+
+        /* Print progress flag */
+        if (!quiet)
+          fprintf (stderr, "%c\r", funny[(i / grp_blk) % funny_size]);
+      }
+      if (l <= (k - 1) * N)
+        KILL (FileIn, 5);
+    }
+    for (i = 0; nthreads == 1 && i < N2; i++) {
       if ((l = fread (buffer, sizeof (short), N, Fi)) > 0) {
         /* ... Convert samples to float */
         sh2fl ((long) l, buffer, Buf, bitno, 1);
 
-        /* ... Get the active level */
-        ActiveLeveldB = speech_voltmeter (Buf, (long) l, &state);
+        /* ... Accumulate the statistics of the active level */
+        speech_voltmeter_update (Buf, (long) l, &state);
 
         /* Print progress flag */
         if (!quiet)
@@ -604,6 +669,9 @@ int main (int argc, char *argv[]) {
     if (!quiet)
       fprintf (stderr, "\n");
 
+    /* ... Get the active level of all the blocks */
+    ActiveLeveldB = speech_voltmeter_result (&state);
+
 #ifdef LOCAL_PRINT
     /* Convert absolute maximum sample to dB */
     abs_max_dB = 20 * log10 (SVP56_get_abs_max (state)) - state.refdB;
@@ -688,6 +756,8 @@ int main (int argc, char *argv[]) {
   /* ... Close log file, if it is the case */
   if (out != stdout)
     fclose (out);
+  free (grp_sh);
+  free (grp);
 
   /* ... Exit cleanly */
 #if !defined(VMS)
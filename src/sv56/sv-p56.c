@@ -1,4 +1,4 @@
-/*                                                             v2.3 19.MAY.05
+/*                                                             v2.4 16.OCT.26
 =============================================================================
 
                           U    U   GGG    SSSS  TTTTT
@@ -25,9 +25,9 @@ MODULE:         SV-P56.C, FUNCTIONS RELATED TO ACTIVE LEVEL CALCULATIONS
 ORIGINAL BY:
    Simao Ferraz de Campos Neto   CPqD/Telebras Brazil
 
-DATE:           19/May/2005
+DATE:           16/Oct/2026
 
-RELEASE:        2.00
+RELEASE:        2.40
 
 PROTOTYPES:     see sv-p56.h.
 
@@ -40,6 +40,16 @@ speech_voltmeter .............. measurement of the active speech level of
                                 data in a buffer according to P.56. Other
 				relevant statistics are also available.
 
+speech_voltmeter_update ....... accumulation of the statistics of the data
+                                in a buffer, without computing the levels.
+
+speech_voltmeter_result ....... active speech level and other statistics
+                                of the data accumulated so far.
+
+speech_voltmeter_parallel ..... same as speech_voltmeter, the data of the
+                                buffer split in chunks processed by
+                                parallel threads.
+
 HISTORY:
 
    07.Oct.91 v1.0 Release of 1st version to UGST.
@@ -57,6 +67,14 @@ HISTORY:
 				  suggested by Mr Kabal.
 				  Upper and lower bounds are updated during the interpolation.
 						<Cyril Guillaume & Stephane Ragot -- stephane.ragot@francetelecom.com>
+   16.Oct.26 v2.4 Threshold tracking of speech_voltmeter() without branches,
+                  all the thresholds of a sample at once in SSE2 or AVX
+                  vectors (svp56_track()), by chunks of the envelope; same
+                  counts as before.
+                  speech_voltmeter() split into speech_voltmeter_update()
+                  and speech_voltmeter_result().
+                  Added speech_voltmeter_parallel() (POSIX threads with
+                  -DSVP56_PTHREADS).
 
 =============================================================================
 */
@@ -67,6 +85,25 @@ HISTORY:
 
 /* System includes ... */
 #include <math.h>
+#include <float.h>
+#include <stdlib.h>
+
+#ifdef SVP56_PTHREADS
+#include <pthread.h>
+#include <unistd.h>
+#endif
+
+/* SSE2 threshold tracking on x86, unless disabled by -DSVP56_NO_SIMD; with
+   gcc, also AVX (target attribute, selected at run time) */
+#if !defined(SVP56_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define SVP56_SSE2
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define SVP56_AVX
+#include <immintrin.h>
+#else
+#include <emmintrin.h>
+#endif
+#endif
 
 /* Specific includes ... */
 #ifndef SPEECH_VOLTMETER_defined
@@ -221,7 +258,6 @@ double bin_interp (double upcount, double lwcount, double upthr, double lwthr, d
 #define T        0.03           /* in [s] */
 #define H        0.20           /* in [s] */
 #define M        15.9           /* in [dB] */
-#define THRES_NO 15             /* number of thresholds in the speech voltmeter */
 
 void init_speech_voltmeter (SVP56_state * state, double sampl_freq) {
   double x;
@@ -232,12 +268,14 @@ void init_speech_voltmeter (SVP56_state * state, double sampl_freq) {
   state->f = sampl_freq;
   I = floor (H * state->f + 0.5);
 
-  /* Inicialization of threshold vector */
-  for (x = 0.5, j = 1; j <= THRES_NO; j++, x /= 2.0)
-    state->c[THRES_NO - j] = x;
+  /* Inicialization of threshold vector (unused lanes: next powers of 2) */
+  for (x = 0.5, j = 1; j <= SVP56_THRES_NO; j++, x /= 2.0)
+    state->c[SVP56_THRES_NO - j] = x;
+  for (x = 1.0, j = SVP56_THRES_NO; j < SVP56_LANES; j++, x *= 2.0)
+    state->c[j] = x;
 
   /* Inicialization of activity and hangover count vectors */
-  for (j = 0; j < THRES_NO; j++) {
+  for (j = 0; j < SVP56_LANES; j++) {
     state->a[j] = 0;
     state->hang[j] = I;
   }
@@ -255,102 +293,238 @@ void init_speech_voltmeter (SVP56_state * state, double sampl_freq) {
 
 }
 
-#undef THRES_NO
 /* .................. End of init_speech_voltmeter() ..................... */
 
 
 /*
 ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 
-        double speech_voltmeter (float *buffer,long smpno,SVP56_state *state);
-        ~~~~~~~~~~~~~~~~~~~~~~~
+        static void svp56_track (SVP56_state *state, const double *q,
+        ~~~~~~~~~~~~~~~~~~~~~~~  long n, long I);
 
         Description:
         ~~~~~~~~~~~~
 
-        Calculates the activity factor and the active speech level
-        (conforming to ITU-T P.56) as main results; side
-        results are:
-        > average level;
-        > max & min values;
-        > rms power [dB];
-        > maximum dB level to normalize without causing clipping
-        > rms and active peak factor for the file
+        Applies the thresholds c[j] to n successive values q[] of the
+        envelope, updating the activity counts a[j] and the hangover
+        counts hang[j] as in P.56: for each q and j,
 
-        Follows the ITU-T Recommendation P.56 with the
-        following notation for the variables (the ones marked
-        `DEFINITION' are not true vars, but #define's instead):
+          if q >= c[j]:                 a[j]++, hang[j] = 0;
+          if q <  c[j] and hang[j] < I: a[j]++, hang[j]++;
 
-          f:          sampling frequency;
-          T:          time constant of smoothing, in seconds (DEFINITION);
-          g:          coefficient of smoothing;
-          H:          hangover in seconds (DEFINITION);
-          I:          size of hangover normalized by the sampling
-                      frequency;
-          M:          margin in dB of the difference between threshold
-                      and active speech level (DEFINITION);
-          q:          envelope;
-          p:          intermediate quantity;
-          c:          vector with thresholds from one quantizing level
-                      up to half the maximum code, at a step of 2;
-          refdB:      reference value to which 0 dB is assigned.
-                      For the STL92, it is the peak of a digital system, which
-                      is defined as 1.0 (0dBov).
+        without branches. With SSE2, the SVP56_LANES thresholds are
+        compared at once, 2 per vector: instead of hang[j], each double
+        lane holds the time of the last sample of the hangover (the
+        time of the last q >= c[j], plus I), and a sample is active if
+        its time is not after it; the counts of this call are kept in
+        64 bit integer lanes. The comparisons are exact, so the counts
+        are the same as the ones of the scalar version. q[] must not
+        hold NaN (the scalar version does not count them, and does not
+        increment the hangover).
 
         Variables:
         ~~~~~~~~~~
         Name:         Type:   Use:
-        buffer          I        input samples vector
-        smpno           I        number of samples in vector `buffer'
-        state          I/O       state variable associated with `buffer'
-
+        state          I/O       state of the speech voltmeter
+        q               I        envelope values
+        n               I        number of values in q[]
+        I               I        hangover, in samples
 
         Value returned:
         ~~~~~~~~~~~~~~~
-        Returns the active speech level, in dBov, as a double.
+        None.
 
-        Functions used:
+        Log of changes:
         ~~~~~~~~~~~~~~~
-        > bin_interp, from this module;
-        > exp, fabs, log10, pow, from standard library <math.h>;
+        16.Oct.26     1.0   Created, from the loop of speech_voltmeter().
 
-        Prototype:   in sv-p56.h
+~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+*/
+#ifdef SVP56_SSE2
+#define SVP56_VEC (SVP56_LANES / 2)     /* number of SSE2 vectors */
+
+static void svp56_track_sse2 (SVP56_state * state, const double *q, long n, long I) {
+  __m128d c[SVP56_VEC], dl[SVP56_VEC];
+  __m128i a[SVP56_VEC];
+  __m128d one = _mm_set1_pd (1.0), t, tI, x;
+  double tmp[2];
+  unsigned int cnt[4];
+  long k;
+  int j, i;
+
+  /* Time of q[0] is I+1; hang[j] to the time of the last sample of the hangover (>= I) */
+  for (j = 0; j < SVP56_VEC; j++) {
+    c[j] = _mm_loadu_pd (state->c + 2 * j);
+    for (i = 0; i < 2; i++)
+      tmp[i] = (double) (2 * I - (long) state->hang[2 * j + i]);
+    dl[j] = _mm_loadu_pd (tmp);
+    a[j] = _mm_setzero_si128 ();
+  }
+  t = _mm_set1_pd ((double) (I + 1));
+  tI = _mm_set1_pd ((double) (2 * I + 1));
+
+  for (k = 0; k < n; k++) {
+    x = _mm_set1_pd (q[k]);
+    for (j = 0; j < SVP56_VEC; j++) {
+      /* q >= c: hangover up to t+I; active (a[j]++, as -(-1)) if t is in the hangover */
+      dl[j] = _mm_max_pd (dl[j], _mm_and_pd (_mm_cmpge_pd (x, c[j]), tI));
+      a[j] = _mm_sub_epi64 (a[j], _mm_castpd_si128 (_mm_cmple_pd (t, dl[j])));
+    }
+    t = _mm_add_pd (t, one);
+    tI = _mm_add_pd (tI, one);
+  }
+
+  /* Counts back to the state (at most n per lane: low 32 bits), hangover left after the time I+1+n */
+  for (j = 0; j < SVP56_VEC; j++) {
+    _mm_storeu_si128 ((__m128i *) cnt, a[j]);
+    _mm_storeu_pd (tmp, dl[j]);
+    for (i = 0; i < 2; i++) {
+      state->a[2 * j + i] += cnt[2 * i];
+      state->hang[2 * j + i] = (tmp[i] - I - n > 0) ? (unsigned long) (I - (tmp[i] - I - n)) : (unsigned long) I;
+    }
+  }
+}
+
+#undef SVP56_VEC
+
+#ifdef SVP56_AVX
+#define SVP56_VEC (SVP56_LANES / 4)     /* number of AVX vectors */
+
+/* Same as svp56_track_sse2(), 4 lanes per vector; the counts in double lanes (AVX has no 256 bit integer operations) */
+__attribute__ ((target ("avx")))
+static void svp56_track_avx (SVP56_state * state, const double *q, long n, long I) {
+  __m256d c[SVP56_VEC], dl[SVP56_VEC], a[SVP56_VEC];
+  __m256d one = _mm256_set1_pd (1.0), t, tI, x;
+  double tmp[4], cnt[4];
+  long k;
+  int j, i;
+
+  for (j = 0; j < SVP56_VEC; j++) {
+    c[j] = _mm256_loadu_pd (state->c + 4 * j);
+    for (i = 0; i < 4; i++)
+      tmp[i] = (double) (2 * I - (long) state->hang[4 * j + i]);
+    dl[j] = _mm256_loadu_pd (tmp);
+    a[j] = _mm256_setzero_pd ();
+  }
+  t = _mm256_set1_pd ((double) (I + 1));
+  tI = _mm256_set1_pd ((double) (2 * I + 1));
+
+  for (k = 0; k < n; k++) {
+    x = _mm256_set1_pd (q[k]);
+    for (j = 0; j < SVP56_VEC; j++) {
+      dl[j] = _mm256_max_pd (dl[j], _mm256_and_pd (_mm256_cmp_pd (x, c[j], _CMP_GE_OQ), tI));
+      a[j] = _mm256_add_pd (a[j], _mm256_and_pd (_mm256_cmp_pd (t, dl[j], _CMP_LE_OQ), one));
+    }
+    t = _mm256_add_pd (t, one);
+    tI = _mm256_add_pd (tI, one);
+  }
+
+  for (j = 0; j < SVP56_VEC; j++) {
+    _mm256_storeu_pd (cnt, a[j]);
+    _mm256_storeu_pd (tmp, dl[j]);
+    for (i = 0; i < 4; i++) {
+      state->a[4 * j + i] += (unsigned long) cnt[i];
+      state->hang[4 * j + i] = (tmp[i] - I - n > 0) ? (unsigned long) (I - (tmp[i] - I - n)) : (unsigned long) I;
+    }
+  }
+}
+
+#undef SVP56_VEC
+#endif
+
+#ifdef SVP56_AVX
+/* AVX threshold tracking: 1 if the processor has AVX, -1 until checked */
+static int svp56_avx = -1;
+
+/* Selection of the instruction set, once (before any thread is started) */
+static void svp56_select () {
+  if (svp56_avx < 0) {
+    __builtin_cpu_init ();
+    svp56_avx = __builtin_cpu_supports ("avx") ? 1 : 0;
+  }
+}
+#endif
+
+static void svp56_track (SVP56_state * state, const double *q, long n, long I) {
+#ifdef SVP56_AVX
+  svp56_select ();
+  if (svp56_avx) {
+    svp56_track_avx (state, q, n, I);
+    return;
+  }
+#endif
+  svp56_track_sse2 (state, q, n, I);
+}
+
+#else
+
+static void svp56_track (SVP56_state * state, const double *q, long n, long I) {
+  unsigned long ge, act;
+  long k;
+  int j;
+
+  for (k = 0; k < n; k++)
+    for (j = 0; j < SVP56_LANES; j++) {
+      ge = (q[k] >= state->c[j]);
+      act = (q[k] < state->c[j]) & (state->hang[j] < (unsigned long) I);
+      state->a[j] += ge | act;
+      state->hang[j] = (state->hang[j] + act) & (ge - 1);
+    }
+}
+
+#endif
+/* ....................... End of svp56_track() ....................... */
+
+
+/*
+~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+        void speech_voltmeter_update (float *buffer, long smpno,
+        ~~~~~~~~~~~~~~~~~~~~~~~~~~~~  SVP56_state *state);
+
+        Description:
+        ~~~~~~~~~~~~
+
+        Accumulates in `state' the statistics of the samples of
+        `buffer' (processes 1 and 2 of P.56: sums, extremes, envelope
+        and activity counts), without computing the levels: call
+        speech_voltmeter_result() once all the blocks of the signal
+        have been given. The variables are those of speech_voltmeter().
+
+        Variables:
         ~~~~~~~~~~
+        Name:         Type:   Use:
+        buffer          I        input samples vector, range -1.0 .. 1.0
+        smpno           I        number of samples in vector `buffer'
+        state          I/O       state variable associated with `buffer'
 
-        Author: Simao Ferraz de Campos Neto -- CPqD/Telebras
-        ~~~~~~~          <tdsimao@venus.cpqd.ansp.br>
+        Value returned:
+        ~~~~~~~~~~~~~~~
+        None.
+
+        Prototype:   in sv-p56.h
+        ~~~~~~~~~~
 
         Log of changes:
         ~~~~~~~~~~~~~~~
-        07.Mar.91     0.0       Release of first version of C speech voltmeter.
-        08.Oct.91     1.0       Release of speech_voltmeter as a module.
-        19.Feb.91     2.0       Use of one structure with all state variables,
-                                instead of passing a bunch of variables.
-        18.May.92     2.1       Does not carry out initialization (see init_
-                                speech_voltmeter above); input data in
-                                "buffer" is supposed to be in the range
-                                -1.0 .. 1.0.
-        01.Sep.95     2.2       Added a small constant to all log10() calls
-                                to avoid problems with log(0), first detected
-                                by <gerhard.schroeder@fz13.fz.dbp.de> on a
-				DEC Alpha VMS workstation and extended
-                                to ther platforms as well. Exceptions are
-                                VMS and gcc on PC. <simao@ctd.comsat.com>
+        16.Oct.26     1.0       Created, from the loop of speech_voltmeter().
 ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 */
 #define T        0.03           /* in [s] */
 #define H        0.20           /* in [s] */
 #define M        15.9           /* in [dB] */
-#define THRES_NO 15             /* number of thresholds in the speech voltmeter */
 
 /* Hooked to eliminate sigularity with log(0.0) (happens w/all-0 data blocks */
 #define MIN_LOG_OFFSET 1.0e-20
 
-double speech_voltmeter (float *buffer, long smpno, SVP56_state * state) {
-  int I, j;
+#define SVP56_CHUNK 256         /* envelope values per call of svp56_track() */
+
+void speech_voltmeter_update (float *buffer, long smpno, SVP56_state * state) {
+  int I;
   long k;
-  double g, x, AdB, CdB, AmdB, CmdB, ActiveSpeechLevel;
-  double LongTermLevel, Delta[15];
+  double g, x;
+  double q[SVP56_CHUNK];        /* envelope of the samples of a chunk */
+  long nq = 0;                  /* number of values in q[] */
 
 
   /* Some initializations */
@@ -379,19 +553,64 @@ double speech_voltmeter (float *buffer, long smpno, SVP56_state * state) {
     state->p = g * (state->p) + (1 - g) * ((x > 0) ? x : -x);
     state->q = g * (state->q) + (1 - g) * (state->p);
 
-    /* Applies threshold to the envelope q */
-    for (j = 0; j < THRES_NO; j++) {
-      if ((state->q) >= state->c[j]) {
-        state->a[j]++;
-        state->hang[j] = 0;
-      }
-      if (((state->q) < state->c[j]) && (state->hang[j] < I)) {
-        state->a[j]++;
-        state->hang[j] += 1;
-      }
-      /* if (((state->q)<state->c[j])&&(state->hang[j]=I)), do nothing */
-    }                           /* [j] */
+    /* Applies threshold to the envelope q, by chunks (a NaN, which stays */
+    /* in the envelope once it appears, is never active: not applied) */
+    if (state->q == state->q)
+      q[nq++] = state->q;
+    if (nq == SVP56_CHUNK) {
+      svp56_track (state, q, nq, I);
+      nq = 0;
+    }
   }                             /* [k] */
+  if (nq > 0)
+    svp56_track (state, q, nq, I);
+}
+
+/* ................. End of speech_voltmeter_update() ................... */
+
+
+/*
+~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+        double speech_voltmeter_result (SVP56_state *state);
+        ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+        Description:
+        ~~~~~~~~~~~~
+
+        Computes, from the statistics accumulated in `state' since the
+        last init_speech_voltmeter(), the active speech level, and the
+        long term (rms) level, DC level and activity factor kept in
+        `state' (see the SVP56_get_...() macros). The state is not
+        changed otherwise: more samples may still be given to
+        speech_voltmeter_update().
+
+        Variables:
+        ~~~~~~~~~~
+        Name:         Type:   Use:
+        state          I/O       state of the speech voltmeter
+
+        Value returned:
+        ~~~~~~~~~~~~~~~
+        Returns the active speech level, in dBov, as a double.
+
+        Functions used:
+        ~~~~~~~~~~~~~~~
+        > bin_interp, from this module;
+        > log10, pow, from standard library <math.h>;
+
+        Prototype:   in sv-p56.h
+        ~~~~~~~~~~
+
+        Log of changes:
+        ~~~~~~~~~~~~~~~
+        16.Oct.26     1.0       Created, from the end of speech_voltmeter().
+~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+*/
+double speech_voltmeter_result (SVP56_state * state) {
+  int j;
+  double AdB, CdB, AmdB, CmdB, ActiveSpeechLevel;
+  double LongTermLevel, Delta[SVP56_THRES_NO];
 
   /* Computes the statistics */
   state->DClevel = (state->s) / (state->n);
@@ -412,7 +631,7 @@ double speech_voltmeter (float *buffer, long smpno, SVP56_state * state) {
     return (ActiveSpeechLevel);
 
   /* Proceed serially for steps 2 and up -- this is the most common case */
-  for (j = 1; j < THRES_NO; j++) {
+  for (j = 1; j < SVP56_THRES_NO; j++) {
     if (state->a[j] != 0) {
       AdB = 10 * log10 (((state->sq) / state->a[j]) + MIN_LOG_OFFSET);
       CdB = 20 * log10 (((double) state->c[j]) + MIN_LOG_OFFSET);
@@ -435,9 +654,374 @@ double speech_voltmeter (float *buffer, long smpno, SVP56_state * state) {
   return (ActiveSpeechLevel);
 }
 
+/* ................. End of speech_voltmeter_result() ................... */
+
+
+/*
+~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+        double speech_voltmeter (float *buffer,long smpno,SVP56_state *state);
+        ~~~~~~~~~~~~~~~~~~~~~~~
+
+        Description:
+        ~~~~~~~~~~~~
+
+        Calculates the activity factor and the active speech level
+        (conforming to ITU-T P.56) as main results; side
+        results are:
+        > average level;
+        > max & min values;
+        > rms power [dB];
+        > maximum dB level to normalize without causing clipping
+        > rms and active peak factor for the file
+
+        Follows the ITU-T Recommendation P.56 with the
+        following notation for the variables (the ones marked
+        `DEFINITION' are not true vars, but #define's instead):
+
+          f:          sampling frequency;
+          T:          time constant of smoothing, in seconds (DEFINITION);
+          g:          coefficient of smoothing;
+          H:          hangover in seconds (DEFINITION);
+          I:          size of hangover normalized by the sampling
+                      frequency;
+          M:          margin in dB of the difference between threshold
+                      and active speech level (DEFINITION);
+          q:          envelope;
+          p:          intermediate quantity;
+          c:          vector with thresholds from one quantizing level
+                      up to half the maximum code, at a step of 2;
+          refdB:      reference value to which 0 dB is assigned.
+                      For the STL92, it is the peak of a digital system, which
+                      is defined as 1.0 (0dBov).
+
+        Variables:
+        ~~~~~~~~~~
+        Name:         Type:   Use:
+        buffer          I        input samples vector
+        smpno           I        number of samples in vector `buffer'
+        state          I/O       state variable associated with `buffer'
+
+
+        Value returned:
+        ~~~~~~~~~~~~~~~
+        Returns the active speech level, in dBov, as a double.
+
+        Functions used:
+        ~~~~~~~~~~~~~~~
+        > bin_interp, from this module;
+        > exp, fabs, log10, pow, from standard library <math.h>;
+
+        Prototype:   in sv-p56.h
+        ~~~~~~~~~~
+
+        Author: Simao Ferraz de Campos Neto -- CPqD/Telebras
+        ~~~~~~~          <tdsimao@venus.cpqd.ansp.br>
+
+        Log of changes:
+        ~~~~~~~~~~~~~~~
+        07.Mar.91     0.0       Release of first version of C speech voltmeter.
+        08.Oct.91     1.0       Release of speech_voltmeter as a module.
+        19.Feb.91     2.0       Use of one structure with all state variables,
+                                instead of passing a bunch of variables.
+        18.May.92     2.1       Does not carry out initialization (see init_
+                                speech_voltmeter above); input data in
+                                "buffer" is supposed to be in the range
+                                -1.0 .. 1.0.
+        01.Sep.95     2.2       Added a small constant to all log10() calls
+                                to avoid problems with log(0), first detected
+                                by <gerhard.schroeder@fz13.fz.dbp.de> on a
+				DEC Alpha VMS workstation and extended
+                                to ther platforms as well. Exceptions are
+                                VMS and gcc on PC. <simao@ctd.comsat.com>
+        16.Oct.26     2.4       speech_voltmeter_update() followed by
+                                speech_voltmeter_result(); for a signal
+                                given by blocks, calling the result only
+                                once after the last block is faster.
+~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+*/
+double speech_voltmeter (float *buffer, long smpno, SVP56_state * state) {
+  speech_voltmeter_update (buffer, smpno, state);
+  return (speech_voltmeter_result (state));
+}
+
+/* .................... End of speech_voltmeter() ........................ */
+
+
+/*
+~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+        double speech_voltmeter_parallel (float *buffer, long smpno,
+        ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~  SVP56_state *state, int nthreads);
+
+        Description:
+        ~~~~~~~~~~~~
+
+        Same as speech_voltmeter(), with the samples of `buffer' split
+        in up to nthreads chunks processed by parallel threads (when
+        compiled with SVP56_PTHREADS; otherwise one after the other).
+
+        The envelope p, q of P.56 is a pair of first order recurrences,
+        linear in the initial values. Each chunk is processed twice:
+
+        1) from p = q = 0: the envelope at the end of the chunk,
+           p'(m), q'(m) after m samples (only the last 50 time
+           constants of the chunk contribute to it, up to rounding).
+           The envelope at the end of the chunk from the true
+           initial values p0, q0 is then
+             p(m) = p'(m) + g^m p0
+             q(m) = q'(m) + g^m q0 + m (1-g) g^m p0
+           which gives, chunk after chunk, the initial values of the
+           next one (carry-in);
+
+        2) from its carry-in: sums and extremes of the samples; the
+           envelope is computed again and the thresholds applied as
+           if no hangover were running at the start of the chunk,
+           noting for each threshold the number f[j] of samples
+           before the 1st q >= c[j]. With the true hangover count
+           hang[j] at the start of the chunk, min(I - hang[j], f[j])
+           more samples are active, and the hangover at the end of
+           the chunk only depends on hang[j] if there is no q >= c[j]
+           in the chunk.
+
+        The chunks are then added to `state' in order. The activity
+        counts and extremes are the ones of the serial version, as
+        long as no envelope value falls within a few units of the
+        last place of a threshold; the sums, the carry-in and so the
+        levels may differ from the serial version by rounding errors
+        (relative 1e-15 or so).
+
+        Variables:
+        ~~~~~~~~~~
+        Name:         Type:   Use:
+        buffer          I        input samples vector, range -1.0 .. 1.0
+        smpno           I        number of samples in vector `buffer'
+        state          I/O       state variable associated with `buffer'
+        nthreads        I        max. number of threads, 0 for the number
+                                 of processors
+
+        Value returned:
+        ~~~~~~~~~~~~~~~
+        Returns the active speech level, in dBov, as a double.
+
+        Prototype:   in sv-p56.h
+        ~~~~~~~~~~
+
+        Log of changes:
+        ~~~~~~~~~~~~~~~
+        16.Oct.26     1.0       Created.
+~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+*/
+#define SVP56_MAXTHREADS 64     /* max. number of threads */
+#define SVP56_MINCHUNK 16384    /* min. number of samples of a chunk */
+#define SVP56_MEMORY 50         /* envelope memory, in time constants (g^w = exp(-50)) */
+
+/* A chunk of the samples, processed by one thread */
+typedef struct {
+  float *x;                     /* samples of the chunk */
+  long n;                       /* number of samples */
+  double g;                     /* coefficient of smoothing */
+  long I;                       /* hangover, in samples */
+  long w;                       /* samples of the envelope memory, at the end of the chunk (pass 1) */
+  double p, q;                  /* envelope at the end of the chunk from 0 (pass 1); carry-in, then end (pass 2) */
+  double s, sq, max, maxP, maxN;        /* sums and extremes of the samples (pass 2) */
+  SVP56_state st;               /* thresholds, and counts from no hangover at the start (pass 2) */
+  long f[SVP56_LANES];          /* samples before the 1st q >= c[j] */
+  double qmax;                  /* max. of the envelope */
+  long nq;                      /* number of envelope values applied (not NaN) */
+} SVP56_RANGE;
+
+
+/* Pass 1: envelope from 0; only the last w samples contribute to it (up to rounding), */
+/* unless a sample is not finite (NaN or infinite envelope from there on) */
+static void *svp56_range_envelope (void *arg) {
+  SVP56_RANGE *r = (SVP56_RANGE *) arg;
+  double g = r->g, x, p = 0, q = 0;
+  long k, start;
+
+  for (k = 0; k < r->n && fabs (r->x[k]) <= FLT_MAX; k++);
+  start = (k == r->n && r->n > r->w) ? r->n - r->w : 0;
+
+  for (k = start; k < r->n; k++) {
+    x = (double) r->x[k];
+    p = g * p + (1 - g) * ((x > 0) ? x : -x);
+    q = g * q + (1 - g) * p;
+  }
+  r->p = p;
+  r->q = q;
+  return NULL;
+}
+
+
+/* Pass 2: sums and extremes, envelope from the carry-in, thresholds from no hangover */
+static void *svp56_range_track (void *arg) {
+  SVP56_RANGE *r = (SVP56_RANGE *) arg;
+  double g = r->g, x, p = r->p, q = r->q;
+  double qb[SVP56_CHUNK];
+  long k, nb = 0;
+  int j, jf = 0;
+
+  for (j = 0; j < SVP56_LANES; j++) {
+    r->st.a[j] = 0;
+    r->st.hang[j] = r->I;
+    r->f[j] = -1;
+  }
+  r->qmax = -1.0;
+  r->nq = 0;
+  r->s = r->sq = r->max = 0;
+  r->maxP = -HUGE_VAL;
+  r->maxN = HUGE_VAL;
+
+  for (k = 0; k < r->n; k++) {
+    x = (double) r->x[k];
+    if (fabs (x) > r->max)
+      r->max = fabs (x);
+    if (x > r->maxP)
+      r->maxP = x;
+    if (x < r->maxN)
+      r->maxN = x;
+    r->sq += x * x;
+    r->s += x;
+    p = g * p + (1 - g) * ((x > 0) ? x : -x);
+    q = g * q + (1 - g) * p;
+    if (q == q) {
+      /* 1st q above each threshold (thresholds in increasing order) */
+      if (q > r->qmax) {
+        r->qmax = q;
+        for (; jf < SVP56_LANES && q >= r->st.c[jf]; jf++)
+          r->f[jf] = r->nq;
+      }
+      qb[nb++] = q;
+      r->nq++;
+    }
+    if (nb == SVP56_CHUNK) {
+      svp56_track (&r->st, qb, nb, r->I);
+      nb = 0;
+    }
+  }
+  if (nb > 0)
+    svp56_track (&r->st, qb, nb, r->I);
+
+  for (j = 0; j < SVP56_LANES; j++)
+    if (r->f[j] < 0)
+      r->f[j] = r->nq;
+  r->p = p;
+  r->q = q;
+  return NULL;
+}
+
+
+/* Run pass 1 or 2 on the nr chunks; the calling thread processes the 1st one */
+static void svp56_run (void *(*pass) (void *), SVP56_RANGE * r, int nr) {
+  int t;
+#ifdef SVP56_PTHREADS
+  pthread_t tid[SVP56_MAXTHREADS];
+  char started[SVP56_MAXTHREADS];
+
+  for (t = 1; t < nr; t++)
+    started[t] = pthread_create (&tid[t], NULL, pass, &r[t]) == 0;
+  pass (&r[0]);
+  for (t = 1; t < nr; t++)
+    if (started[t])
+      pthread_join (tid[t], NULL);
+    else
+      pass (&r[t]);
+#else
+  for (t = 0; t < nr; t++)
+    pass (&r[t]);
+#endif
+}
+
+
+double speech_voltmeter_parallel (float *buffer, long smpno, SVP56_state * state, int nthreads) {
+  SVP56_RANGE *r;
+  double g, gm, pl, ql, p0, q0;
+  unsigned long extra;
+  long I, first;
+  int nr, t, j;
+
+#ifdef SVP56_PTHREADS
+  if (nthreads <= 0)
+    nthreads = (int) sysconf (_SC_NPROCESSORS_ONLN);
+#endif
+  if (nthreads > SVP56_MAXTHREADS)
+    nthreads = SVP56_MAXTHREADS;
+  nr = (smpno / SVP56_MINCHUNK < nthreads) ? (int) (smpno / SVP56_MINCHUNK) : nthreads;
+
+  /* Short buffers, or out of memory: serial version */
+  if (nr < 2 || (r = (SVP56_RANGE *) malloc (nr * sizeof (SVP56_RANGE))) == NULL)
+    return (speech_voltmeter (buffer, smpno, state));
+
+  I = floor (H * state->f + 0.5);
+  g = exp (-1.0 / (state->f * T));
+#ifdef SVP56_AVX
+  svp56_select ();              /* before the threads */
+#endif
+
+  /* Chunks */
+  for (t = 0; t < nr; t++) {
+    first = smpno * t / nr;
+    r[t].x = buffer + first;
+    r[t].n = smpno * (t + 1) / nr - first;
+    r[t].g = g;
+    r[t].I = I;
+    r[t].w = (long) (SVP56_MEMORY * state->f * T) + 1;
+    for (j = 0; j < SVP56_LANES; j++)
+      r[t].st.c[j] = state->c[j];
+  }
+
+  /* Pass 1, and carry-in of each chunk */
+  svp56_run (svp56_range_envelope, r, nr);
+  for (t = 0, p0 = state->p, q0 = state->q; t < nr; t++) {
+    pl = r[t].p;
+    ql = r[t].q;
+    r[t].p = p0;
+    r[t].q = q0;
+    gm = pow (g, (double) r[t].n);
+    p0 = pl + gm * r[t].p;
+    q0 = ql + gm * r[t].q + r[t].n * (1 - g) * gm * r[t].p;
+  }
+
+  /* Pass 2, and the chunks added to the state in order */
+  svp56_run (svp56_range_track, r, nr);
+  for (t = 0; t < nr; t++) {
+    state->s += r[t].s;
+    state->sq += r[t].sq;
+    state->n += r[t].n;
+    if (r[t].max > state->max)
+      state->max = r[t].max;
+    if (r[t].maxP > state->maxP)
+      state->maxP = r[t].maxP;
+    if (r[t].maxN < state->maxN)
+      state->maxN = r[t].maxN;
+
+    for (j = 0; j < SVP56_LANES; j++) {
+      /* Samples before the 1st q >= c[j] active by the hangover running at the start of the chunk */
+      extra = (unsigned long) I - state->hang[j];
+      if ((unsigned long) r[t].f[j] < extra)
+        extra = (unsigned long) r[t].f[j];
+      state->a[j] += r[t].st.a[j] + extra;
+      if (r[t].qmax >= state->c[j])
+        state->hang[j] = r[t].st.hang[j];
+      else if (state->hang[j] + r[t].nq < (unsigned long) I)
+        state->hang[j] += r[t].nq;
+      else
+        state->hang[j] = I;
+    }
+  }
+  state->p = r[nr - 1].p;
+  state->q = r[nr - 1].q;
+
+  free (r);
+  return (speech_voltmeter_result (state));
+}
+
+#undef SVP56_MEMORY
+#undef SVP56_MINCHUNK
+#undef SVP56_MAXTHREADS
+#undef SVP56_CHUNK
 #undef MIN_LOG_OFFSET
 #undef M
 #undef H
 #undef T
-#undef THRES_NO
-/* .................... End of speech_voltmeter() ........................ */
+/* ................ End of speech_voltmeter_parallel() .................... */
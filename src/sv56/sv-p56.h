@@ -1,6 +1,6 @@
 /*
   ============================================================================
-   File: SV-P56.H                                             01.SEP.1995 v2.2
+   File: SV-P56.H                                             16.OCT.2026 v2.4
   ============================================================================
 
                       UGST/ITU-T SPEECH VOLTMETER MODULE
@@ -23,11 +23,16 @@
                         <tdsimao@venus.cpqd.ansp.br>
    01.Sep.95    v2.2    Updated version number to match sv-p56.c and added 
                         smart prototypes <simao@ctd.comsat.com>
+   16.Oct.2026  v2.4    Thresholds and counters padded to SVP56_LANES
+                        lanes, for the vector threshold tracking
+                        Prototypes of speech_voltmeter_update() and
+                        speech_voltmeter_result(), and of
+                        speech_voltmeter_parallel()
 
   ============================================================================
 */
 #ifndef SPEECH_VOLTMETER_defined
-#define SPEECH_VOLTMETER_defined 220
+#define SPEECH_VOLTMETER_defined 240
 
 /* DEFINITION FOR SMART PROTOTYPES */
 #ifndef ARGS
@@ -38,12 +43,17 @@
 #endif
 #endif
 
+/* Number of thresholds, and of lanes of the threshold arrays (multiple of
+   the vector length; the lanes after the last threshold are not used) */
+#define SVP56_THRES_NO 15
+#define SVP56_LANES 16
+
 /* State for speech voltmeter function */
 typedef struct {
   float f;                      /* sampling frequency, in Hz */
-  unsigned long a[15];          /* activity count */
-  double c[15];                 /* threshold level; 15 is the no.of thres. */
-  unsigned long hang[15];       /* hangover count */
+  unsigned long a[SVP56_LANES]; /* activity count of each threshold */
+  double c[SVP56_LANES];        /* threshold levels: SVP56_THRES_NO of them, then padding (lane 15) */
+  unsigned long hang[SVP56_LANES];      /* hangover count of each threshold */
   unsigned long n;              /* number of samples read since last reset */
   double s;                     /* sum of all samples since last reset */
   double sq;                    /* squared sum of samples since last reset */
@@ -61,6 +71,9 @@ typedef struct {
 double bin_interp ARGS ((double upcount, double lwcount, double upthr, double lwthr, double Margin, double tol));
 void init_speech_voltmeter ARGS ((SVP56_state * state, double sampl_freq));
 double speech_voltmeter ARGS ((float *buffer, long smpno, SVP56_state * state));
+void speech_voltmeter_update ARGS ((float *buffer, long smpno, SVP56_state * state));
+double speech_voltmeter_result ARGS ((SVP56_state * state));
+double speech_voltmeter_parallel ARGS ((float *buffer, long smpno, SVP56_state * state, int nthreads));
 
 
 /* Definitions for getting statistics from a `SVP56_state' variable */
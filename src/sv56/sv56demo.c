@@ -1,4 +1,4 @@
-/*                                                              v3.5 02.Feb.10
+/*                                                              v3.7 16.Oct.26
   ============================================================================
 
   SV56DEMO.C
@@ -81,13 +81,20 @@
   -end eb ........ define `eb' as the last block to be measured
   -n nb .......... define `nb' as the number of blocks to be measured;
                    equivalent to parameter N2 above [default: whole file]
+  -mem mb ........ keep up to `mb' MBytes of input samples in memory for
+                   the equalization; the samples beyond are copied to a
+                   temporary file during the measurement, so that the
+                   input file is read only once (or read again if the
+                   temporary file can't be created)
+                   [default: 64 MBytes; 0 copies all the samples]
 
   Modules used:
   ~~~~~~~~~~~~~
   > sv-P56.c: contains the functions related to active speech
               level measurement according to P.56,
-              init_speech_voltmeter(), speech_voltmeter() and
-              bin_interp(). Their prototypesare in `sv-p56.h'.
+              init_speech_voltmeter(), speech_voltmeter_update(),
+              speech_voltmeter_result() and bin_interp(). Their
+              prototypes are in `sv-p56.h'.
   > ugst-utl.c: utility functions; here are used the gain/loss
               (scaling) algorithm of scale() and the data type
               conversion functions sh2fl() and fl2sh(). Prototypes
@@ -102,6 +109,7 @@
   4      error moving pointer to desired start of conversion;
   5      error reading input file;
   6      error writing to file;
+  7      error allocating memory;
 
   Compilation:
   ~~~~~~~~~~~~
@@ -155,6 +163,17 @@
                            a multiple of the block size <simao>.
   02.Feb.10     3.5        Modified maximum string length to avoid
                            buffer overruns (y.hiwasaki)
+  16.Oct.26     3.6        The blocks only accumulate the statistics
+                           (speech_voltmeter_update()); the levels are
+                           computed once, after the last block
+                           (speech_voltmeter_result()).
+  16.Oct.26     3.7        The input samples are kept in memory (up to
+                           -mem MBytes) during the measurement, and
+                           equalized from there instead of being read
+                           again from the file; the samples beyond are
+                           copied to a temporary file. The output is
+                           written by buffers of OUT_LEN samples instead
+                           of one fwrite() per block.
 
   ============================================================================
 */
@@ -188,6 +207,8 @@
 
 /* Local definitions */
 #define MIN_LOG_OFFSET 1.0e-20  /* To avoid sigularity with log(0.0) */
+#define DEF_MEM_MB 64           /* MBytes of input samples kept in memory */
+#define OUT_LEN 65536           /* samples per write to the output file */
 
 /*
  -------------------------------------------------------------------------
@@ -202,7 +223,7 @@
  -------------------------------------------------------------------------
 */
 void display_usage () {
-  printf ("SV56DEMO.C: Version 3.5 of 02.Feb.2010 \n\n");
+  printf ("SV56DEMO.C: Version 3.7 of 16.Oct.2026 \n\n");
   printf ("  Program to level-equalize a speech file \"NdB\" dBs below\n");
   printf ("  the overload point for a linear n-bit (default: 16 bit) system.\n");
   printf ("  using the P.56 speech voltmeter algorithm.\n");
@@ -239,6 +260,10 @@ void display_usage () {
   printf ("  -end eb ..... define `eb' as the last block to be measured\n");
   printf ("  -n nb ....... define `nb' as the number of blocks to be measured;\n");
   printf ("                equiv. to param.NoOfBlocks above [dft: whole file]\n");
+  printf ("  -mem mb ..... keep up to `mb' MBytes of input in memory for the\n");
+  printf ("                equalization; the samples beyond are copied to a\n");
+  printf ("                temporary file, so that the input is read only once\n");
+  printf ("                [default: 64 MBytes]\n");
   printf ("  -log file ... log statistics into file rather than stdout\n");
   printf ("  -q .......... quiet operation - does not print the progress flag.\n");
   printf ("                Saves time and avoids trash in batch processings.\n");
@@ -411,6 +436,80 @@ void print_p56_short_summary (FILE * out, char *file, SVP56_state state, double
 /* ................... End of print_p56_short_summary() .................... */
 
 
+/*
+  ============================================================================
+
+       static long equalize_write (short *x, long n, double factor,
+       ~~~~~~~~~~~~~~~~~~~~~~~~~~  long bitno, short mask, short *obuf,
+                                   long *ofill, FILE *Fo, char *FileOut);
+
+       Equalize n samples and append them to the output buffer, which is
+       written to the output file each time it is full (OUT_LEN samples).
+       Called with n = 0, writes the samples left in the buffer.
+
+       Parameter:
+       ~~~~~~~~~~
+       x ........ input samples
+       n ........ number of samples
+       factor ... equalization gain
+       bitno .... number of bits per sample
+       mask ..... mask of the valid bits, for fl2sh()
+       obuf ..... output buffer of OUT_LEN samples
+       ofill .... number of samples in the output buffer
+       Fo ....... output file
+       FileOut .. output file name, for error messages
+
+       Returns
+       ~~~~~~~
+       Number of clipped samples
+
+       Log of changes
+       ~~~~~~~~~~~~~~
+       16.Oct.26	v1.0	Creation.
+
+  ============================================================================
+*/
+static long equalize_write (short *x, long n, double factor, long bitno, short mask, short *obuf, long *ofill, FILE * Fo, char *FileOut) {
+  float Buf[4096];
+  long j, m, NrSat = 0;
+
+  for (j = 0; j < n; j += m) {
+    /* Up to the end of the output buffer, by 4096 samples at most */
+    m = (n - j < OUT_LEN - *ofill) ? n - j : OUT_LEN - *ofill;
+    if (m > 4096)
+      m = 4096;
+
+    /* convert samples to float */
+    sh2fl (m, x + j, Buf, bitno, 1);
+
+    /* equalizes vector */
+    scale (Buf, m, factor);
+
+    /* Convert from float to short with hard clip and truncation */
+    NrSat += fl2sh (m, Buf, obuf + *ofill, (double) 0.0, mask);
+    *ofill += m;
+
+    /* write equalized, de-normalized and hard-clipped samples to file */
+    if (*ofill == OUT_LEN) {
+      if ((long) fwrite (obuf, sizeof (short), OUT_LEN, Fo) != OUT_LEN)
+        KILL (FileOut, 6);
+      *ofill = 0;
+    }
+  }
+
+  /* Samples left at the end */
+  if (n == 0 && *ofill > 0) {
+    if ((long) fwrite (obuf, sizeof (short), *ofill, Fo) != *ofill)
+      KILL (FileOut, 6);
+    *ofill = 0;
+  }
+
+  return NrSat;
+}
+
+/* ..................... End of equalize_write() ......................... */
+
+
 /*
    **************************************************************************
    ***                                                                    ***
@@ -433,6 +532,7 @@ int main (int argc, char *argv[]) {
   /* File-related variables */
   char FileIn[MAX_STRLEN], FileOut[MAX_STRLEN];
   FILE *Fi, *Fo;                /* input/output file pointers */
+  FILE *Ft = NULL;              /* temporary file of the samples not kept */
   FILE *out = stdout;           /* where to print the statistical results */
 #ifdef VMS
   char mrs[15];
@@ -442,6 +542,10 @@ int main (int argc, char *argv[]) {
   char quiet = 0, use_active_level = 1, long_summary = 1;
   short buffer[4096];
   float Buf[4096];
+  short *keep = NULL;           /* input samples kept for the equalization */
+  short *obuf;                  /* output buffer of OUT_LEN samples */
+  long nkeep = 0, K, ofill = 0;
+  double mem = DEF_MEM_MB;      /* MBytes */
   long NrSat = 0, start_byte, bitno = 16;
   double sf = 16000, factor;
   double ActiveLeveldB, DesiredSpeechLeveldB;
@@ -509,6 +613,13 @@ int main (int argc, char *argv[]) {
         /* Change default number of blocks */
         N2 = atol (argv[2]);
 
+        /* Update argc/argv to next valid option/argument */
+        argv += 2;
+        argc -= 2;
+      } else if (strcmp (argv[1], "-mem") == 0) {
+        /* Change the memory for the input samples */
+        mem = atof (argv[2]);
+
         /* Update argc/argv to next valid option/argument */
         argv += 2;
         argc -= 2;
@@ -577,6 +688,23 @@ int main (int argc, char *argv[]) {
   /* reset variables for speech level measurements */
   init_speech_voltmeter (&state, sf);
 
+  /* The 1st K blocks are kept in memory; if they can't be allocated, all
+   * the blocks go to the temporary file, as with -mem 0 */
+  K = (mem > 0) ? (long) (mem * 1048576.0 / (N * sizeof (short))) : 0;
+  if (K > N2)
+    K = N2;
+  if (K > 0 && (keep = (short *) malloc (K * N * sizeof (short))) == NULL)
+    K = 0;
+  if ((obuf = (short *) malloc (OUT_LEN * sizeof (short))) == NULL) {
+    fprintf (stderr, "Can't allocate memory for the output buffer\n");
+    exit (7);
+  }
+
+  /* The other blocks are copied to a temporary file during the measurement;
+   * if it can't be created, they are read again from the input file */
+  if (K < N2 && (Ft = tmpfile ()) == NULL)
+    fprintf (stderr, "Can't create a temporary file; the input is read twice\n");
+
 
 /*
  * ......... FILE PREPARATION .........
@@ -606,13 +734,20 @@ int main (int argc, char *argv[]) {
 
   /* Process selected blocks */
   for (i = 0; i < N2; i++) {
-    /* Read samples ... */
-    if ((l = fread (buffer, sizeof (short), N, Fi)) > 0) {
+    /* Read samples, after the ones already kept if to be kept ... */
+    short *x = (i < K) ? keep + nkeep : buffer;
+
+    if ((l = fread (x, sizeof (short), N, Fi)) > 0) {
+      if (i < K)
+        nkeep += l;
+      else if (Ft != NULL && (long) fwrite (x, sizeof (short), l, Ft) != l)
+        KILL ("temporary file", 6);
+
       /* ... Convert samples to float */
-      sh2fl ((long) l, buffer, Buf, bitno, 1);
+      sh2fl ((long) l, x, Buf, bitno, 1);
 
-      /* ... Get the active level */
-      ActiveLeveldB = speech_voltmeter (Buf, (long) l, &state);
+      /* ... Accumulate the statistics of the active level */
+      speech_voltmeter_update (Buf, (long) l, &state);
 
       /* Print some preliminary information */
       if (!quiet)
@@ -626,6 +761,9 @@ int main (int argc, char *argv[]) {
   if (!quiet)
     printf ("\n");
 
+  /* ... Get the active level of all the blocks */
+  ActiveLeveldB = speech_voltmeter_result (&state);
+
 
   /* ... COMPUTE EQUALIZATION FACTOR ... */
 
@@ -644,30 +782,26 @@ int main (int argc, char *argv[]) {
 
   /* EQUALIZATION: hard clipping (with truncation) */
 
-  /* Move pointer to 1st desired block */
-  if (fseek (Fi, start_byte, 0) < 0l)
-    KILL (FileIn, 4);
-
-  /* Get data of interest, equalize and de-normalize */
-  for (i = 0; i < N2; i++) {
-    if ((l = fread (buffer, sizeof (short), N, Fi)) > 0) {
-      /* convert samples to float */
-      sh2fl ((long) l, buffer, Buf, bitno, 1);
+  /* Equalize and de-normalize the samples kept in memory */
+  NrSat += equalize_write (keep, nkeep, factor, bitno, mask[16 - bitno], obuf, &ofill, Fo, FileOut);
 
-      /* equalizes vector */
-      scale (Buf, (long) l, (double) factor);
-
-      /* Convert from float to short with hard clip and truncation */
-      NrSat += fl2sh ((long) l, Buf, buffer, (double) 0.0, mask[16 - bitno]);
-
-      /* write equalized, de-normalized and hard-clipped samples to file */
-      if ((l = fwrite (buffer, sizeof (short), l, Fo)) < 0)
-        KILL (FileOut, 6);
+  /* Get the rest of the data from the temporary file or, without it,
+   * from the 1st block not kept in the input file */
+  if (Ft != NULL)
+    rewind (Ft);
+  else if (K < N2 && fseek (Fi, start_byte + K * N * (long) sizeof (short), 0) < 0l)
+    KILL (FileIn, 4);
+  for (i = K; i < N2; i++) {
+    if ((l = fread (buffer, sizeof (short), N, (Ft != NULL) ? Ft : Fi)) > 0) {
+      NrSat += equalize_write (buffer, l, factor, bitno, mask[16 - bitno], obuf, &ofill, Fo, FileOut);
     } else {
-      KILL (FileIn, 5);
+      KILL ((Ft != NULL) ? "temporary file" : FileIn, 5);
     }
   }
 
+  /* Write the last samples */
+  equalize_write (NULL, 0, factor, bitno, mask[16 - bitno], obuf, &ofill, Fo, FileOut);
+
   /* Log number of clipped samples */
   if (NrSat != 0)
     fprintf (out, "\n  Number of clippings: .......... %7ld []\n", NrSat);
@@ -682,8 +816,12 @@ int main (int argc, char *argv[]) {
   /* Close files ... */
   fclose (Fi);
   fclose (Fo);
+  if (Ft != NULL)
+    fclose (Ft);
   if (out != stdout)
     fclose (out);
+  free (keep);
+  free (obuf);
 #if !defined(VMS)
   return (0);
 #endif